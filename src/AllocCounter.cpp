@@ -0,0 +1,95 @@
+#include "AllocCounter.h"
+
+#ifdef S2S_ALLOC_COUNTER
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+thread_local quint64 t_allocations = 0;
+std::atomic<quint64> s_allocations{ 0 };
+
+void *countedAlloc(std::size_t size)
+{
+    ++t_allocations;
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void *countedAlignedAlloc(std::size_t size, std::align_val_t alignment)
+{
+    ++t_allocations;
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    const std::size_t align = std::max(std::size_t(alignment), sizeof(void *));
+    void *ptr = nullptr;
+#ifdef _WIN32
+    ptr = _aligned_malloc(size ? size : 1, align);
+#else
+    if (posix_memalign(&ptr, align, size ? size : 1) != 0) ptr = nullptr;
+#endif
+    return ptr;
+}
+
+void countedAlignedFree(void *ptr)
+{
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+} // namespace
+
+void *operator new(std::size_t size)
+{
+    if (void *ptr = countedAlloc(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    if (void *ptr = countedAlloc(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept { return countedAlloc(size); }
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept { return countedAlloc(size); }
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    if (void *ptr = countedAlignedAlloc(size, alignment)) return ptr;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment)
+{
+    if (void *ptr = countedAlignedAlloc(size, alignment)) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, const std::nothrow_t &) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::align_val_t) noexcept { countedAlignedFree(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept { countedAlignedFree(ptr); }
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept { countedAlignedFree(ptr); }
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept { countedAlignedFree(ptr); }
+
+bool AllocCounter::isEnabled() { return true; }
+quint64 AllocCounter::threadCount() { return t_allocations; }
+quint64 AllocCounter::totalCount() { return s_allocations.load(std::memory_order_relaxed); }
+
+#else
+
+bool AllocCounter::isEnabled() { return false; }
+quint64 AllocCounter::threadCount() { return 0; }
+quint64 AllocCounter::totalCount() { return 0; }
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef ALLOCCOUNTER_H
+#define ALLOCCOUNTER_H
+
+#include <QtGlobal>
+
+// 디버그용 힙 할당 카운터
+// S2S_ALLOC_COUNTER로 빌드하면 (Debug 빌드는 기본) 전역 operator new/delete를 바꿔 끼워
+// 스레드별/전체 할당 횟수를 셉니다. 프레임 앞뒤의 값 차이 = 그 프레임의 할당 수.
+// malloc을 직접 부르는 C 라이브러리/GL 드라이버 내부 할당은 세지 않습니다.
+// 빌드에 없으면 isEnabled()가 false이고 나머지는 0을 반환합니다.
+namespace AllocCounter
+{
+    bool isEnabled();
+    quint64 threadCount(); // 이 스레드의 누적 할당 수
+    quint64 totalCount();  // 모든 스레드
+}
+
+#endif // ALLOCCOUNTER_H
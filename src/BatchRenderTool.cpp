@@ -0,0 +1,44 @@
+// 헤드리스 배치 렌더러 (썸네일/턴테이블 미리보기)
+//
+//   Switch2BatchRender jobs.json [--cache-mb 2048] [--alpha-cutoff 0.05]
+//
+// 작업 목록 형식은 BatchRenderer.h 참고. 창이 없어도 되도록 -platform offscreen으로 실행할 수 있습니다.
+#include <QGuiApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include "BatchRenderer.h"
+
+int main(int argc, char *argv[])
+{
+    QGuiApplication app(argc, argv);
+    QGuiApplication::setApplicationName("Switch2BatchRender");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Render thumbnails/turntables for a list of splat scenes without the GUI");
+    parser.addHelpOption();
+    parser.addPositionalArgument("jobs", "Job list (JSON)");
+    QCommandLineOption cacheOption("cache-mb", "Decoded scene cache budget (CPU + GPU, MB)", "mb", "2048");
+    QCommandLineOption cutoffOption("alpha-cutoff", "Alpha cutoff", "value", "0.05");
+    parser.addOption(cacheOption);
+    parser.addOption(cutoffOption);
+    parser.process(app);
+
+    const QStringList args = parser.positionalArguments();
+    if (args.size() != 1) parser.showHelp(1);
+
+    std::vector<BatchJob> jobs;
+    if (!BatchRenderer::loadJobs(args[0], jobs)) return 1;
+    if (jobs.empty()) {
+        qWarning() << "No jobs in" << args[0];
+        return 0;
+    }
+
+    BatchRenderer renderer;
+    renderer.setCacheBudget(parser.value(cacheOption).toLongLong() * 1024 * 1024);
+    renderer.setAlphaCutoff(parser.value(cutoffOption).toFloat());
+    if (!renderer.initialize()) return 1;
+
+    const BatchStats stats = renderer.run(jobs);
+    qInfo().noquote() << stats.toString();
+    return stats.failedJobs > 0 ? 2 : 0;
+}
@@ -0,0 +1,465 @@
+#include "BatchRenderer.h"
+#include "SplatFileLoader.h"
+#include "SplatShaders.h"
+#include "CameraPath.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QElapsedTimer>
+#include <QtMath>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <future>
+
+QString BatchStats::toString() const
+{
+    const double perJob = jobs > 0 ? 1.0 / jobs : 0.0;
+    return QString("%1 jobs (%2 failed), %3 images in %4 s = %5 jobs/s, %6 images/s\n"
+                   "  scene cache: %7 hits, %8 misses\n"
+                   "  per job: decode wait %9 ms, upload %10 ms, render %11 ms, save %12 ms")
+        .arg(jobs)
+        .arg(failedJobs)
+        .arg(images)
+        .arg(seconds, 0, 'f', 2)
+        .arg(jobsPerSecond(), 0, 'f', 2)
+        .arg(seconds > 0.0 ? images / seconds : 0.0, 0, 'f', 2)
+        .arg(cacheHits)
+        .arg(cacheMisses)
+        .arg(decodeWaitMs * perJob, 0, 'f', 1)
+        .arg(uploadMs * perJob, 0, 'f', 1)
+        .arg(renderMs * perJob, 0, 'f', 1)
+        .arg(saveMs * perJob, 0, 'f', 1);
+}
+
+BatchRenderer::BatchRenderer()
+    : m_orderVbo(QOpenGLBuffer::VertexBuffer)
+{
+}
+
+BatchRenderer::~BatchRenderer()
+{
+    if (!m_initialized) return;
+
+    m_context.makeCurrent(&m_surface);
+    for (CachedScene &entry : m_cache) releaseCached(entry);
+    delete m_fbo;
+    m_shaderCache.clear();
+    m_orderVbo.destroy();
+    m_quadVbo.destroy();
+    m_vao.destroy();
+    m_context.doneCurrent();
+}
+
+bool BatchRenderer::loadJobs(const QString &filePath, std::vector<BatchJob> &outJobs)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCritical() << "Cannot open job list:" << filePath;
+        return false;
+    }
+
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+    if (error.error != QJsonParseError::NoError) {
+        qCritical() << "Invalid job list:" << error.errorString();
+        return false;
+    }
+
+    // 상대 경로는 작업 목록 파일 기준
+    const QDir baseDir = QFileInfo(filePath).absoluteDir();
+    const QJsonArray jobs = doc.isArray() ? doc.array() : doc.object().value("jobs").toArray();
+
+    outJobs.clear();
+    for (const QJsonValue &value : jobs) {
+        const QJsonObject obj = value.toObject();
+        BatchJob job;
+        job.scenePath = baseDir.absoluteFilePath(obj.value("scene").toString());
+        job.output = baseDir.absoluteFilePath(obj.value("output").toString());
+        job.width = obj.value("width").toInt(job.width);
+        job.height = obj.value("height").toInt(job.height);
+
+        for (const QJsonValue &poseValue : obj.value("poses").toArray()) {
+            const QJsonObject p = poseValue.toObject();
+            BatchPose pose;
+            pose.state.yaw = float(p.value("yaw").toDouble(0.0));
+            pose.state.pitch = float(p.value("pitch").toDouble(0.0));
+            const QJsonArray target = p.value("target").toArray();
+            pose.autoFrame = target.size() != 3 || !p.contains("distance");
+            if (!pose.autoFrame) {
+                pose.state.target = QVector3D(float(target[0].toDouble()), float(target[1].toDouble()),
+                                              float(target[2].toDouble()));
+                pose.state.distance = float(p.value("distance").toDouble());
+            }
+            job.poses.push_back(pose);
+        }
+
+        // 기록된 카메라 경로: 뷰어의 재생과 같은 고정 스텝으로 샘플링한 시점마다 한 장
+        const QString pathFile = obj.value("cameraPath").toString();
+        if (!pathFile.isEmpty()) {
+            CameraPath path;
+            if (!path.load(baseDir.absoluteFilePath(pathFile)) || path.isEmpty()) {
+                qWarning() << "Skipping job" << outJobs.size() << "- cannot load camera path" << pathFile;
+                continue;
+            }
+            CameraPathPlayer player;
+            player.start(path, obj.value("pathStepMs").toInt(16));
+            BatchPose pose;
+            while (player.nextFrame(pose.state)) job.poses.push_back(pose);
+        }
+
+        const int turntable = obj.value("turntable").toInt(0);
+        for (int i = 0; i < turntable; ++i) {
+            BatchPose pose;
+            pose.autoFrame = true;
+            pose.state.yaw = 360.0f * i / turntable;
+            pose.state.pitch = float(obj.value("pitch").toDouble(-15.0));
+            job.poses.push_back(pose);
+        }
+
+        if (job.poses.empty()) {
+            BatchPose pose;
+            pose.autoFrame = true;
+            pose.state.pitch = float(obj.value("pitch").toDouble(-15.0));
+            job.poses.push_back(pose);
+        }
+
+        if (obj.value("scene").toString().isEmpty() || obj.value("output").toString().isEmpty()
+            || job.width <= 0 || job.height <= 0) {
+            qWarning() << "Skipping job" << outJobs.size() << "- scene/output/size missing or invalid";
+            continue;
+        }
+        if (job.poses.size() > 1 && !job.output.contains("%1")) {
+            qWarning() << "Job" << job.scenePath << "has several poses but no %1 in output; adding _%1";
+            QFileInfo info(job.output);
+            job.output = info.dir().filePath(info.completeBaseName() + "_%1." + info.suffix());
+        }
+        outJobs.push_back(job);
+    }
+    return true;
+}
+
+bool BatchRenderer::initialize()
+{
+    if (m_initialized) return true;
+
+    QSurfaceFormat format;
+    format.setVersion(3, 3);
+    format.setProfile(QSurfaceFormat::CoreProfile);
+    m_context.setFormat(format);
+    if (!m_context.create()) {
+        qCritical() << "Failed to create OpenGL 3.3 context";
+        return false;
+    }
+    m_surface.setFormat(m_context.format());
+    m_surface.create();
+    if (!m_context.makeCurrent(&m_surface)) {
+        qCritical() << "Failed to make offscreen context current";
+        return false;
+    }
+    initializeOpenGLFunctions();
+
+    // 작업마다 씬이 바뀌므로 SH/컷오프 기능을 모두 켠 변형 하나만 씀
+    m_shaderCache.initialize(ShaderCache::defaultCacheDir());
+    m_program = m_shaderCache.program(SplatShaders::splatVertexSource(), SplatShaders::splatFragmentSource(),
+                                      SplatShaders::featureDefines(SplatShaders::Feature_Sh
+                                                                   | SplatShaders::Feature_AlphaCutoff));
+    if (!m_program) return false;
+    m_program->bind();
+    m_program->setUniformValue("uScene0", 0);
+    m_program->setUniformValue("uShCodebook", 1);
+    m_program->release();
+
+    // 뷰어와 같은 인스턴싱 구성: [Layout 0] 사각형 정점, [Layout 1] 인스턴스마다 SplatRef
+    m_vao.create();
+    m_vao.bind();
+
+    const float quadVertices[] = { -1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f };
+    m_quadVbo.create();
+    m_quadVbo.bind();
+    m_quadVbo.allocate(quadVertices, sizeof(quadVertices));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), nullptr);
+
+    m_orderVbo.create();
+    m_orderVbo.setUsagePattern(QOpenGLBuffer::DynamicDraw);
+    m_orderVbo.bind();
+    glEnableVertexAttribArray(1);
+    glVertexAttribIPointer(1, 1, GL_UNSIGNED_INT, sizeof(quint32), nullptr);
+    glVertexAttribDivisor(1, 1);
+
+    m_vao.release();
+    m_orderVbo.release();
+
+    m_initialized = true;
+    return true;
+}
+
+BatchRenderer::DecodedScene BatchRenderer::decode(const QString &path, float alphaCutoff)
+{
+    DecodedScene decoded;
+
+    SplatFileLoader loader;
+    std::vector<RenderSplat> splats;
+    ShPalette sh;
+    if (!loader.load(path, splats, &sh) || splats.empty()) return decoded;
+
+    // 로드 직후 처리(Morton 재배치, 가지치기 인덱스)도 여기서 끝내 렌더 스레드 부담을 줄임
+    decoded.scene = std::make_unique<SplatScene>(QFileInfo(path).fileName(), std::move(splats));
+    if (!sh.isEmpty()) decoded.scene->setShPalette(std::move(sh));
+    decoded.scene->reorderSpatially(false); // 피킹이 없으므로 BVH는 만들지 않음
+    decoded.scene->setPruneCutoff(alphaCutoff);
+
+    const std::vector<SplatCluster> &clusters = decoded.scene->clusters();
+    decoded.bboxMin = clusters.front().bboxMin;
+    decoded.bboxMax = clusters.front().bboxMax;
+    for (const SplatCluster &c : clusters) {
+        decoded.bboxMin = QVector3D(std::min(decoded.bboxMin.x(), c.bboxMin.x()),
+                                    std::min(decoded.bboxMin.y(), c.bboxMin.y()),
+                                    std::min(decoded.bboxMin.z(), c.bboxMin.z()));
+        decoded.bboxMax = QVector3D(std::max(decoded.bboxMax.x(), c.bboxMax.x()),
+                                    std::max(decoded.bboxMax.y(), c.bboxMax.y()),
+                                    std::max(decoded.bboxMax.z(), c.bboxMax.z()));
+    }
+    return decoded;
+}
+
+BatchRenderer::CachedScene *BatchRenderer::findCached(const QString &path)
+{
+    for (auto it = m_cache.begin(); it != m_cache.end(); ++it) {
+        if (it->path != path) continue;
+        m_cache.splice(m_cache.begin(), m_cache, it);
+        return &m_cache.front();
+    }
+    return nullptr;
+}
+
+bool BatchRenderer::isCached(const QString &path) const
+{
+    for (const CachedScene &entry : m_cache) {
+        if (entry.path == path) return true;
+    }
+    return false;
+}
+
+BatchRenderer::CachedScene *BatchRenderer::insertCached(const QString &path, DecodedScene decoded)
+{
+    m_cache.emplace_front();
+    CachedScene &entry = m_cache.front();
+    entry.path = path;
+    entry.scene = std::move(decoded.scene);
+    entry.bboxMin = decoded.bboxMin;
+    entry.bboxMax = decoded.bboxMax;
+
+    const SplatScene &scene = *entry.scene;
+    const std::vector<RenderSplat> &splats = scene.splats();
+    std::vector<float> packed = SplatShaders::packSplats(
+        splats.data(), splats.size(), scene.hasShPalette() ? scene.shPalette().indices.data() : nullptr);
+
+    glGenBuffers(1, &entry.buffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, entry.buffer);
+    glBufferData(GL_TEXTURE_BUFFER, packed.size() * sizeof(float), packed.data(), GL_STATIC_DRAW);
+    glGenTextures(1, &entry.texture);
+    glBindTexture(GL_TEXTURE_BUFFER, entry.texture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, entry.buffer);
+
+    qint64 shBytes = 0;
+    if (scene.hasShPalette()) {
+        std::vector<float> codebook;
+        SplatShaders::appendShCodebook(scene.shPalette(), codebook);
+        glGenBuffers(1, &entry.shBuffer);
+        glBindBuffer(GL_TEXTURE_BUFFER, entry.shBuffer);
+        glBufferData(GL_TEXTURE_BUFFER, codebook.size() * sizeof(float), codebook.data(), GL_STATIC_DRAW);
+        glGenTextures(1, &entry.shTexture);
+        glBindTexture(GL_TEXTURE_BUFFER, entry.shTexture);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, entry.shBuffer);
+        shBytes = qint64(codebook.size()) * 2 * sizeof(float); // CPU + GPU
+    }
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    // CPU 스플랫 + 가지치기/정렬 인덱스(대략 스플랫당 24바이트) + GPU TBO
+    entry.bytes = qint64(splats.size()) * (sizeof(RenderSplat) + 24 + SplatShaders::FLOATS_PER_SPLAT * sizeof(float))
+                  + shBytes;
+    m_cacheBytes += entry.bytes;
+
+    evict(&entry);
+    return &entry;
+}
+
+void BatchRenderer::evict(const CachedScene *keep)
+{
+    // 예산을 넘으면 가장 오래 안 쓴 것부터 (방금 넣은 것은 예산보다 커도 유지)
+    while (m_cacheBytes > m_cacheBudget && m_cache.size() > 1 && &m_cache.back() != keep) {
+        releaseCached(m_cache.back());
+        m_cache.pop_back();
+    }
+}
+
+void BatchRenderer::releaseCached(CachedScene &entry)
+{
+    if (entry.texture) glDeleteTextures(1, &entry.texture);
+    if (entry.buffer) glDeleteBuffers(1, &entry.buffer);
+    if (entry.shTexture) glDeleteTextures(1, &entry.shTexture);
+    if (entry.shBuffer) glDeleteBuffers(1, &entry.shBuffer);
+    entry.texture = entry.buffer = entry.shTexture = entry.shBuffer = 0;
+    m_cacheBytes -= entry.bytes;
+    entry.bytes = 0;
+}
+
+CameraState BatchRenderer::framePose(const BatchPose &pose, const QVector3D &bboxMin, const QVector3D &bboxMax)
+{
+    if (!pose.autoFrame) return pose.state;
+
+    // 바운딩 구가 세로 화각(45도)에 들어오도록
+    CameraState state = pose.state;
+    const float radius = std::max(0.5f * (bboxMax - bboxMin).length(), 1e-3f);
+    state.target = 0.5f * (bboxMin + bboxMax);
+    state.distance = radius / std::sin(qDegreesToRadians(22.5f));
+    return state;
+}
+
+QImage BatchRenderer::renderPose(CachedScene &entry, const BatchPose &pose, int width, int height)
+{
+    if (!m_fbo || m_fbo->width() != width || m_fbo->height() != height) {
+        delete m_fbo;
+        m_fbo = new QOpenGLFramebufferObject(width, height);
+    }
+
+    m_camera.setState(framePose(pose, entry.bboxMin, entry.bboxMax));
+    const QMatrix4x4 view = m_camera.getViewMatrix();
+
+    // 정렬 (씬 하나를 슬롯 0으로)
+    SplatScene &scene = *entry.scene;
+    if (scene.needsSort(view)) scene.sortBackToFront(view);
+    SplatScene::mergeBackToFront({ &scene }, { 0 }, m_drawList);
+    m_orderVbo.bind();
+    m_orderVbo.allocate(m_drawList.data(), int(m_drawList.size() * sizeof(quint32)));
+    m_orderVbo.release();
+
+    m_fbo->bind();
+    glViewport(0, 0, width, height);
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDepthMask(GL_FALSE);
+
+    m_program->bind();
+    const QMatrix4x4 proj = m_camera.getProjectionMatrix(float(width) / height);
+    m_program->setUniformValue("vp_matrix", proj * view);
+    m_program->setUniformValue("cameraRight", QVector3D(view(0, 0), view(1, 0), view(2, 0)));
+    m_program->setUniformValue("cameraUp", QVector3D(view(0, 1), view(1, 1), view(2, 1)));
+    m_program->setUniformValue("uGlobalScale", 1.0f);
+    m_program->setUniformValue("uAlphaCutoff", m_alphaCutoff);
+
+    QMatrix4x4 models[8];
+    GLfloat modelScales[8] = { 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f };
+    QVector3D cameraLocal[8];
+    GLint shBase[8] = {};
+    cameraLocal[0] = view.inverted().column(3).toVector3D(); // 모델 행렬이 단위 행렬
+    m_program->setUniformValueArray("uModel", models, 8);
+    m_program->setUniformValueArray("uModelScale", modelScales, 8, 1);
+    m_program->setUniformValueArray("uCameraLocal", cameraLocal, 8);
+    m_program->setUniformValueArray("uShBase", shBase, 8);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_BUFFER, entry.texture);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_BUFFER, entry.shTexture);
+    glActiveTexture(GL_TEXTURE0);
+
+    m_vao.bind();
+    if (!m_drawList.empty()) glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, GLsizei(m_drawList.size()));
+    m_vao.release();
+    m_program->release();
+
+    glDepthMask(GL_TRUE);
+    glDisable(GL_BLEND);
+    m_fbo->release();
+
+    // 블렌딩된 알파 채널은 의미가 없으므로 버림
+    return m_fbo->toImage().convertToFormat(QImage::Format_RGB32);
+}
+
+BatchStats BatchRenderer::run(const std::vector<BatchJob> &jobs)
+{
+    BatchStats stats;
+    if (!initialize()) return stats;
+    m_context.makeCurrent(&m_surface);
+
+    QElapsedTimer total;
+    total.start();
+
+    // 백그라운드 디코딩 중인 씬 (한 번에 하나)
+    std::future<DecodedScene> pending;
+    QString pendingPath;
+    const float cutoff = m_alphaCutoff;
+
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        const BatchJob &job = jobs[i];
+        ++stats.jobs;
+
+        QElapsedTimer timer;
+        CachedScene *entry = findCached(job.scenePath);
+        if (entry) {
+            ++stats.cacheHits;
+        } else {
+            ++stats.cacheMisses;
+            timer.start();
+            DecodedScene decoded;
+            if (pending.valid() && pendingPath == job.scenePath) {
+                decoded = pending.get();
+                pendingPath.clear();
+            } else {
+                decoded = decode(job.scenePath, cutoff);
+            }
+            stats.decodeWaitMs += timer.nsecsElapsed() / 1.0e6;
+
+            if (decoded.scene) {
+                timer.restart();
+                entry = insertCached(job.scenePath, std::move(decoded));
+                stats.uploadMs += timer.nsecsElapsed() / 1.0e6;
+            }
+        }
+
+        // 이 작업을 렌더링하는 동안 다음 작업의 씬을 미리 디코딩
+        if (i + 1 < jobs.size() && !pending.valid()) {
+            const QString &next = jobs[i + 1].scenePath;
+            if (next != job.scenePath && !isCached(next)) {
+                pendingPath = next;
+                pending = std::async(std::launch::async, &BatchRenderer::decode, next, cutoff);
+            }
+        }
+
+        if (!entry) {
+            qWarning() << "Job" << i << "- failed to load" << job.scenePath;
+            ++stats.failedJobs;
+            continue;
+        }
+
+        for (size_t p = 0; p < job.poses.size(); ++p) {
+            timer.restart();
+            QImage image = renderPose(*entry, job.poses[p], job.width, job.height);
+            stats.renderMs += timer.nsecsElapsed() / 1.0e6;
+
+            timer.restart();
+            const QString outPath = job.output.contains("%1") ? job.output.arg(int(p), 3, 10, QChar('0')) : job.output;
+            QDir().mkpath(QFileInfo(outPath).absolutePath());
+            if (image.save(outPath)) {
+                ++stats.images;
+            } else {
+                qWarning() << "Failed to write" << outPath;
+            }
+            stats.saveMs += timer.nsecsElapsed() / 1.0e6;
+        }
+    }
+
+    if (pending.valid()) pending.wait();
+    stats.seconds = total.nsecsElapsed() / 1.0e9;
+    m_context.doneCurrent();
+    return stats;
+}
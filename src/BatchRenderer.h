@@ -0,0 +1,133 @@
+#ifndef BATCHRENDERER_H
+#define BATCHRENDERER_H
+
+#include <QOpenGLExtraFunctions>
+#include <QOpenGLContext>
+#include <QOffscreenSurface>
+#include <QOpenGLFramebufferObject>
+#include <QOpenGLShaderProgram>
+#include <QOpenGLBuffer>
+#include <QOpenGLVertexArrayObject>
+#include <QString>
+#include <QImage>
+#include <list>
+#include <memory>
+#include <vector>
+#include "Camera.h"
+#include "SplatScene.h"
+#include "ShaderCache.h"
+
+// 배치 작업의 카메라 하나
+// autoFrame이면 target/distance를 씬 AABB에 맞춰 채우고 yaw/pitch만 사용합니다.
+struct BatchPose {
+    CameraState state;
+    bool autoFrame = false;
+};
+
+// 작업 하나 = 씬 하나를 여러 시점에서 output 크기로 렌더링
+// output에 "%1"이 있으면 시점 번호로 바꿉니다 (시점이 여러 개면 필수).
+struct BatchJob {
+    QString scenePath;
+    QString output;
+    int width = 512;
+    int height = 512;
+    std::vector<BatchPose> poses;
+};
+
+struct BatchStats {
+    int jobs = 0;
+    int failedJobs = 0;
+    int images = 0;
+    int cacheHits = 0;
+    int cacheMisses = 0;
+    double seconds = 0.0;
+    double decodeWaitMs = 0.0; // 디코딩을 기다리며 렌더 스레드가 멈춘 시간
+    double uploadMs = 0.0;
+    double renderMs = 0.0;     // 정렬 + 그리기 + 읽어오기
+    double saveMs = 0.0;
+
+    double jobsPerSecond() const { return seconds > 0.0 ? jobs / seconds : 0.0; }
+    QString toString() const;
+};
+
+// GUI 없이 작업 목록을 렌더링하는 배치 렌더러 (썸네일/턴테이블 미리보기 생성용)
+//
+//  - GL 컨텍스트(QOffscreenSurface)와 컴파일된 셰이더는 모든 작업에서 재사용
+//  - 디코딩된 씬(CPU 정렬 캐시 + GPU TBO)은 메모리 예산 안에서 LRU로 보관 (같은 씬을 다시 부르면 로드 생략)
+//  - 현재 작업을 렌더링하는 동안 다음 작업의 씬을 백그라운드 스레드에서 디코딩
+//
+// 작업 목록은 JSON:
+//   { "jobs": [ { "scene": "a.ply", "output": "thumbs/a_%1.png", "width": 512, "height": 512,
+//                 "poses": [ { "target": [0, 0, 0], "distance": 3, "yaw": 30, "pitch": -15 }, ... ],
+//                 "turntable": 36, "pitch": -15, "cameraPath": "orbit.campath", "pathStepMs": 16 } ] }
+//   poses의 target/distance를 생략하면 씬에 맞춰 자동으로 잡고,
+//   turntable: N이면 yaw를 360/N씩 돌린 자동 프레이밍 시점 N개를 추가합니다.
+//   cameraPath가 있으면 뷰어에서 기록한 경로를 pathStepMs(기본 16) 간격으로 재생한 시점을 모두 추가합니다
+//   (CameraPathPlayer와 같은 샘플링이므로 뷰어의 경로 재생과 같은 프레임들).
+//   poses, turntable, cameraPath가 모두 없으면 자동 프레이밍 시점 하나.
+class BatchRenderer : protected QOpenGLExtraFunctions
+{
+public:
+    BatchRenderer();
+    ~BatchRenderer();
+
+    static bool loadJobs(const QString &filePath, std::vector<BatchJob> &outJobs);
+
+    // 오프스크린 컨텍스트 생성 + 셰이더 컴파일 (한 번만)
+    bool initialize();
+
+    void setCacheBudget(qint64 bytes) { m_cacheBudget = bytes; }
+    void setAlphaCutoff(float cutoff) { m_alphaCutoff = cutoff; }
+
+    BatchStats run(const std::vector<BatchJob> &jobs);
+
+private:
+    struct DecodedScene {
+        std::unique_ptr<SplatScene> scene;
+        QVector3D bboxMin;
+        QVector3D bboxMax;
+    };
+    // 백그라운드 스레드에서 실행 (GL 호출 없음)
+    static DecodedScene decode(const QString &path, float alphaCutoff);
+
+    struct CachedScene {
+        QString path;
+        std::unique_ptr<SplatScene> scene;
+        QVector3D bboxMin;
+        QVector3D bboxMax;
+        GLuint buffer = 0;
+        GLuint texture = 0;
+        GLuint shBuffer = 0;
+        GLuint shTexture = 0;
+        qint64 bytes = 0;
+    };
+    CachedScene *findCached(const QString &path); // 찾으면 LRU 맨 앞으로
+    bool isCached(const QString &path) const;      // 순서는 그대로
+    CachedScene *insertCached(const QString &path, DecodedScene decoded);
+    void evict(const CachedScene *keep);
+    void releaseCached(CachedScene &entry);
+
+    QImage renderPose(CachedScene &entry, const BatchPose &pose, int width, int height);
+    static CameraState framePose(const BatchPose &pose, const QVector3D &bboxMin, const QVector3D &bboxMax);
+
+    QOffscreenSurface m_surface;
+    QOpenGLContext m_context;
+    ShaderCache m_shaderCache;
+    QOpenGLShaderProgram *m_program = nullptr; // m_shaderCache 소유
+    QOpenGLVertexArrayObject m_vao;
+    QOpenGLBuffer m_quadVbo;
+    QOpenGLBuffer m_orderVbo;
+    QOpenGLFramebufferObject *m_fbo = nullptr;
+    bool m_initialized = false;
+
+    // 최근에 쓴 것이 앞
+    std::list<CachedScene> m_cache;
+    qint64 m_cacheBudget = 2048ll * 1024 * 1024;
+    qint64 m_cacheBytes = 0;
+
+    float m_alphaCutoff = 0.05f; // 뷰어 기본값과 같게
+    Camera m_camera;
+    std::vector<quint32> m_drawList;
+};
+
+#endif // BATCHRENDERER_H
@@ -48,7 +48,11 @@ void Camera::handleMouseMove(QMouseEvent *event)
         if (m_pitch < -89.0f) m_pitch = -89.0f;
     }
     else if (event->buttons() & Qt::RightButton) {
-        // 우클릭: 패닝 (타겟 이동) - 구현은 나중에, 일단 빈칸
+        // 우클릭: 패닝 (타겟을 화면 평면을 따라 이동, 거리에 비례해 커서를 대략 따라감)
+        const QMatrix4x4 view = getViewMatrix();
+        const QVector3D right(view(0, 0), view(0, 1), view(0, 2));
+        const QVector3D up(view(1, 0), view(1, 1), view(1, 2));
+        m_target += (-right * dx + up * dy) * (m_distance * 0.002f);
     }
 
     m_lastPos = event->pos();
@@ -63,3 +67,21 @@ void Camera::handleWheel(QWheelEvent *event)
     m_distance -= numSteps * 0.2f;
     if (m_distance < 0.1f) m_distance = 0.1f; // 너무 가까워짐 방지
 }
+
+CameraState Camera::state() const
+{
+    CameraState s;
+    s.target = m_target;
+    s.distance = m_distance;
+    s.yaw = m_yaw;
+    s.pitch = m_pitch;
+    return s;
+}
+
+void Camera::setState(const CameraState &state)
+{
+    m_target = state.target;
+    m_distance = state.distance;
+    m_yaw = state.yaw;
+    m_pitch = state.pitch;
+}
@@ -5,6 +5,14 @@
 #include <QMatrix4x4>
 #include <QMouseEvent>
 
+// 카메라를 재현하는 데 필요한 최소 상태 (경로 기록/재생용)
+struct CameraState {
+    QVector3D target;
+    float distance = 3.0f;
+    float yaw = 0.0f;
+    float pitch = 0.0f;
+};
+
 class Camera
 {
 public:
@@ -20,6 +28,10 @@ public:
     void handleMouseMove(QMouseEvent *event);
     void handleWheel(QWheelEvent *event);
 
+    // 상태 저장/복원 (카메라 경로 재생 시 마우스 대신 사용)
+    CameraState state() const;
+    void setState(const CameraState &state);
+
 private:
     // 카메라 상태
     QVector3D m_target = QVector3D(0.0f, 0.0f, 0.0f); // 바라보는 점
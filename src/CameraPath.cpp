@@ -0,0 +1,166 @@
+#include "CameraPath.h"
+#include <QFile>
+#include <QTextStream>
+#include <QDebug>
+#include <algorithm>
+
+void CameraPath::append(qint64 timeMs, const CameraState &state)
+{
+    // 시간은 단조 증가해야 보간이 성립
+    if (!m_keys.empty() && timeMs < m_keys.back().timeMs) {
+        timeMs = m_keys.back().timeMs;
+    }
+    m_keys.push_back({ timeMs, state });
+}
+
+CameraState CameraPath::sample(qint64 timeMs) const
+{
+    if (m_keys.empty()) return CameraState();
+    if (timeMs <= m_keys.front().timeMs) return m_keys.front().state;
+    if (timeMs >= m_keys.back().timeMs) return m_keys.back().state;
+
+    // timeMs보다 큰 첫 키프레임
+    auto it = std::upper_bound(m_keys.begin(), m_keys.end(), timeMs,
+                               [](qint64 t, const CameraKeyframe &k) { return t < k.timeMs; });
+    const CameraKeyframe &b = *it;
+    const CameraKeyframe &a = *(it - 1);
+
+    qint64 span = b.timeMs - a.timeMs;
+    float t = span > 0 ? float(timeMs - a.timeMs) / float(span) : 1.0f;
+
+    CameraState s;
+    s.target = a.state.target + (b.state.target - a.state.target) * t;
+    s.distance = a.state.distance + (b.state.distance - a.state.distance) * t;
+    s.yaw = a.state.yaw + (b.state.yaw - a.state.yaw) * t;
+    s.pitch = a.state.pitch + (b.state.pitch - a.state.pitch) * t;
+    return s;
+}
+
+bool CameraPath::save(const QString &filePath) const
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qCritical() << "Failed to write camera path:" << filePath;
+        return false;
+    }
+
+    QTextStream out(&file);
+    out.setRealNumberPrecision(9); // 재생 결과가 기록과 비트 단위로 같도록
+    out << "# Switch2SplatViewer camera path v1\n";
+    out << "# timeMs targetX targetY targetZ distance yaw pitch\n";
+    for (const CameraKeyframe &k : m_keys) {
+        out << k.timeMs << ' '
+            << k.state.target.x() << ' ' << k.state.target.y() << ' ' << k.state.target.z() << ' '
+            << k.state.distance << ' ' << k.state.yaw << ' ' << k.state.pitch << '\n';
+    }
+    return true;
+}
+
+bool CameraPath::load(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qCritical() << "Failed to open camera path:" << filePath;
+        return false;
+    }
+
+    m_keys.clear();
+    while (!file.atEnd()) {
+        QByteArray line = file.readLine().trimmed();
+        if (line.isEmpty() || line.startsWith("#")) continue;
+
+        QList<QByteArray> parts = line.simplified().split(' ');
+        if (parts.size() < 7) {
+            qWarning() << "Skipping malformed camera path line:" << line;
+            continue;
+        }
+
+        CameraState s;
+        s.target = QVector3D(parts[1].toFloat(), parts[2].toFloat(), parts[3].toFloat());
+        s.distance = parts[4].toFloat();
+        s.yaw = parts[5].toFloat();
+        s.pitch = parts[6].toFloat();
+        append(parts[0].toLongLong(), s);
+    }
+
+    qDebug() << "Loaded camera path with" << m_keys.size() << "keyframes," << durationMs() << "ms";
+    return !m_keys.empty();
+}
+
+void CameraPathRecorder::start(const CameraState &initial)
+{
+    m_path.clear();
+    m_timer.start();
+    m_recording = true;
+    m_path.append(0, initial);
+}
+
+void CameraPathRecorder::record(const CameraState &state)
+{
+    if (!m_recording) return;
+    m_path.append(m_timer.elapsed(), state);
+}
+
+FrameTimeSummary FrameTimeSummary::fromSamples(std::vector<double> samples)
+{
+    FrameTimeSummary s;
+    if (samples.empty()) return s;
+
+    std::sort(samples.begin(), samples.end());
+    auto percentile = [&](double p) {
+        size_t idx = static_cast<size_t>(p * (samples.size() - 1) + 0.5);
+        return samples[idx];
+    };
+
+    double total = 0.0;
+    for (double v : samples) total += v;
+
+    s.frames = static_cast<int>(samples.size());
+    s.minMs = samples.front();
+    s.maxMs = samples.back();
+    s.avgMs = total / samples.size();
+    s.p50Ms = percentile(0.50);
+    s.p95Ms = percentile(0.95);
+    s.p99Ms = percentile(0.99);
+    return s;
+}
+
+QString FrameTimeSummary::toString() const
+{
+    return QString("frames=%1 avg=%2ms min=%3ms p50=%4ms p95=%5ms p99=%6ms max=%7ms (%8 FPS)")
+        .arg(frames)
+        .arg(avgMs, 0, 'f', 3)
+        .arg(minMs, 0, 'f', 3)
+        .arg(p50Ms, 0, 'f', 3)
+        .arg(p95Ms, 0, 'f', 3)
+        .arg(p99Ms, 0, 'f', 3)
+        .arg(maxMs, 0, 'f', 3)
+        .arg(avgMs > 0.0 ? 1000.0 / avgMs : 0.0, 0, 'f', 1);
+}
+
+void CameraPathPlayer::start(const CameraPath &path, qint64 stepMs)
+{
+    m_path = path;
+    m_stepMs = stepMs > 0 ? stepMs : 16;
+    m_frame = 0;
+    m_frameTimes.clear();
+    m_playing = !path.isEmpty();
+}
+
+int CameraPathPlayer::frameCount() const
+{
+    // 마지막 키프레임까지 포함
+    return static_cast<int>(m_path.durationMs() / m_stepMs) + 1;
+}
+
+bool CameraPathPlayer::nextFrame(CameraState &outState)
+{
+    if (!m_playing || m_frame >= frameCount()) {
+        m_playing = false;
+        return false;
+    }
+
+    outState = m_path.sample(m_frame * m_stepMs);
+    m_frame++;
+    return true;
+}
@@ -0,0 +1,99 @@
+#ifndef CAMERAPATH_H
+#define CAMERAPATH_H
+
+#include <QString>
+#include <QElapsedTimer>
+#include <vector>
+#include "Camera.h"
+
+// 시간(ms)이 붙은 카메라 상태 하나
+struct CameraKeyframe {
+    qint64 timeMs = 0;
+    CameraState state;
+};
+
+// 기록된 카메라 경로
+// 텍스트 파일 한 줄에 키프레임 하나: "timeMs tx ty tz distance yaw pitch"
+class CameraPath
+{
+public:
+    void clear() { m_keys.clear(); }
+    void append(qint64 timeMs, const CameraState &state);
+
+    bool isEmpty() const { return m_keys.empty(); }
+    int size() const { return static_cast<int>(m_keys.size()); }
+    qint64 durationMs() const { return m_keys.empty() ? 0 : m_keys.back().timeMs; }
+
+    // 임의 시각의 상태 (키프레임 사이 선형 보간)
+    CameraState sample(qint64 timeMs) const;
+
+    bool save(const QString &filePath) const;
+    bool load(const QString &filePath);
+
+private:
+    std::vector<CameraKeyframe> m_keys;
+};
+
+// 마우스로 움직인 카메라를 실제 시간 기준으로 기록
+class CameraPathRecorder
+{
+public:
+    void start(const CameraState &initial);
+    void stop() { m_recording = false; }
+    bool isRecording() const { return m_recording; }
+
+    // 카메라가 바뀔 때마다 호출
+    void record(const CameraState &state);
+
+    const CameraPath &path() const { return m_path; }
+
+private:
+    CameraPath m_path;
+    QElapsedTimer m_timer;
+    bool m_recording = false;
+};
+
+// 프레임 시간 요약 (ms)
+struct FrameTimeSummary {
+    int frames = 0;
+    double minMs = 0.0;
+    double avgMs = 0.0;
+    double p50Ms = 0.0;
+    double p95Ms = 0.0;
+    double p99Ms = 0.0;
+    double maxMs = 0.0;
+
+    static FrameTimeSummary fromSamples(std::vector<double> samples);
+    QString toString() const;
+};
+
+// 경로를 고정 스텝으로 재생
+// 벽시계 시간과 무관하게 프레임 N은 항상 경로상의 N * stepMs 시점을 보여주므로
+// 빌드/설정이 달라도 완전히 같은 시점들로 성능을 비교할 수 있습니다.
+// 위젯에 의존하지 않으므로 헤드리스 렌더러에서도 그대로 사용합니다.
+class CameraPathPlayer
+{
+public:
+    void start(const CameraPath &path, qint64 stepMs = 16);
+    void stop() { m_playing = false; }
+    bool isPlaying() const { return m_playing; }
+
+    // 다음 프레임의 카메라 상태. 경로가 끝났으면 false
+    bool nextFrame(CameraState &outState);
+
+    // 방금 그린 프레임의 소요 시간 기록
+    void recordFrameTime(double ms) { m_frameTimes.push_back(ms); }
+
+    int frameIndex() const { return m_frame; }
+    int frameCount() const;
+    FrameTimeSummary summary() const { return FrameTimeSummary::fromSamples(m_frameTimes); }
+
+private:
+    CameraPath m_path;
+    qint64 m_stepMs = 16;
+    int m_frame = 0;
+    bool m_playing = false;
+    std::vector<double> m_frameTimes;
+};
+
+#endif // CAMERAPATH_H
@@ -0,0 +1,320 @@
+#include "ChunkStreamer.h"
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// GPU에서는 스플랫 하나가 vec4 4개(64바이트)로 패킹됩니다 (SplattingWidget::uploadScene)
+const qint64 GPU_BYTES_PER_SPLAT = 16 * sizeof(float);
+
+// 카메라 이동 예측 시간 (이만큼 앞의 위치 주변을 미리 읽음)
+const float PREFETCH_SECONDS = 0.5f;
+
+float distanceToBox(const QVector3D &p, const QVector3D &mn, const QVector3D &mx)
+{
+    float dx = std::max({ mn.x() - p.x(), 0.0f, p.x() - mx.x() });
+    float dy = std::max({ mn.y() - p.y(), 0.0f, p.y() - mx.y() });
+    float dz = std::max({ mn.z() - p.z(), 0.0f, p.z() - mx.z() });
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+} // namespace
+
+ChunkStreamer::ChunkStreamer() {}
+
+ChunkStreamer::~ChunkStreamer()
+{
+    close();
+}
+
+bool ChunkStreamer::open(const QString &chunkFilePath, int ioThreads)
+{
+    close();
+    if (!m_scene.open(chunkFilePath)) return false;
+
+    m_chunks.clear();
+    m_chunks.resize(m_scene.chunkCount());
+    m_cpuBytes = 0;
+
+    // GPU 예산을 고정 크기 슬롯으로 나눔
+    const qint64 slotBytes = qint64(m_scene.maxChunkSplats()) * GPU_BYTES_PER_SPLAT;
+    m_gpuSlotCount = static_cast<int>(std::max<qint64>(1, m_gpuBudget / slotBytes));
+    m_gpuSlotCount = std::min(m_gpuSlotCount, m_scene.chunkCount());
+    m_slotChunk.assign(m_gpuSlotCount, -1);
+    m_pendingUploads.clear();
+
+    m_frame = 0;
+    m_velocity = QVector3D();
+    m_motionTimer.invalidate();
+    m_bytesRead = 0;
+    m_bytesAtLastSample = 0;
+    m_ioMBps = 0.0;
+    m_ioTimer.start();
+
+    m_quit = false;
+    for (int i = 0; i < std::max(1, ioThreads); ++i) {
+        m_ioThreads.emplace_back(&ChunkStreamer::ioThreadMain, this);
+    }
+
+    qDebug() << "Chunk streaming:" << m_gpuSlotCount << "GPU slots of" << m_scene.maxChunkSplats() << "splats";
+    return true;
+}
+
+void ChunkStreamer::close()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+        m_queue.clear();
+    }
+    m_wake.notify_all();
+    for (std::thread &t : m_ioThreads) t.join();
+    m_ioThreads.clear();
+
+    m_completed.clear();
+    m_chunks.clear();
+    m_slotChunk.clear();
+    m_pendingUploads.clear();
+    m_gpuSlotCount = 0;
+    m_cpuBytes = 0;
+    m_scene = ChunkedScene();
+}
+
+void ChunkStreamer::setBudgets(qint64 cpuBytes, qint64 gpuBytes)
+{
+    m_cpuBudget = cpuBytes;
+    m_gpuBudget = gpuBytes;
+}
+
+bool ChunkStreamer::isChunkNear(const ChunkInfo &chunk, const QMatrix4x4 &viewProj,
+                                const QVector3D &eye, float nearRadius)
+{
+    if (distanceToBox(eye, chunk.bboxMin, chunk.bboxMax) <= nearRadius) return true;
+
+    // 절두체 평면 6개 (Gribb-Hartmann): row3 ± row0/1/2
+    const QVector4D r0 = viewProj.row(0), r1 = viewProj.row(1), r2 = viewProj.row(2), r3 = viewProj.row(3);
+    const QVector4D planes[6] = { r3 + r0, r3 - r0, r3 + r1, r3 - r1, r3 + r2, r3 - r2 };
+
+    for (const QVector4D &pl : planes) {
+        // 평면 법선 방향으로 가장 멀리 있는 꼭짓점이 바깥이면 AABB 전체가 바깥
+        QVector3D p(pl.x() > 0 ? chunk.bboxMax.x() : chunk.bboxMin.x(),
+                    pl.y() > 0 ? chunk.bboxMax.y() : chunk.bboxMin.y(),
+                    pl.z() > 0 ? chunk.bboxMax.z() : chunk.bboxMin.z());
+        if (pl.x() * p.x() + pl.y() * p.y() + pl.z() * p.z() + pl.w() < 0.0f) return false;
+    }
+    return true;
+}
+
+bool ChunkStreamer::update(const QMatrix4x4 &view, const QMatrix4x4 &proj)
+{
+    if (!isOpen()) return false;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_frame++;
+
+    // 1. 완료된 로드 수거
+    for (Completed &c : m_completed) {
+        ChunkSlot &chunk = m_chunks[c.chunk];
+        if (c.ok) {
+            chunk.splats = std::move(c.splats);
+            chunk.state = ChunkState::InCpu;
+            m_cpuBytes += m_scene.chunks()[c.chunk].byteSize();
+        } else {
+            qWarning() << "Failed to read chunk" << c.chunk;
+            chunk.state = ChunkState::Unloaded;
+        }
+    }
+    m_completed.clear();
+
+    // 2. 카메라 위치와 이동 속도 (Prefetch 예측용)
+    const QVector3D eye = view.inverted().map(QVector3D(0, 0, 0));
+    if (m_motionTimer.isValid()) {
+        qint64 dtMs = m_motionTimer.restart();
+        if (dtMs > 0) {
+            QVector3D v = (eye - m_lastEye) * (1000.0f / dtMs);
+            m_velocity = m_velocity * 0.8f + v * 0.2f; // 튀는 값 완화
+        }
+    } else {
+        m_motionTimer.start();
+    }
+    m_lastEye = eye;
+
+    const QVector3D predictedEye = eye + m_velocity * PREFETCH_SECONDS;
+    QMatrix4x4 predictedView = view;
+    predictedView.translate(eye - predictedEye);
+
+    // 3. 지금 필요한 청크(시야 안 + 근처)와 곧 필요할 청크
+    const std::vector<ChunkInfo> &infos = m_scene.chunks();
+    const int chunkCount = m_scene.chunkCount();
+
+    QVector3D sceneMin = infos[0].bboxMin, sceneMax = infos[0].bboxMax;
+    for (const ChunkInfo &info : infos) {
+        sceneMin = QVector3D(std::min(sceneMin.x(), info.bboxMin.x()), std::min(sceneMin.y(), info.bboxMin.y()),
+                             std::min(sceneMin.z(), info.bboxMin.z()));
+        sceneMax = QVector3D(std::max(sceneMax.x(), info.bboxMax.x()), std::max(sceneMax.y(), info.bboxMax.y()),
+                             std::max(sceneMax.z(), info.bboxMax.z()));
+    }
+    const float nearRadius = (sceneMax - sceneMin).length() * 0.05f;
+
+    const QMatrix4x4 viewProj = proj * view;
+    const QMatrix4x4 predictedViewProj = proj * predictedView;
+
+    std::vector<std::pair<float, int>> wanted;
+    std::vector<std::pair<float, int>> prefetch;
+    for (int i = 0; i < chunkCount; ++i) {
+        if (isChunkNear(infos[i], viewProj, eye, nearRadius)) {
+            wanted.emplace_back(distanceToBox(eye, infos[i].bboxMin, infos[i].bboxMax), i);
+        } else if (isChunkNear(infos[i], predictedViewProj, predictedEye, nearRadius)) {
+            prefetch.emplace_back(distanceToBox(predictedEye, infos[i].bboxMin, infos[i].bboxMax), i);
+        }
+    }
+    std::sort(wanted.begin(), wanted.end());
+    std::sort(prefetch.begin(), prefetch.end());
+
+    // GPU 슬롯 수 이상은 어차피 그릴 수 없으므로 가까운 것부터 자름
+    if (static_cast<int>(wanted.size()) > m_gpuSlotCount) wanted.resize(m_gpuSlotCount);
+    if (static_cast<int>(prefetch.size()) > m_gpuSlotCount) prefetch.resize(m_gpuSlotCount);
+
+    std::vector<char> isWanted(chunkCount, 0);
+    std::vector<char> isProtected(chunkCount, 0);
+    for (const auto &w : wanted) {
+        isWanted[w.second] = 1;
+        isProtected[w.second] = 1;
+        m_chunks[w.second].lastUsedFrame = m_frame;
+    }
+    for (const auto &p : prefetch) isProtected[p.second] = 1;
+
+    // 4. 로드 큐 재구성 (필요한 것 먼저, 그다음 예측)
+    for (int c : m_queue) {
+        if (m_chunks[c].state == ChunkState::Queued) m_chunks[c].state = ChunkState::Unloaded;
+    }
+    m_queue.clear();
+    auto enqueue = [&](int c) {
+        if (m_chunks[c].state == ChunkState::Unloaded) {
+            m_chunks[c].state = ChunkState::Queued;
+            m_queue.push_back(c);
+        }
+    };
+    for (const auto &w : wanted) enqueue(w.second);
+    for (const auto &p : prefetch) enqueue(p.second);
+
+    // 5. CPU 캐시 예산 초과분 LRU 제거
+    evictCpu(isProtected);
+
+    // 6. GPU 슬롯 배정: 메모리에 올라온 필요한 청크를 빈 슬롯(없으면 LRU 슬롯)에 배치
+    bool changed = false;
+    for (const auto &w : wanted) {
+        const int c = w.second;
+        ChunkSlot &chunk = m_chunks[c];
+        if (chunk.gpuSlot >= 0 || chunk.state != ChunkState::InCpu) continue;
+
+        int target = -1;
+        qint64 oldest = m_frame;
+        for (int s = 0; s < m_gpuSlotCount; ++s) {
+            int occupant = m_slotChunk[s];
+            if (occupant < 0) { target = s; break; }
+            if (!isWanted[occupant] && m_chunks[occupant].lastUsedFrame < oldest) {
+                oldest = m_chunks[occupant].lastUsedFrame;
+                target = s;
+            }
+        }
+        if (target < 0) break; // 모든 슬롯이 지금 보이는 청크로 차 있음
+
+        if (m_slotChunk[target] >= 0) m_chunks[m_slotChunk[target]].gpuSlot = -1;
+        m_slotChunk[target] = c;
+        chunk.gpuSlot = target;
+        m_pendingUploads.push_back({ target, c, &chunk.splats });
+        changed = true;
+    }
+
+    // 7. 처리량 샘플링
+    if (m_ioTimer.elapsed() >= 1000) {
+        qint64 bytes = m_bytesRead.load();
+        m_ioMBps = (bytes - m_bytesAtLastSample) / (1024.0 * 1024.0) / (m_ioTimer.restart() / 1000.0);
+        m_bytesAtLastSample = bytes;
+    }
+
+    lock.unlock();
+    m_wake.notify_all();
+    return changed;
+}
+
+void ChunkStreamer::evictCpu(const std::vector<char> &protectedChunks)
+{
+    while (m_cpuBytes > m_cpuBudget) {
+        int victim = -1;
+        qint64 oldest = m_frame + 1;
+        for (int i = 0; i < static_cast<int>(m_chunks.size()); ++i) {
+            const ChunkSlot &chunk = m_chunks[i];
+            if (chunk.state != ChunkState::InCpu || protectedChunks[i]) continue;
+            // 업로드 대기 중인 데이터는 아직 지우면 안 됨
+            bool pending = std::any_of(m_pendingUploads.begin(), m_pendingUploads.end(),
+                                       [i](const SlotUpload &u) { return u.chunk == i; });
+            if (pending) continue;
+            if (chunk.lastUsedFrame < oldest) {
+                oldest = chunk.lastUsedFrame;
+                victim = i;
+            }
+        }
+        if (victim < 0) break; // 더 지울 수 있는 게 없음 (예산보다 보이는 청크가 큼)
+
+        ChunkSlot &chunk = m_chunks[victim];
+        std::vector<RenderSplat>().swap(chunk.splats);
+        chunk.state = ChunkState::Unloaded;
+        m_cpuBytes -= m_scene.chunks()[victim].byteSize();
+    }
+}
+
+std::vector<ChunkStreamer::SlotUpload> ChunkStreamer::takeSlotUploads()
+{
+    std::vector<SlotUpload> uploads;
+    uploads.swap(m_pendingUploads);
+    return uploads;
+}
+
+StreamingStats ChunkStreamer::stats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    StreamingStats s;
+    s.totalChunks = m_scene.chunkCount();
+    for (const ChunkSlot &chunk : m_chunks) {
+        if (chunk.state == ChunkState::InCpu) s.cpuResidentChunks++;
+        if (chunk.state == ChunkState::Queued || chunk.state == ChunkState::Loading) s.pendingLoads++;
+    }
+    for (int c : m_slotChunk) {
+        if (c < 0) continue;
+        s.gpuResidentChunks++;
+        s.gpuBytes += qint64(m_scene.chunks()[c].splatCount) * GPU_BYTES_PER_SPLAT;
+    }
+    s.cpuBytes = m_cpuBytes;
+    s.ioMBps = m_ioMBps;
+    return s;
+}
+
+void ChunkStreamer::ioThreadMain()
+{
+    const QString path = m_scene.filePath();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_wake.wait(lock, [this] { return m_quit || !m_queue.empty(); });
+        if (m_quit) return;
+
+        int c = m_queue.front();
+        m_queue.pop_front();
+        if (m_chunks[c].state != ChunkState::Queued) continue;
+
+        m_chunks[c].state = ChunkState::Loading;
+        const ChunkInfo info = m_scene.chunks()[c];
+        lock.unlock();
+
+        Completed done;
+        done.chunk = c;
+        done.ok = ChunkedScene::readChunk(path, info, done.splats);
+        m_bytesRead += info.byteSize();
+
+        lock.lock();
+        m_completed.push_back(std::move(done));
+    }
+}
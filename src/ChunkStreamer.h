@@ -0,0 +1,125 @@
+#ifndef CHUNKSTREAMER_H
+#define CHUNKSTREAMER_H
+
+#include <QMatrix4x4>
+#include <QVector3D>
+#include <QElapsedTimer>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include "ChunkedScene.h"
+
+// 청크 스트리밍 통계 (오버레이 표시용)
+struct StreamingStats {
+    int totalChunks = 0;
+    int cpuResidentChunks = 0; // 메모리(CPU 캐시)에 올라온 청크
+    int gpuResidentChunks = 0; // 그리기 대상(GPU 슬롯)에 올라간 청크
+    int pendingLoads = 0;
+    qint64 cpuBytes = 0;
+    qint64 gpuBytes = 0;
+    double ioMBps = 0.0;       // 최근 1초 평균 읽기 속도
+};
+
+// 메모리 예산 안에서 필요한 청크만 올리는 아웃오브코어 스트리머
+//
+// - 시야(Frustum) 안이거나 카메라 근처인 청크를 거리순으로 요청
+// - 카메라 이동 속도로 앞으로 갈 위치를 예측해서 그 주변을 미리 읽음 (Prefetch)
+// - 백그라운드 I/O 스레드가 파일에서 청크를 읽고, 메인 스레드는 update()에서 결과만 받음
+// - CPU 캐시와 GPU 슬롯 모두 예산을 넘으면 가장 오래 안 쓴(LRU) 청크부터 내림
+//
+// GPU 쪽은 고정 크기 슬롯(maxChunkSplats개) 배열로 관리하며,
+// 실제 버퍼 업로드는 호출자(SplattingWidget)가 takeSlotUploads() 결과를 보고 수행합니다.
+class ChunkStreamer
+{
+public:
+    ChunkStreamer();
+    ~ChunkStreamer();
+
+    bool open(const QString &chunkFilePath, int ioThreads = 2);
+    void close();
+    bool isOpen() const { return !m_scene.chunks().empty(); }
+
+    const ChunkedScene &scene() const { return m_scene; }
+
+    // 예산 (바이트). GPU 예산은 open() 전에 정해야 슬롯 수가 결정됩니다.
+    void setBudgets(qint64 cpuBytes, qint64 gpuBytes);
+    int gpuSlotCount() const { return m_gpuSlotCount; }
+    quint32 slotCapacity() const { return m_scene.maxChunkSplats(); }
+
+    // 매 프레임(또는 타이머) 호출: 완료된 로드를 받고, 원하는 청크를 다시 계산
+    // 반환값: GPU 상주 집합이 바뀌었는가
+    bool update(const QMatrix4x4 &view, const QMatrix4x4 &proj);
+
+    // GPU 슬롯 변경 내역
+    struct SlotUpload {
+        int slot;
+        int chunk;
+        const std::vector<RenderSplat> *splats; // CPU 캐시에 있는 데이터 (다음 update()까지 유효)
+    };
+    std::vector<SlotUpload> takeSlotUploads();
+
+    // 현재 GPU 슬롯별 청크 (-1 = 빈 슬롯)
+    const std::vector<int> &slotChunks() const { return m_slotChunk; }
+
+    StreamingStats stats() const;
+
+    // 청크 AABB가 시야(+여유 거리) 안에 있는가
+    static bool isChunkNear(const ChunkInfo &chunk, const QMatrix4x4 &viewProj,
+                            const QVector3D &eye, float nearRadius);
+
+private:
+    enum class ChunkState { Unloaded, Queued, Loading, InCpu };
+
+    struct ChunkSlot {
+        ChunkState state = ChunkState::Unloaded;
+        std::vector<RenderSplat> splats;
+        qint64 lastUsedFrame = -1;
+        int gpuSlot = -1;
+    };
+
+    void ioThreadMain();
+    void evictCpu(const std::vector<char> &protectedChunks);
+
+    ChunkedScene m_scene;
+    std::vector<ChunkSlot> m_chunks;
+
+    // 예산
+    qint64 m_cpuBudget = 1024ll * 1024 * 1024; // 1 GB
+    qint64 m_gpuBudget = 512ll * 1024 * 1024;  // 512 MB
+    qint64 m_cpuBytes = 0;
+
+    // GPU 슬롯
+    int m_gpuSlotCount = 0;
+    std::vector<int> m_slotChunk;
+    std::vector<SlotUpload> m_pendingUploads;
+
+    // 카메라 예측용
+    QVector3D m_lastEye;
+    QElapsedTimer m_motionTimer;
+    QVector3D m_velocity;
+    qint64 m_frame = 0;
+
+    // I/O 스레드 공유 상태 (m_mutex로 보호)
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::deque<int> m_queue;        // 우선순위 순서 (앞쪽이 먼저)
+    struct Completed {
+        int chunk;
+        bool ok;
+        std::vector<RenderSplat> splats;
+    };
+    std::vector<Completed> m_completed;
+    bool m_quit = false;
+    std::vector<std::thread> m_ioThreads;
+
+    // I/O 처리량
+    std::atomic<qint64> m_bytesRead { 0 };
+    qint64 m_bytesAtLastSample = 0;
+    QElapsedTimer m_ioTimer;
+    double m_ioMBps = 0.0;
+};
+
+#endif // CHUNKSTREAMER_H
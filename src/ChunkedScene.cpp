@@ -0,0 +1,209 @@
+#include "ChunkedScene.h"
+#include <QFile>
+#include <QDebug>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const char CHUNK_MAGIC[4] = { 'S', '2', 'S', 'C' };
+const quint32 CHUNK_VERSION = 1;
+
+#pragma pack(push, 1)
+struct FileHeader {
+    char magic[4];
+    quint32 version;
+    quint32 chunkCount;
+    quint32 maxChunkSplats;
+    quint64 totalSplats;
+};
+
+struct FileChunk {
+    float bboxMin[3];
+    float bboxMax[3];
+    quint32 splatCount;
+    quint32 reserved;
+    quint64 offset;
+};
+#pragma pack(pop)
+
+// [begin, end) 구간을 가장 긴 축의 중앙값으로 나누며 청크 범위를 모음
+void splitRecursive(std::vector<RenderSplat> &splats, size_t begin, size_t end, quint32 maxChunkSplats,
+                    std::vector<std::pair<size_t, size_t>> &outRanges)
+{
+    if (end - begin <= maxChunkSplats) {
+        outRanges.emplace_back(begin, end);
+        return;
+    }
+
+    float mn[3] = { splats[begin].x, splats[begin].y, splats[begin].z };
+    float mx[3] = { mn[0], mn[1], mn[2] };
+    for (size_t i = begin; i < end; ++i) {
+        const float p[3] = { splats[i].x, splats[i].y, splats[i].z };
+        for (int a = 0; a < 3; ++a) {
+            mn[a] = std::min(mn[a], p[a]);
+            mx[a] = std::max(mx[a], p[a]);
+        }
+    }
+
+    int axis = 0;
+    if (mx[1] - mn[1] > mx[axis] - mn[axis]) axis = 1;
+    if (mx[2] - mn[2] > mx[axis] - mn[axis]) axis = 2;
+
+    size_t mid = begin + (end - begin) / 2;
+    std::nth_element(splats.begin() + begin, splats.begin() + mid, splats.begin() + end,
+                     [axis](const RenderSplat &a, const RenderSplat &b) {
+                         const float pa = axis == 0 ? a.x : (axis == 1 ? a.y : a.z);
+                         const float pb = axis == 0 ? b.x : (axis == 1 ? b.y : b.z);
+                         return pa < pb;
+                     });
+
+    splitRecursive(splats, begin, mid, maxChunkSplats, outRanges);
+    splitRecursive(splats, mid, end, maxChunkSplats, outRanges);
+}
+
+} // namespace
+
+bool ChunkedScene::open(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCritical() << "Failed to open chunked scene:" << filePath;
+        return false;
+    }
+
+    FileHeader header;
+    if (file.read(reinterpret_cast<char *>(&header), sizeof(header)) != sizeof(header)
+        || std::memcmp(header.magic, CHUNK_MAGIC, 4) != 0
+        || header.version != CHUNK_VERSION) {
+        qCritical() << "Not a chunked scene file:" << filePath;
+        return false;
+    }
+
+    // 테이블 크기를 먼저 파일 크기와 맞춰 본 뒤에 할당 (손상된 chunkCount로 거대한 할당을 하지 않도록)
+    const quint64 fileSize = quint64(file.size());
+    const quint64 tableEnd = sizeof(FileHeader) + quint64(header.chunkCount) * sizeof(FileChunk);
+    if (header.chunkCount == 0 || header.maxChunkSplats == 0 || tableEnd > fileSize) {
+        qCritical() << "Corrupt chunked scene header:" << filePath << header.chunkCount << "chunks of up to"
+                    << header.maxChunkSplats << "splats in" << fileSize << "bytes";
+        return false;
+    }
+
+    std::vector<FileChunk> table(header.chunkCount);
+    const qint64 tableBytes = qint64(table.size()) * qint64(sizeof(FileChunk));
+    if (file.read(reinterpret_cast<char *>(table.data()), tableBytes) != tableBytes) {
+        qCritical() << "Truncated chunk table:" << filePath;
+        return false;
+    }
+
+    // 청크마다: 슬롯 용량(maxChunkSplats) 이하이고 본문이 테이블 뒤, 파일 안에 있어야 함
+    // (스트리머가 슬롯을 고정 크기로 잡으므로 큰 청크는 다음 슬롯의 GPU 데이터를 덮어씀)
+    quint64 splatSum = 0;
+    for (size_t c = 0; c < table.size(); ++c) {
+        const FileChunk &fc = table[c];
+        const quint64 bytes = quint64(fc.splatCount) * sizeof(RenderSplat);
+        if (fc.splatCount > header.maxChunkSplats || fc.offset < tableEnd || fc.offset > fileSize
+            || bytes > fileSize - fc.offset) {
+            qCritical() << "Corrupt chunk" << c << "in" << filePath << "-" << fc.splatCount << "splats at offset"
+                        << fc.offset << "(limit" << header.maxChunkSplats << "splats," << fileSize << "bytes)";
+            return false;
+        }
+        splatSum += fc.splatCount;
+    }
+    if (splatSum != header.totalSplats) {
+        qCritical() << "Corrupt chunked scene:" << filePath << "- chunks hold" << splatSum << "splats, header says"
+                    << header.totalSplats;
+        return false;
+    }
+
+    m_chunks.clear();
+    m_chunks.reserve(table.size());
+    for (const FileChunk &fc : table) {
+        ChunkInfo info;
+        info.bboxMin = QVector3D(fc.bboxMin[0], fc.bboxMin[1], fc.bboxMin[2]);
+        info.bboxMax = QVector3D(fc.bboxMax[0], fc.bboxMax[1], fc.bboxMax[2]);
+        info.splatCount = fc.splatCount;
+        info.offset = fc.offset;
+        m_chunks.push_back(info);
+    }
+
+    m_filePath = filePath;
+    m_maxChunkSplats = header.maxChunkSplats;
+    m_totalSplats = header.totalSplats;
+
+    qDebug() << "Opened chunked scene:" << m_chunks.size() << "chunks," << m_totalSplats << "splats";
+    return true;
+}
+
+bool ChunkedScene::readChunk(const QString &filePath, const ChunkInfo &chunk, std::vector<RenderSplat> &out)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly) || !file.seek(qint64(chunk.offset))) {
+        return false;
+    }
+
+    out.resize(chunk.splatCount);
+    const qint64 bytes = chunk.byteSize();
+    return file.read(reinterpret_cast<char *>(out.data()), bytes) == bytes;
+}
+
+bool ChunkedScene::build(std::vector<RenderSplat> splats, const QString &outPath, quint32 maxChunkSplats)
+{
+    if (splats.empty() || maxChunkSplats == 0) return false;
+
+    std::vector<std::pair<size_t, size_t>> ranges;
+    splitRecursive(splats, 0, splats.size(), maxChunkSplats, ranges);
+
+    QFile file(outPath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCritical() << "Failed to write chunked scene:" << outPath;
+        return false;
+    }
+
+    FileHeader header;
+    std::memcpy(header.magic, CHUNK_MAGIC, 4);
+    header.version = CHUNK_VERSION;
+    header.chunkCount = static_cast<quint32>(ranges.size());
+    header.maxChunkSplats = maxChunkSplats;
+    header.totalSplats = splats.size();
+
+    std::vector<FileChunk> table(ranges.size());
+    quint64 offset = sizeof(FileHeader) + table.size() * sizeof(FileChunk);
+    for (size_t c = 0; c < ranges.size(); ++c) {
+        FileChunk &fc = table[c];
+        const RenderSplat &first = splats[ranges[c].first];
+        float mn[3] = { first.x, first.y, first.z };
+        float mx[3] = { first.x, first.y, first.z };
+        for (size_t i = ranges[c].first; i < ranges[c].second; ++i) {
+            const float p[3] = { splats[i].x, splats[i].y, splats[i].z };
+            for (int a = 0; a < 3; ++a) {
+                mn[a] = std::min(mn[a], p[a]);
+                mx[a] = std::max(mx[a], p[a]);
+            }
+        }
+        std::memcpy(fc.bboxMin, mn, sizeof(mn));
+        std::memcpy(fc.bboxMax, mx, sizeof(mx));
+        fc.splatCount = static_cast<quint32>(ranges[c].second - ranges[c].first);
+        fc.reserved = 0;
+        fc.offset = offset;
+        offset += quint64(fc.splatCount) * sizeof(RenderSplat);
+    }
+
+    bool written = file.write(reinterpret_cast<const char *>(&header), sizeof(header)) == qint64(sizeof(header));
+    const qint64 tableBytes = qint64(table.size() * sizeof(FileChunk));
+    written = written && file.write(reinterpret_cast<const char *>(table.data()), tableBytes) == tableBytes;
+    for (const auto &range : ranges) {
+        if (!written) break;
+        const qint64 bytes = qint64((range.second - range.first) * sizeof(RenderSplat));
+        written = file.write(reinterpret_cast<const char *>(&splats[range.first]), bytes) == bytes;
+    }
+    if (!written || !file.flush()) {
+        qCritical() << "Failed to write chunked scene:" << outPath << "-" << file.errorString();
+        file.close();
+        file.remove(); // 잘린 파일을 남기지 않음
+        return false;
+    }
+
+    qDebug() << "Wrote chunked scene:" << outPath << ranges.size() << "chunks," << splats.size() << "splats";
+    return true;
+}
@@ -0,0 +1,50 @@
+#ifndef CHUNKEDSCENE_H
+#define CHUNKEDSCENE_H
+
+#include <QString>
+#include <QVector3D>
+#include <vector>
+#include "GaussianData.h"
+
+// 디스크에 공간 청크 단위로 저장된 씬 (.s2sc)
+//
+// 파일 구조 (리틀 엔디언):
+//   Header     : magic "S2SC", version(u32), chunkCount(u32), maxChunkSplats(u32), totalSplats(u64)
+//   ChunkTable : chunkCount x { bboxMin(3 f32), bboxMax(3 f32), splatCount(u32), reserved(u32), offset(u64) }
+//   Body       : 청크마다 RenderSplat 배열 (청크 안에서는 공간적으로 가까운 스플랫끼리 모여 있음)
+struct ChunkInfo {
+    QVector3D bboxMin;
+    QVector3D bboxMax;
+    quint32 splatCount = 0;
+    quint64 offset = 0; // 파일 안의 바이트 위치
+
+    qint64 byteSize() const { return qint64(splatCount) * qint64(sizeof(RenderSplat)); }
+};
+
+class ChunkedScene
+{
+public:
+    // 헤더와 청크 테이블만 읽음 (본문은 ChunkStreamer가 필요할 때 읽음)
+    bool open(const QString &filePath);
+
+    const QString &filePath() const { return m_filePath; }
+    const std::vector<ChunkInfo> &chunks() const { return m_chunks; }
+    int chunkCount() const { return static_cast<int>(m_chunks.size()); }
+    quint32 maxChunkSplats() const { return m_maxChunkSplats; }
+    quint64 totalSplats() const { return m_totalSplats; }
+
+    // 청크 하나를 읽음 (여러 I/O 스레드가 각자 QFile을 열어 호출해도 안전)
+    static bool readChunk(const QString &filePath, const ChunkInfo &chunk, std::vector<RenderSplat> &out);
+
+    // 메모리에 올라온 씬을 공간 청크로 나눠 저장
+    // 청크당 최대 maxChunkSplats개가 되도록 중앙값 기준으로 재귀 분할 (k-d 분할)
+    static bool build(std::vector<RenderSplat> splats, const QString &outPath, quint32 maxChunkSplats = 65536);
+
+private:
+    QString m_filePath;
+    std::vector<ChunkInfo> m_chunks;
+    quint32 m_maxChunkSplats = 0;
+    quint64 m_totalSplats = 0;
+};
+
+#endif // CHUNKEDSCENE_H
@@ -0,0 +1,144 @@
+#include "FrameLatency.h"
+#include <algorithm>
+
+void LatencyHistogram::add(double ms)
+{
+    const int bin = std::clamp(static_cast<int>(ms / BIN_MS), 0, BIN_COUNT - 1);
+    ++m_bins[bin];
+    ++m_count;
+    m_sumMs += ms;
+    m_maxMs = std::max(m_maxMs, ms);
+}
+
+void LatencyHistogram::clear()
+{
+    std::fill(m_bins.begin(), m_bins.end(), 0);
+    m_count = 0;
+    m_sumMs = 0.0;
+    m_maxMs = 0.0;
+}
+
+double LatencyHistogram::percentileMs(double p) const
+{
+    if (m_count == 0) return 0.0;
+    const int target = std::max(1, static_cast<int>(p * m_count + 0.5));
+    int seen = 0;
+    for (int i = 0; i < BIN_COUNT; ++i) {
+        seen += m_bins[i];
+        if (seen >= target) return i == BIN_COUNT - 1 ? m_maxMs : (i + 1) * BIN_MS;
+    }
+    return m_maxMs;
+}
+
+QString LatencyHistogram::toString() const
+{
+    return QString("n=%1 avg=%2ms p50=%3ms p95=%4ms p99=%5ms max=%6ms")
+        .arg(m_count)
+        .arg(meanMs(), 0, 'f', 2)
+        .arg(percentileMs(0.50), 0, 'f', 2)
+        .arg(percentileMs(0.95), 0, 'f', 2)
+        .arg(percentileMs(0.99), 0, 'f', 2)
+        .arg(m_maxMs, 0, 'f', 2);
+}
+
+void LatencyTracker::setEnabled(bool enabled)
+{
+    if (m_enabled == enabled) return;
+    m_enabled = enabled;
+    m_pendingInputs.clear();
+    m_inFlightHead = 0;
+    m_inFlightCount = 0;
+    m_inFrame = false;
+}
+
+void LatencyTracker::markInput()
+{
+    if (m_enabled) m_pendingInputs.push_back(nowNs());
+}
+
+void LatencyTracker::beginFrame()
+{
+    // 시작 지연 예측은 측정을 끈 상태에서도 쓰므로 프레임 시각은 항상 기록
+    // 지난 프레임이 남긴 벡터를 비워 다음 입력 대기열로 돌려 씀
+    m_current.inputs.clear();
+    m_current.inputs.swap(m_pendingInputs);
+    m_current.startNs = nowNs();
+    m_current.sortDoneNs = 0;
+    m_current.drawDoneNs = 0;
+    m_current.endNs = 0;
+    m_inFrame = true;
+}
+
+void LatencyTracker::markSortDone()
+{
+    if (m_inFrame) m_current.sortDoneNs = nowNs();
+}
+
+void LatencyTracker::markDrawDone()
+{
+    if (m_inFrame) m_current.drawDoneNs = nowNs();
+}
+
+void LatencyTracker::endFrame()
+{
+    if (!m_inFrame) return;
+    m_inFrame = false;
+    m_current.endNs = nowNs();
+    if (m_current.sortDoneNs == 0) m_current.sortDoneNs = m_current.startNs;
+    if (m_current.drawDoneNs == 0) m_current.drawDoneNs = m_current.sortDoneNs;
+
+    const double renderMs = (m_current.endNs - m_current.startNs) / 1.0e6;
+    m_renderMs = m_renderMs > 0.0 ? 0.8 * m_renderMs + 0.2 * renderMs : renderMs;
+
+    // 가득 찼으면 가장 오래된 프레임을 버림 (스왑 신호를 놓친 경우)
+    if (m_inFlightCount == MAX_IN_FLIGHT) {
+        m_inFlightHead = (m_inFlightHead + 1) % MAX_IN_FLIGHT;
+        --m_inFlightCount;
+    }
+    // 슬롯의 옛 입력 벡터는 m_current로 넘어와 다음 프레임에 재사용
+    std::swap(m_inFlight[(m_inFlightHead + m_inFlightCount) % MAX_IN_FLIGHT], m_current);
+    ++m_inFlightCount;
+}
+
+void LatencyTracker::framePresented()
+{
+    const qint64 now = nowNs();
+    m_lastPresentNs = now;
+    if (m_inFlightCount == 0) return;
+
+    // 슬롯은 다음 endFrame까지 덮이지 않으므로 복사하지 않고 읽음
+    const Frame &frame = m_inFlight[m_inFlightHead];
+    m_inFlightHead = (m_inFlightHead + 1) % MAX_IN_FLIGHT;
+    --m_inFlightCount;
+    if (!m_enabled) return;
+
+    const double sortMs = (frame.sortDoneNs - frame.startNs) / 1.0e6;
+    const double drawMs = (frame.drawDoneNs - frame.sortDoneNs) / 1.0e6;
+    const double presentMs = (now - frame.endNs) / 1.0e6;
+    for (qint64 inputNs : frame.inputs) {
+        m_histograms[Latency_Queue].add((frame.startNs - inputNs) / 1.0e6);
+        m_histograms[Latency_Sort].add(sortMs);
+        m_histograms[Latency_Draw].add(drawMs);
+        m_histograms[Latency_Present].add(presentMs);
+        m_histograms[Latency_Total].add((now - inputNs) / 1.0e6);
+    }
+}
+
+void LatencyTracker::reset()
+{
+    for (LatencyHistogram &h : m_histograms) h.clear();
+    m_pendingInputs.clear();
+    m_inFlightHead = 0;
+    m_inFlightCount = 0;
+    m_inFrame = false;
+}
+
+QString LatencyTracker::summary() const
+{
+    static const char *names[LatencyStageCount] = { "queue", "sort", "draw", "present", "total" };
+    QString text;
+    for (int i = 0; i < LatencyStageCount; ++i) {
+        text += QString("%1: %2\n").arg(names[i], -8).arg(m_histograms[i].toString());
+    }
+    return text;
+}
@@ -0,0 +1,103 @@
+#ifndef FRAMELATENCY_H
+#define FRAMELATENCY_H
+
+#include <QString>
+#include <QElapsedTimer>
+#include <vector>
+
+// 지연 히스토그램 (BIN_MS 간격, 마지막 칸은 그 이상 전부)
+// 이벤트가 수십만 개 쌓여도 메모리가 고정되도록 샘플 대신 칸만 셉니다.
+class LatencyHistogram
+{
+public:
+    static const int BIN_COUNT = 200;
+    static constexpr double BIN_MS = 0.25; // 0 ~ 50ms
+
+    void add(double ms);
+    void clear();
+
+    int count() const { return m_count; }
+    double meanMs() const { return m_count > 0 ? m_sumMs / m_count : 0.0; }
+    double maxMs() const { return m_maxMs; }
+    double percentileMs(double p) const; // 칸의 위쪽 경계 (= 이 값 이하가 p 비율)
+    const std::vector<int> &bins() const { return m_bins; }
+
+    QString toString() const;
+
+private:
+    std::vector<int> m_bins = std::vector<int>(BIN_COUNT, 0);
+    int m_count = 0;
+    double m_sumMs = 0.0;
+    double m_maxMs = 0.0;
+};
+
+// 입력 -> 화면 표시 지연의 구간
+enum LatencyStage {
+    Latency_Queue,   // 입력 도착 -> 그 입력을 읽는 프레임 시작 (지연 시작 모드의 대기 포함)
+    Latency_Sort,    // 프레임 시작 -> 정렬 패스 끝
+    Latency_Draw,    // 정렬 끝 -> 스플랫/출력 패스 제출 끝 (CPU)
+    Latency_Present, // paintGL 끝 -> 합성 + 스왑 완료 (frameSwapped)
+    Latency_Total,   // 입력 도착 -> 스왑 완료
+    LatencyStageCount
+};
+
+// 입력 이벤트마다 도착 시각을 찍고, 그 입력을 처음 반영한 프레임의 단계 시각과 묶어
+// 스왑이 끝나는 순간 이벤트별 구간 지연을 히스토그램에 쌓습니다.
+// 한 프레임이 여러 입력을 반영하면 입력마다 따로 셉니다 (오래 기다린 입력일수록 큰 값).
+class LatencyTracker
+{
+public:
+    LatencyTracker() { m_clock.start(); }
+
+    qint64 nowNs() const { return m_clock.nsecsElapsed(); }
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled; }
+
+    // 위젯 이벤트 핸들러에서 (카메라를 바꾸는 입력만)
+    void markInput();
+
+    // paintGL 안에서 순서대로. 대기 중인 입력은 beginFrame에서 이 프레임에 묶임
+    void beginFrame();
+    void markSortDone();
+    void markDrawDone();
+    void endFrame();
+
+    // QOpenGLWidget::frameSwapped. 가장 오래된 진행 중 프레임을 완료 처리
+    void framePresented();
+
+    // 시작 지연 예측용 (입력이 없는 프레임 포함)
+    // 프레임 시작 -> 스왑은 vsync에서 주기에 묶이므로 쓰지 않고, paintGL 안의 CPU 시간만 이동 평균
+    double renderMs() const { return m_renderMs; }
+    qint64 lastPresentNs() const { return m_lastPresentNs; }
+
+    const LatencyHistogram &histogram(LatencyStage stage) const { return m_histograms[stage]; }
+    void reset();
+    QString summary() const;
+
+private:
+    struct Frame {
+        std::vector<qint64> inputs;
+        qint64 startNs = 0;
+        qint64 sortDoneNs = 0;
+        qint64 drawDoneNs = 0;
+        qint64 endNs = 0;
+    };
+    static const int MAX_IN_FLIGHT = 4; // 스왑 신호를 놓친 프레임이 쌓이지 않게
+
+    QElapsedTimer m_clock;
+    bool m_enabled = false;
+    std::vector<qint64> m_pendingInputs;
+    Frame m_current;
+    bool m_inFrame = false;
+    // 고정 크기 링 (입력 벡터의 용량은 프레임끼리 돌려 쓰므로 정상 상태에서는 할당 없음)
+    Frame m_inFlight[MAX_IN_FLIGHT];
+    int m_inFlightHead = 0; // 가장 오래된 프레임
+    int m_inFlightCount = 0;
+
+    LatencyHistogram m_histograms[LatencyStageCount];
+    double m_renderMs = 0.0;
+    qint64 m_lastPresentNs = -1;
+};
+
+#endif // FRAMELATENCY_H
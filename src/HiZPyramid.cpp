@@ -0,0 +1,234 @@
+#include "HiZPyramid.h"
+#include "ShaderCache.h"
+#include <QDebug>
+#include <algorithm>
+
+namespace {
+
+// 전체 화면 삼각형 (정점 버퍼 없이 gl_VertexID 0, 1, 2)
+const char *REDUCE_VERTEX_SOURCE = R"(
+    #version 330 core
+    void main() {
+        vec2 pos = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+        gl_Position = vec4(pos * 2.0 - 1.0, 0.0, 1.0);
+    }
+)";
+
+// 출력 텍셀 하나 = 원본 2x2의 최댓값 (가장 먼 깊이)
+// 출력 크기는 올림(ceil)이므로 홀수 크기의 마지막 줄은 원본 가장자리를 다시 읽음
+const char *REDUCE_FRAGMENT_SOURCE = R"(
+    #version 330 core
+    uniform sampler2D uSource;
+    uniform ivec2 uSourceSize;
+
+    out float FragDepth;
+
+    void main() {
+        ivec2 base = ivec2(gl_FragCoord.xy) * 2;
+        ivec2 last = uSourceSize - 1;
+        float d = texelFetch(uSource, min(base, last), 0).r;
+        d = max(d, texelFetch(uSource, min(base + ivec2(1, 0), last), 0).r);
+        d = max(d, texelFetch(uSource, min(base + ivec2(0, 1), last), 0).r);
+        d = max(d, texelFetch(uSource, min(base + ivec2(1, 1), last), 0).r);
+        FragDepth = d;
+    }
+)";
+
+int halfUp(int size) { return std::max(1, (size + 1) / 2); }
+
+} // namespace
+
+bool HiZPyramid::initialize(ShaderCache &cache, int width, int height)
+{
+    initializeOpenGLFunctions();
+    destroy();
+
+    m_reduceProgram = cache.program(REDUCE_VERTEX_SOURCE, REDUCE_FRAGMENT_SOURCE);
+    if (!m_reduceProgram) return false;
+    m_width = width;
+    m_height = height;
+
+    // 1. 가리개 깊이 (샘플링해야 하므로 렌더버퍼가 아닌 텍스처)
+    glGenTextures(1, &m_depthTexture);
+    glBindTexture(GL_TEXTURE_2D, m_depthTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+
+    glGenFramebuffers(1, &m_depthFbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_depthFbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_depthTexture, 0);
+    const GLenum none = GL_NONE;
+    glDrawBuffers(1, &none);
+    glReadBuffer(GL_NONE);
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+
+    // 2. GPU 축소 단계 (R32F), 폭이 READBACK_WIDTH 이하가 될 때까지
+    int w = width, h = height;
+    while (w > READBACK_WIDTH) {
+        w = halfUp(w);
+        h = halfUp(h);
+        GpuLevel level;
+        level.width = w;
+        level.height = h;
+        glGenTextures(1, &level.texture);
+        glBindTexture(GL_TEXTURE_2D, level.texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, w, h, 0, GL_RED, GL_FLOAT, nullptr);
+
+        glGenFramebuffers(1, &level.fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, level.fbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, level.texture, 0);
+        complete = complete && glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        m_gpuLevels.push_back(level);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    // 3. CPU 단계: 읽어 온 단계부터 1x1까지 (크기를 미리 잡아 두고 이후로는 늘리지 않음)
+    size_t total = 0;
+    for (;;) {
+        CpuLevel level;
+        level.offset = total;
+        level.width = w;
+        level.height = h;
+        m_cpuLevels.push_back(level);
+        total += size_t(w) * h;
+        if (w == 1 && h == 1) break;
+        w = halfUp(w);
+        h = halfUp(h);
+    }
+    m_cpuDepth.assign(total, 1.0f);
+
+    m_vao.create();
+    m_reduceProgram->bind();
+    m_reduceProgram->setUniformValue("uSource", 0);
+    m_reduceProgram->release();
+    m_sourceSizeLocation = m_reduceProgram->uniformLocation("uSourceSize");
+
+    if (!complete) {
+        qCritical() << "Hi-Z pyramid framebuffer incomplete";
+        destroy();
+        return false;
+    }
+    qDebug() << "Hi-Z pyramid:" << width << "x" << height << "->" << m_cpuLevels.front().width << "x"
+             << m_cpuLevels.front().height << "readback," << m_gpuLevels.size() + m_cpuLevels.size() << "levels";
+    return true;
+}
+
+void HiZPyramid::destroy()
+{
+    for (GpuLevel &level : m_gpuLevels) {
+        glDeleteFramebuffers(1, &level.fbo);
+        glDeleteTextures(1, &level.texture);
+    }
+    m_gpuLevels.clear();
+    m_cpuLevels.clear();
+    m_cpuDepth.clear();
+    if (m_depthFbo) glDeleteFramebuffers(1, &m_depthFbo);
+    if (m_depthTexture) glDeleteTextures(1, &m_depthTexture);
+    m_depthFbo = 0;
+    m_depthTexture = 0;
+    m_vao.destroy();
+    m_reduceProgram = nullptr; // ShaderCache 소유
+}
+
+void HiZPyramid::bindDepthTarget()
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, m_depthFbo);
+    glViewport(0, 0, m_width, m_height);
+    glDepthMask(GL_TRUE);
+    glClearDepthf(1.0f);
+    glClear(GL_DEPTH_BUFFER_BIT);
+}
+
+void HiZPyramid::build()
+{
+    if (!isValid()) return;
+
+    // 1. GPU: 깊이 텍스처 -> 단계 0 -> ... -> 마지막 단계
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_BLEND);
+    glDisable(GL_STENCIL_TEST);
+    m_reduceProgram->bind();
+    m_vao.bind();
+    glActiveTexture(GL_TEXTURE0);
+    GLuint source = m_depthTexture;
+    int sourceWidth = m_width, sourceHeight = m_height;
+    for (const GpuLevel &level : m_gpuLevels) {
+        glBindFramebuffer(GL_FRAMEBUFFER, level.fbo);
+        glViewport(0, 0, level.width, level.height);
+        glBindTexture(GL_TEXTURE_2D, source);
+        glUniform2i(m_sourceSizeLocation, sourceWidth, sourceHeight); // ivec2라 setUniformValue(QSize)(float)는 못 씀
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        source = level.texture;
+        sourceWidth = level.width;
+        sourceHeight = level.height;
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+    m_vao.release();
+    m_reduceProgram->release();
+
+    // 2. 마지막 GPU 단계만 읽어 옴 (GPU 단계가 없으면 깊이 텍스처 자체)
+    const CpuLevel &first = m_cpuLevels.front();
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    if (m_gpuLevels.empty()) {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, m_depthFbo);
+        glReadPixels(0, 0, first.width, first.height, GL_DEPTH_COMPONENT, GL_FLOAT, m_cpuDepth.data());
+    } else {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, m_gpuLevels.back().fbo);
+        glReadBuffer(GL_COLOR_ATTACHMENT0);
+        glReadPixels(0, 0, first.width, first.height, GL_RED, GL_FLOAT, m_cpuDepth.data());
+    }
+
+    // 3. CPU: 같은 규칙(2x2 최댓값, 올림 크기)으로 1x1까지
+    for (size_t k = 1; k < m_cpuLevels.size(); ++k) {
+        const CpuLevel &src = m_cpuLevels[k - 1];
+        const CpuLevel &dst = m_cpuLevels[k];
+        const float *in = m_cpuDepth.data() + src.offset;
+        float *out = m_cpuDepth.data() + dst.offset;
+        for (int y = 0; y < dst.height; ++y) {
+            const int y0 = 2 * y, y1 = std::min(2 * y + 1, src.height - 1);
+            for (int x = 0; x < dst.width; ++x) {
+                const int x0 = 2 * x, x1 = std::min(2 * x + 1, src.width - 1);
+                out[y * dst.width + x] = std::max(std::max(in[y0 * src.width + x0], in[y0 * src.width + x1]),
+                                                  std::max(in[y1 * src.width + x0], in[y1 * src.width + x1]));
+            }
+        }
+    }
+}
+
+bool HiZPyramid::isOccluded(float x0, float y0, float x1, float y1, float nearestDepth) const
+{
+    if (m_cpuLevels.empty() || nearestDepth <= 0.0f) return false;
+
+    // ndc -> 기준 해상도 픽셀 (화면 밖 부분은 보이지 않으므로 잘라냄)
+    const float px0 = std::max(0.0f, (x0 * 0.5f + 0.5f) * m_width);
+    const float px1 = std::min(float(m_width) - 1.0f, (x1 * 0.5f + 0.5f) * m_width);
+    const float py0 = std::max(0.0f, (y0 * 0.5f + 0.5f) * m_height);
+    const float py1 = std::min(float(m_height) - 1.0f, (y1 * 0.5f + 0.5f) * m_height);
+    if (px0 > px1 || py0 > py1) return false;
+
+    // 단계 k의 텍셀 하나 = 기준 픽셀 2^k x 2^k. 사각형이 2x2 텍셀 이하로 덮이는 가장 고운 단계를 고름
+    const int firstShift = int(m_gpuLevels.size());
+    for (size_t k = 0; k < m_cpuLevels.size(); ++k) {
+        const CpuLevel &level = m_cpuLevels[k];
+        const float texel = float(1 << (firstShift + int(k)));
+        const int tx0 = int(px0 / texel), tx1 = std::min(int(px1 / texel), level.width - 1);
+        const int ty0 = int(py0 / texel), ty1 = std::min(int(py1 / texel), level.height - 1);
+        if (tx1 - tx0 > 1 || ty1 - ty0 > 1) continue;
+
+        const float *depth = m_cpuDepth.data() + level.offset;
+        float farthest = 0.0f;
+        for (int y = ty0; y <= ty1; ++y) {
+            for (int x = tx0; x <= tx1; ++x) farthest = std::max(farthest, depth[y * level.width + x]);
+        }
+        return nearestDepth > farthest;
+    }
+    return false;
+}
@@ -0,0 +1,65 @@
+#ifndef HIZPYRAMID_H
+#define HIZPYRAMID_H
+
+#include <QOpenGLExtraFunctions>
+#include <QOpenGLShaderProgram>
+#include <QOpenGLVertexArrayObject>
+#include <vector>
+
+class ShaderCache;
+
+// 계층적 깊이(Hi-Z) 피라미드 (클러스터 가림 컬링용)
+//
+// 1. bindDepthTarget()으로 깊이 텍스처 FBO에 가리개를 그리고
+// 2. build()가 GPU에서 2x2 최댓값(가장 먼 깊이)으로 READBACK_WIDTH 이하까지 줄인 뒤 그 단계만 읽어 와
+//    CPU에서 1x1까지 나머지 단계를 만듭니다 (읽어 오는 양은 80x45 float 정도).
+// 3. isOccluded()는 화면 사각형이 2x2 텍셀 이하로 덮이는 단계를 골라 그 텍셀들의 최댓값과 비교합니다.
+//    사각형의 가장 가까운 깊이가 그보다 멀면 사각형 안 어디서나 가리개 뒤이므로 가려진 것입니다.
+// 리드백은 가리개 패스가 끝날 때까지 기다리므로 가리개는 적게 (가까운 클러스터만) 그리는 것이 좋습니다.
+// 모든 호출은 컨텍스트가 current인 상태에서.
+class HiZPyramid : protected QOpenGLExtraFunctions
+{
+public:
+    static const int READBACK_WIDTH = 80; // 이 폭 이하가 될 때까지 GPU에서 줄임
+
+    bool initialize(ShaderCache &cache, int width, int height);
+    void destroy();
+    bool isValid() const { return m_reduceProgram != nullptr && m_depthFbo != 0; }
+
+    // 깊이 타겟을 바인딩하고 지움 (뷰포트 = 피라미드 기준 크기). 색 타겟은 없음
+    void bindDepthTarget();
+    // 지금까지 그린 깊이로 피라미드를 만들고 CPU 단계를 갱신 (기본 프레임버퍼 바인딩은 호출한 쪽이 복구)
+    void build();
+
+    // ndc 사각형 [x0, x1] x [y0, y1] (-1 ~ 1)과 그 안에서 가장 가까운 창 깊이 (0 ~ 1)
+    bool isOccluded(float x0, float y0, float x1, float y1, float nearestDepth) const;
+
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+
+private:
+    struct GpuLevel {
+        GLuint texture = 0;
+        GLuint fbo = 0;
+        int width = 0;
+        int height = 0;
+    };
+    struct CpuLevel {
+        size_t offset = 0; // m_cpuDepth 안의 시작 위치
+        int width = 0;
+        int height = 0;
+    };
+
+    QOpenGLShaderProgram *m_reduceProgram = nullptr; // ShaderCache 소유
+    int m_sourceSizeLocation = -1;
+    QOpenGLVertexArrayObject m_vao;                  // 전체 화면 삼각형 (정점은 gl_VertexID로)
+    GLuint m_depthTexture = 0;
+    GLuint m_depthFbo = 0;
+    int m_width = 0;
+    int m_height = 0;
+    std::vector<GpuLevel> m_gpuLevels;
+    std::vector<CpuLevel> m_cpuLevels;
+    std::vector<float> m_cpuDepth; // 모든 CPU 단계를 이어 붙임 (크기는 initialize에서 고정)
+};
+
+#endif // HIZPYRAMID_H
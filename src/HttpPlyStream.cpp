@@ -0,0 +1,280 @@
+#include "HttpPlyStream.h"
+#include "SplatScene.h"
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QTimer>
+#include <QDebug>
+#include <algorithm>
+
+HttpPlyStream::HttpPlyStream(QObject *parent)
+    : QObject(parent)
+{
+}
+
+HttpPlyStream::~HttpPlyStream()
+{
+    abort();
+}
+
+bool HttpPlyStream::start(const QUrl &url)
+{
+    abort();
+    if (!url.isValid() || (url.scheme() != "http" && url.scheme() != "https")) {
+        qWarning() << "HTTP stream: not an http(s) URL:" << url.toString();
+        return false;
+    }
+
+    m_url = url;
+    m_active = true;
+    ++m_generation;
+    m_header = PlyLoader::Header();
+    m_totalBytes = 0;
+    m_splatsPerChunk = 0;
+    m_chunkCount = 0;
+    m_nextChunk = 0;
+    m_chunksDone = 0;
+    m_retryQueue.clear();
+    m_inFlightBytes = 0;
+    m_bytesReceived = 0;
+    m_retries = 0;
+    m_peakInFlightBytes = 0;
+    m_firstChunkMs = 0.0;
+    m_finishedMs = -1.0;
+    m_timer.start();
+
+    Range header;
+    header.first = 0;
+    header.last = std::max<qint64>(m_options.headerProbeBytes, 1024) - 1;
+    request(header);
+    return true;
+}
+
+void HttpPlyStream::abort()
+{
+    if (!m_active) return;
+    m_active = false;
+    ++m_generation;
+    dropReplies();
+    m_retryQueue.clear();
+}
+
+void HttpPlyStream::dropReplies()
+{
+    // abort()는 finished를 바로 내보내므로 먼저 연결을 끊음
+    for (Pending &pending : m_pending) {
+        pending.reply->disconnect(this);
+        pending.reply->abort();
+        pending.reply->deleteLater();
+    }
+    m_pending.clear();
+    m_inFlightBytes = 0;
+}
+
+HttpPlyStream::Range HttpPlyStream::chunkRange(int chunk) const
+{
+    const qint64 stride = qint64(PlyLoader::FLOATS_PER_VERTEX) * sizeof(float);
+    const qint64 firstSplat = qint64(chunk) * m_splatsPerChunk;
+    const qint64 count = std::min(m_splatsPerChunk, m_header.vertexCount - firstSplat);
+
+    Range range;
+    range.first = m_header.dataOffset + firstSplat * stride;
+    range.last = range.first + count * stride - 1;
+    range.chunk = chunk;
+    return range;
+}
+
+void HttpPlyStream::request(const Range &range)
+{
+    QNetworkRequest request(m_url);
+    request.setRawHeader("Range", QString("bytes=%1-%2").arg(range.first).arg(range.last).toLatin1());
+    request.setTransferTimeout(m_options.transferTimeoutMs);
+
+    QNetworkReply *reply = m_network.get(request);
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() { onReplyFinished(reply); });
+
+    m_pending.push_back({ reply, range });
+    m_inFlightBytes += range.bytes();
+    m_peakInFlightBytes = std::max(m_peakInFlightBytes, m_inFlightBytes);
+}
+
+void HttpPlyStream::pump()
+{
+    while (m_active && int(m_pending.size()) < m_options.maxInFlight) {
+        if (!m_retryQueue.empty()) {
+            request(m_retryQueue.front());
+            m_retryQueue.pop_front();
+        } else if (m_nextChunk < m_chunkCount) {
+            request(chunkRange(m_nextChunk++));
+        } else {
+            break;
+        }
+    }
+}
+
+void HttpPlyStream::onReplyFinished(QNetworkReply *reply)
+{
+    auto it = std::find_if(m_pending.begin(), m_pending.end(),
+                           [reply](const Pending &pending) { return pending.reply == reply; });
+    if (it == m_pending.end()) return;
+    const Range range = it->range;
+    m_pending.erase(it);
+    m_inFlightBytes -= range.bytes();
+    reply->deleteLater();
+    if (!m_active) return;
+
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (status == 200) {
+        fail("server ignored the Range header (HTTP 200)");
+        return;
+    }
+    if (status >= 400 && status < 500) {
+        fail(QString("HTTP %1 %2").arg(status).arg(reply->errorString()));
+        return;
+    }
+    if (reply->error() != QNetworkReply::NoError) {
+        retry(range, reply->errorString());
+        return;
+    }
+    if (status != 206) {
+        retry(range, QString("unexpected HTTP %1").arg(status));
+        return;
+    }
+
+    const QByteArray data = reply->readAll();
+    if (range.chunk < 0) {
+        QString error;
+        if (!handleHeader(reply, data, error)) {
+            fail(error);
+            return;
+        }
+        if (!m_active) return; // 신호 처리 중에 취소됨
+    } else {
+        if (data.size() != range.bytes()) {
+            retry(range, QString("short read (%1 of %2 bytes)").arg(data.size()).arg(range.bytes()));
+            return;
+        }
+        handleChunk(range, data);
+        if (!m_active) return; // 신호 처리 중에 취소됨
+    }
+
+    if (m_chunksDone == m_chunkCount) {
+        m_active = false;
+        m_finishedMs = m_timer.nsecsElapsed() / 1.0e6;
+        qDebug().noquote() << "HTTP stream finished:" << m_url.toString() << "-" << statsString();
+        emit finished(true, QString());
+        return;
+    }
+    pump();
+}
+
+bool HttpPlyStream::handleHeader(QNetworkReply *reply, const QByteArray &data, QString &error)
+{
+    // "bytes 0-65535/123456789"
+    const QByteArray contentRange = reply->rawHeader("Content-Range");
+    const qsizetype slash = contentRange.lastIndexOf('/');
+    bool totalOk = false;
+    if (slash >= 0) m_totalBytes = contentRange.mid(slash + 1).trimmed().toLongLong(&totalOk);
+    if (!totalOk) {
+        error = "missing file size in Content-Range";
+        return false;
+    }
+
+    if (!PlyLoader::parseHeader(data, m_header)) {
+        error = "PLY header not found in the first " + QString::number(data.size()) + " bytes";
+        return false;
+    }
+    if (!PlyLoader::checkHeader(m_header, error)) return false;
+
+    const qint64 maxVertices = std::min<qint64>(m_options.maxVertices, SplatRef::INDEX_MASK);
+    if (m_header.vertexCount <= 0 || m_header.vertexCount > maxVertices) {
+        error = QString("unsupported vertex count %1 (limit %2)").arg(m_header.vertexCount).arg(maxVertices);
+        return false;
+    }
+
+    const qint64 stride = qint64(PlyLoader::FLOATS_PER_VERTEX) * sizeof(float);
+    if (m_header.dataOffset + m_header.vertexCount * stride > m_totalBytes) {
+        error = QString("file is truncated (%1 bytes for %2 vertices)").arg(m_totalBytes).arg(m_header.vertexCount);
+        return false;
+    }
+
+    m_splatsPerChunk = std::max<qint64>(1, m_options.chunkBytes / stride);
+    m_chunkCount = int((m_header.vertexCount + m_splatsPerChunk - 1) / m_splatsPerChunk);
+
+    emit headerReady(m_header.vertexCount);
+    return true;
+}
+
+void HttpPlyStream::handleChunk(const Range &range, const QByteArray &data)
+{
+    const qint64 firstSplat = qint64(range.chunk) * m_splatsPerChunk;
+    std::vector<RenderSplat> splats(size_t(range.bytes() / (PlyLoader::FLOATS_PER_VERTEX * sizeof(float))));
+    PlyLoader::decodeVertices(reinterpret_cast<const float *>(data.constData()), splats.size(), splats.data());
+
+    m_bytesReceived += data.size();
+    if (m_chunksDone++ == 0) m_firstChunkMs = m_timer.nsecsElapsed() / 1.0e6;
+    emit chunkReady(firstSplat, splats);
+}
+
+void HttpPlyStream::retry(Range range, const QString &reason)
+{
+    if (range.attempt >= m_options.maxRetries) {
+        fail(QString("range %1-%2 failed after %3 attempts: %4")
+                 .arg(range.first).arg(range.last).arg(range.attempt + 1).arg(reason));
+        return;
+    }
+
+    const int delayMs = m_options.retryDelayMs << range.attempt;
+    ++range.attempt;
+    ++m_retries;
+
+    // 대기 중에는 자리를 차지하지 않으므로 다른 구간을 먼저 받음
+    const quint64 generation = m_generation;
+    QTimer::singleShot(delayMs, this, [this, range, generation]() {
+        if (generation != m_generation || !m_active) return;
+        m_retryQueue.push_back(range);
+        pump();
+    });
+    pump();
+}
+
+void HttpPlyStream::fail(const QString &error)
+{
+    m_active = false;
+    ++m_generation;
+    dropReplies();
+    m_retryQueue.clear();
+    m_finishedMs = m_timer.nsecsElapsed() / 1.0e6;
+    qWarning().noquote() << "HTTP stream failed:" << m_url.toString() << "-" << error;
+    emit finished(false, error);
+}
+
+HttpPlyStream::Stats HttpPlyStream::stats() const
+{
+    Stats stats;
+    stats.totalBytes = m_totalBytes;
+    stats.bytesReceived = m_bytesReceived;
+    stats.chunkCount = m_chunkCount;
+    stats.chunksDone = m_chunksDone;
+    stats.inFlight = int(m_pending.size());
+    stats.retries = m_retries;
+    stats.peakInFlightBytes = m_peakInFlightBytes;
+    stats.elapsedMs = m_finishedMs >= 0.0 ? m_finishedMs : (m_timer.isValid() ? m_timer.nsecsElapsed() / 1.0e6 : 0.0);
+    stats.firstChunkMs = m_firstChunkMs;
+    return stats;
+}
+
+QString HttpPlyStream::statsString() const
+{
+    const Stats s = stats();
+    return QString("%1 / %2 MB in %3 s (%4 MB/s), chunks %5 / %6, first chunk %7 ms, "
+                   "retries %8, peak in flight %9 MB")
+        .arg(s.bytesReceived / (1024.0 * 1024.0), 0, 'f', 1)
+        .arg(s.totalBytes / (1024.0 * 1024.0), 0, 'f', 1)
+        .arg(s.elapsedMs / 1000.0, 0, 'f', 2)
+        .arg(s.mbps(), 0, 'f', 1)
+        .arg(s.chunksDone)
+        .arg(s.chunkCount)
+        .arg(s.firstChunkMs, 0, 'f', 0)
+        .arg(s.retries)
+        .arg(s.peakInFlightBytes / (1024.0 * 1024.0), 0, 'f', 1);
+}
@@ -0,0 +1,126 @@
+#ifndef HTTPPLYSTREAM_H
+#define HTTPPLYSTREAM_H
+
+#include <QObject>
+#include <QUrl>
+#include <QElapsedTimer>
+#include <QNetworkAccessManager>
+#include <deque>
+#include <vector>
+#include "GaussianData.h"
+#include "PlyLoader.h"
+
+class QNetworkReply;
+
+// HTTP Range 요청으로 표준 3DGS PLY를 받으면서 바로 디코딩하는 로더
+//
+// 1. 앞부분 headerProbeBytes를 받아 헤더를 해석 (Content-Range로 전체 크기 확인)
+// 2. 본문을 정점 경계에 맞춘 chunkBytes 단위 구간으로 나눠 maxInFlight개까지 동시에 요청
+// 3. 구간이 도착하는 대로 (순서와 무관하게) RenderSplat으로 디코딩해 chunkReady로 넘기고 버퍼는 바로 해제
+//    -> 응답 버퍼 메모리는 최대 maxInFlight * chunkBytes
+// 4. 네트워크 오류/5xx/짧은 응답은 retryDelayMs * 2^시도 뒤 다시 요청 (maxRetries번까지)
+//
+// 서버가 Range를 무시하고 200으로 전체를 보내면 실패로 처리합니다 (부분 요청이 목적이므로).
+// 모든 신호는 GUI 스레드 이벤트 루프에서 나옵니다.
+class HttpPlyStream : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Options {
+        qint64 headerProbeBytes = 64 * 1024;
+        qint64 chunkBytes = 4 * 1024 * 1024; // 정점 크기(248바이트)의 배수로 내림
+        int maxInFlight = 4;
+        int maxRetries = 4;
+        int retryDelayMs = 250;
+        int transferTimeoutMs = 15000; // 이 시간 동안 데이터가 없으면 오류 (재시도 대상)
+        // 헤더가 선언한 정점 수의 상한 (받는 쪽이 이 크기로 씬 버퍼를 바로 잡으므로 서버 값을 그대로 믿지 않음)
+        // SplatRef 인덱스 범위(INDEX_MASK)도 항상 함께 적용
+        qint64 maxVertices = 64 * 1024 * 1024;
+    };
+
+    struct Stats {
+        qint64 totalBytes = 0;     // 파일 전체 (Content-Range)
+        qint64 bytesReceived = 0;  // 받은 본문 (헤더 요청 제외, 재시도로 버린 것 제외)
+        int chunkCount = 0;
+        int chunksDone = 0;
+        int inFlight = 0;
+        int retries = 0;
+        qint64 peakInFlightBytes = 0;
+        double elapsedMs = 0.0;
+        double firstChunkMs = 0.0; // 시작 -> 첫 구간 디코딩 완료 (첫 화면까지의 시간)
+        double mbps() const { return elapsedMs > 0.0 ? bytesReceived / (1024.0 * 1024.0) / (elapsedMs / 1000.0) : 0.0; }
+    };
+
+    explicit HttpPlyStream(QObject *parent = nullptr);
+    ~HttpPlyStream() override;
+
+    void setOptions(const Options &options) { m_options = options; }
+    const Options &options() const { return m_options; }
+
+    // 진행 중인 로드가 있으면 취소하고 새로 시작. URL이 http(s)가 아니면 false
+    bool start(const QUrl &url);
+    void abort(); // 신호 없이 조용히 취소
+
+    bool isActive() const { return m_active; }
+    const QUrl &url() const { return m_url; }
+    qint64 vertexCount() const { return m_header.vertexCount; }
+    Stats stats() const;
+    QString statsString() const;
+
+signals:
+    void headerReady(qint64 vertexCount);
+    // firstSplat부터 splats.size()개 (신호 처리 중에만 유효)
+    void chunkReady(qint64 firstSplat, const std::vector<RenderSplat> &splats);
+    void finished(bool ok, const QString &error);
+
+private:
+    // 요청 하나 = 파일의 [first, last] 바이트 (chunk < 0이면 헤더 요청)
+    struct Range {
+        qint64 first = 0;
+        qint64 last = 0;
+        int chunk = -1;
+        int attempt = 0;
+        qint64 bytes() const { return last - first + 1; }
+    };
+    struct Pending {
+        QNetworkReply *reply;
+        Range range;
+    };
+
+    void request(const Range &range);
+    void onReplyFinished(QNetworkReply *reply);
+    bool handleHeader(QNetworkReply *reply, const QByteArray &data, QString &error);
+    void handleChunk(const Range &range, const QByteArray &data);
+    void retry(Range range, const QString &reason);
+    void pump(); // 빈 자리만큼 다음 구간 요청
+    void fail(const QString &error);
+    void dropReplies();
+
+    Range chunkRange(int chunk) const;
+
+    QNetworkAccessManager m_network;
+    Options m_options;
+    QUrl m_url;
+    bool m_active = false;
+    quint64 m_generation = 0; // 재시도 타이머가 취소된 로드를 건드리지 않도록
+
+    PlyLoader::Header m_header;
+    qint64 m_totalBytes = 0;
+    qint64 m_splatsPerChunk = 0;
+    int m_chunkCount = 0;
+    int m_nextChunk = 0;
+    int m_chunksDone = 0;
+    std::deque<Range> m_retryQueue; // 대기가 끝난 재시도 (새 구간보다 먼저)
+    std::vector<Pending> m_pending;
+    qint64 m_inFlightBytes = 0;
+
+    QElapsedTimer m_timer;
+    qint64 m_bytesReceived = 0;
+    int m_retries = 0;
+    qint64 m_peakInFlightBytes = 0;
+    double m_firstChunkMs = 0.0;
+    double m_finishedMs = -1.0;
+};
+
+#endif // HTTPPLYSTREAM_H
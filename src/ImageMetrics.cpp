@@ -0,0 +1,93 @@
+#include "ImageMetrics.h"
+#include <QDebug>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+QString ImageDiff::toString() const
+{
+    if (!valid) return QString("invalid comparison");
+
+    return QString("PSNR=%1dB RMSE=%2 meanAbs=%3 maxAbs=%4 bad=%5%")
+        .arg(psnr, 0, 'f', 2)
+        .arg(rmse, 0, 'f', 3)
+        .arg(meanAbsDiff, 0, 'f', 3)
+        .arg(maxAbsDiff)
+        .arg(badPixelRatio * 100.0, 0, 'f', 2);
+}
+
+ImageDiff ImageMetrics::compare(const QImage &a, const QImage &b, int threshold)
+{
+    ImageDiff diff;
+    if (a.isNull() || b.isNull() || a.size() != b.size()) {
+        qWarning() << "ImageMetrics::compare: size mismatch";
+        return diff;
+    }
+
+    QImage ia = a.convertToFormat(QImage::Format_RGBA8888);
+    QImage ib = b.convertToFormat(QImage::Format_RGBA8888);
+
+    double sumSq = 0.0;
+    double sumAbs = 0.0;
+    qint64 badPixels = 0;
+    int maxAbs = 0;
+
+    for (int y = 0; y < ia.height(); ++y) {
+        const uchar *pa = ia.constScanLine(y);
+        const uchar *pb = ib.constScanLine(y);
+        for (int x = 0; x < ia.width(); ++x) {
+            bool bad = false;
+            // 알파는 모드마다 의미가 달라 RGB만 비교
+            for (int c = 0; c < 3; ++c) {
+                int d = std::abs(int(pa[x * 4 + c]) - int(pb[x * 4 + c]));
+                sumSq += double(d) * d;
+                sumAbs += d;
+                maxAbs = std::max(maxAbs, d);
+                if (d > threshold) bad = true;
+            }
+            if (bad) badPixels++;
+        }
+    }
+
+    const double pixelCount = double(ia.width()) * ia.height();
+    const double sampleCount = pixelCount * 3.0;
+    double mse = sumSq / sampleCount;
+
+    diff.valid = true;
+    diff.rmse = std::sqrt(mse);
+    diff.psnr = mse > 0.0 ? 10.0 * std::log10(255.0 * 255.0 / mse) : 99.0;
+    diff.meanAbsDiff = sumAbs / sampleCount;
+    diff.maxAbsDiff = maxAbs;
+    diff.badPixelRatio = badPixels / pixelCount;
+    return diff;
+}
+
+QImage ImageMetrics::sideBySide(const QImage &a, const QImage &b, int diffGain)
+{
+    if (a.isNull() || b.isNull() || a.size() != b.size()) return QImage();
+
+    QImage ia = a.convertToFormat(QImage::Format_RGBA8888);
+    QImage ib = b.convertToFormat(QImage::Format_RGBA8888);
+
+    const int w = ia.width();
+    const int h = ia.height();
+    QImage out(w * 3, h, QImage::Format_RGBA8888);
+
+    for (int y = 0; y < h; ++y) {
+        const uchar *pa = ia.constScanLine(y);
+        const uchar *pb = ib.constScanLine(y);
+        uchar *po = out.scanLine(y);
+        for (int x = 0; x < w; ++x) {
+            for (int c = 0; c < 3; ++c) {
+                int d = std::abs(int(pa[x * 4 + c]) - int(pb[x * 4 + c])) * diffGain;
+                po[x * 4 + c] = pa[x * 4 + c];
+                po[(w + x) * 4 + c] = pb[x * 4 + c];
+                po[(2 * w + x) * 4 + c] = uchar(std::min(d, 255));
+            }
+            po[x * 4 + 3] = 255;
+            po[(w + x) * 4 + 3] = 255;
+            po[(2 * w + x) * 4 + 3] = 255;
+        }
+    }
+    return out;
+}
@@ -0,0 +1,28 @@
+#ifndef IMAGEMETRICS_H
+#define IMAGEMETRICS_H
+
+#include <QImage>
+#include <QString>
+
+// 두 렌더 결과 사이의 차이 (RGB 채널, 0~255 기준)
+struct ImageDiff {
+    bool valid = false;
+    double rmse = 0.0;          // Root Mean Square Error
+    double psnr = 0.0;          // dB (완전히 같으면 무한대 대신 99로 표기)
+    double meanAbsDiff = 0.0;
+    int maxAbsDiff = 0;
+    double badPixelRatio = 0.0; // 채널 차이가 threshold를 넘는 픽셀 비율
+
+    QString toString() const;
+};
+
+namespace ImageMetrics
+{
+    // 크기가 같은 두 이미지 비교. threshold는 badPixelRatio 기준값
+    ImageDiff compare(const QImage &a, const QImage &b, int threshold = 8);
+
+    // [A | B | |A-B| * gain] 형태로 나란히 붙인 비교 이미지
+    QImage sideBySide(const QImage &a, const QImage &b, int diffGain = 4);
+}
+
+#endif // IMAGEMETRICS_H
@@ -1,6 +1,7 @@
 #include "MainWindow.h"
 #include "SplattingWidget.h"
-#include "PlyLoader.h"
+#include "SplatFileLoader.h"
+#include "ChunkedScene.h"
 #include <QFile>
 #include <QDataStream>
 #include <QtMath>
@@ -8,13 +9,22 @@
 #include <QMenu>
 #include <QAction>
 #include <QFileDialog>
+#include <QInputDialog>
+#include <QUrl>
 #include <QDockWidget>
 #include <QVBoxLayout>
 #include <QLabel>
 #include <QSlider>
 #include <QGroupBox>
 #include <QCheckBox>
+#include <QComboBox>
+#include <QListWidget>
+#include <QDoubleSpinBox>
+#include <QSpinBox>
+#include <QFormLayout>
+#include <QFileInfo>
 #include <QDebug>
+#include <algorithm>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
@@ -30,8 +40,45 @@ MainWindow::MainWindow(QWidget *parent)
 
     // 2. 메뉴바 설정
     QMenu *fileMenu = menuBar()->addMenu("File");
-    QAction *openAction = fileMenu->addAction("Open .ply");
+    QAction *openAction = fileMenu->addAction("Open Splat File (.ply/.splat/.spz)...");
     connect(openAction, &QAction::triggered, this, &MainWindow::onOpenActionTriggered);
+    QAction *addSceneAction = fileMenu->addAction("Add Splat File as Scene...");
+    connect(addSceneAction, &QAction::triggered, this, &MainWindow::onAddSceneTriggered);
+    QAction *openStreamedAction = fileMenu->addAction("Open Chunked Scene (Streaming)...");
+    connect(openStreamedAction, &QAction::triggered, this, &MainWindow::onOpenStreamedTriggered);
+    QAction *openRemoteAction = fileMenu->addAction("Open PLY URL (HTTP Range Streaming)...");
+    connect(openRemoteAction, &QAction::triggered, this, &MainWindow::onOpenRemoteTriggered);
+
+    // 카메라 경로 기록/재생 (성능 비교용)
+    QMenu *cameraMenu = menuBar()->addMenu("Camera");
+    QAction *recordAction = cameraMenu->addAction("Record Camera Path");
+    recordAction->setCheckable(true);
+    connect(recordAction, &QAction::toggled, this, &MainWindow::onRecordCameraToggled);
+    QAction *playAction = cameraMenu->addAction("Play Camera Path...");
+    connect(playAction, &QAction::triggered, this, &MainWindow::onPlayCameraPathTriggered);
+
+    // 품질/성능 비교 도구
+    QMenu *toolsMenu = menuBar()->addMenu("Tools");
+    QAction *compareOitAction = toolsMenu->addAction("Compare OIT vs Sorted...");
+    connect(compareOitAction, &QAction::triggered, this, &MainWindow::onCompareOitTriggered);
+    QAction *compareTemporalAction = toolsMenu->addAction("Compare Temporal Upscale vs RCAS...");
+    connect(compareTemporalAction, &QAction::triggered, this, &MainWindow::onCompareTemporalTriggered);
+    QAction *compareFrontToBackAction = toolsMenu->addAction("Compare Front-to-Back vs Back-to-Front...");
+    connect(compareFrontToBackAction, &QAction::triggered, this, &MainWindow::onCompareFrontToBackTriggered);
+    QAction *compareDepthPrepassAction = toolsMenu->addAction("Compare Depth Pre-pass On vs Off...");
+    connect(compareDepthPrepassAction, &QAction::triggered, this, &MainWindow::onCompareDepthPrepassTriggered);
+    QAction *checkOcclusionAction = toolsMenu->addAction("Check Occlusion Culling (Off-Axis Views)...");
+    connect(checkOcclusionAction, &QAction::triggered, this, &MainWindow::onCheckOcclusionCullingTriggered);
+    QAction *pickLatencyAction = toolsMenu->addAction("Measure Pick Latency");
+    connect(pickLatencyAction, &QAction::triggered, this, &MainWindow::onMeasurePickLatencyTriggered);
+    QAction *mortonBenchAction = toolsMenu->addAction("Benchmark Morton Order...");
+    connect(mortonBenchAction, &QAction::triggered, this, &MainWindow::onBenchmarkSpatialOrderTriggered);
+    QAction *loadBenchAction = toolsMenu->addAction("Benchmark Load Formats...");
+    connect(loadBenchAction, &QAction::triggered, this, &MainWindow::onBenchmarkLoadFormatsTriggered);
+    QAction *exportSplatAction = toolsMenu->addAction("Export Scene as .splat...");
+    connect(exportSplatAction, &QAction::triggered, this, &MainWindow::onExportSplatTriggered);
+    QAction *buildChunkedAction = toolsMenu->addAction("Build Chunked Scene...");
+    connect(buildChunkedAction, &QAction::triggered, this, &MainWindow::onBuildChunkedSceneTriggered);
 
     // 3. [핵심] 제어 패널 (Control Panel) 추가
     QDockWidget *dock = new QDockWidget("Rendering Controls", this);
@@ -81,12 +128,82 @@ MainWindow::MainWindow(QWidget *parent)
     QCheckBox *fsrCheck = new QCheckBox("Use FSR");
     fsrCheck->setChecked(true); // 기본은 부드럽게
     fsrLayout->addWidget(fsrCheck);
+    QCheckBox *temporalCheck = new QCheckBox("Temporal Upscale (jittered history)");
+    temporalCheck->setChecked(false);
+    fsrLayout->addWidget(temporalCheck);
     layout->addWidget(fsrGroup); // 레이아웃에 추가
 
+    // (6) Render Mode (합성 방식)
+    QGroupBox *modeGroup = new QGroupBox("Render Mode");
+    QVBoxLayout *modeLayout = new QVBoxLayout(modeGroup);
+    QComboBox *modeCombo = new QComboBox();
+    modeCombo->addItem("Sorted (Back-to-Front)", static_cast<int>(RenderMode::Sorted));
+    modeCombo->addItem("Sorted (Front-to-Back, early termination)", static_cast<int>(RenderMode::FrontToBack));
+    modeCombo->addItem("Weighted Blended OIT", static_cast<int>(RenderMode::WeightedOIT));
+    modeCombo->addItem("Overdraw Heatmap (debug)", static_cast<int>(RenderMode::OverdrawHeatmap));
+    modeLayout->addWidget(modeCombo);
+    QSpinBox *heatmapRange = new QSpinBox();
+    heatmapRange->setRange(1, 1024);
+    heatmapRange->setPrefix("Heatmap max ");
+    heatmapRange->setValue(32);
+    modeLayout->addWidget(heatmapRange);
+    QCheckBox *depthPrepassCheck = new QCheckBox("Depth Pre-pass (opaque cores)");
+    depthPrepassCheck->setChecked(false);
+    modeLayout->addWidget(depthPrepassCheck);
+    QSlider *coreAlphaSlider = new QSlider(Qt::Horizontal);
+    coreAlphaSlider->setRange(50, 99); // 코어 불투명도 0.50 ~ 0.99
+    coreAlphaSlider->setValue(90);     // Default 0.90
+    coreAlphaSlider->setToolTip("Core alpha threshold of the depth pre-pass and occlusion culling");
+    modeLayout->addWidget(coreAlphaSlider);
+    QCheckBox *occlusionCullingCheck = new QCheckBox("Cluster Occlusion Culling (Hi-Z)");
+    occlusionCullingCheck->setChecked(false);
+    modeLayout->addWidget(occlusionCullingCheck);
+    QComboBox *viewLayoutCombo = new QComboBox();
+    viewLayoutCombo->addItem("Single View", static_cast<int>(ViewLayout::Single));
+    viewLayoutCombo->addItem("Stereo (side by side)", static_cast<int>(ViewLayout::Stereo));
+    viewLayoutCombo->addItem("Four-up Orbit", static_cast<int>(ViewLayout::QuadOrbit));
+    modeLayout->addWidget(viewLayoutCombo);
+    QCheckBox *fragmentStatsCheck = new QCheckBox("Show Fragment Counts");
+    fragmentStatsCheck->setChecked(false);
+    modeLayout->addWidget(fragmentStatsCheck);
+    QCheckBox *progressiveCheck = new QCheckBox("Progressive Refinement");
+    progressiveCheck->setChecked(false);
+    modeLayout->addWidget(progressiveCheck);
+    QSpinBox *frameTarget = new QSpinBox();
+    frameTarget->setRange(2, 100);
+    frameTarget->setPrefix("Interactive target ");
+    frameTarget->setSuffix(" ms");
+    frameTarget->setValue(12);
+    modeLayout->addWidget(frameTarget);
+    QCheckBox *latencyCheck = new QCheckBox("Measure Input Latency");
+    latencyCheck->setChecked(false);
+    modeLayout->addWidget(latencyCheck);
+    QCheckBox *lateStartCheck = new QCheckBox("Late Frame Start (sample input near vblank)");
+    lateStartCheck->setChecked(false);
+    modeLayout->addWidget(lateStartCheck);
+    layout->addWidget(modeGroup);
+
+    // (7) Streaming Budget (다음에 여는 청크 씬부터 적용)
+    QGroupBox *streamGroup = new QGroupBox("Streaming Budget");
+    QFormLayout *streamLayout = new QFormLayout(streamGroup);
+    m_streamCpuBudget = new QSpinBox();
+    m_streamCpuBudget->setRange(64, 65536);
+    m_streamCpuBudget->setSuffix(" MB");
+    m_streamCpuBudget->setValue(1024);
+    m_streamGpuBudget = new QSpinBox();
+    m_streamGpuBudget->setRange(16, 16384);
+    m_streamGpuBudget->setSuffix(" MB");
+    m_streamGpuBudget->setValue(512);
+    streamLayout->addRow("CPU", m_streamCpuBudget);
+    streamLayout->addRow("GPU", m_streamGpuBudget);
+    layout->addWidget(streamGroup);
+
     layout->addStretch(); // 나머지 공간 채우기
     dock->setWidget(panel);
     addDockWidget(Qt::RightDockWidgetArea, dock);
 
+    createSceneDock();
+
     // 4. 슬라이더 이벤트 연결
     connect(scaleSlider, &QSlider::valueChanged, [this](int value){
         float scale = value / 100.0f;
@@ -113,6 +230,64 @@ MainWindow::MainWindow(QWidget *parent)
         m_splatWidget->setUseFSR(checked);
     });
 
+    connect(temporalCheck, &QCheckBox::toggled, [this](bool checked){
+        // 켜면 FSR/Blit 대신 히스토리 누적 결과를 출력
+        m_splatWidget->setTemporalUpscale(checked);
+    });
+
+    connect(modeCombo, &QComboBox::currentIndexChanged, [this, modeCombo](int index){
+        m_splatWidget->setRenderMode(static_cast<RenderMode>(modeCombo->itemData(index).toInt()));
+    });
+
+    connect(viewLayoutCombo, &QComboBox::currentIndexChanged, [this, viewLayoutCombo, temporalCheck](int index){
+        const ViewLayout layout = static_cast<ViewLayout>(viewLayoutCombo->itemData(index).toInt());
+        // 다중 뷰에서는 시간적 업스케일을 쓸 수 없음 (위젯이 끄므로 체크박스도 맞춤)
+        if (layout != ViewLayout::Single) temporalCheck->setChecked(false);
+        temporalCheck->setEnabled(layout == ViewLayout::Single);
+        m_splatWidget->setViewLayout(layout);
+    });
+
+    connect(heatmapRange, &QSpinBox::valueChanged, [this](int value){
+        m_splatWidget->setHeatmapRange(value);
+    });
+
+    connect(depthPrepassCheck, &QCheckBox::toggled, [this](bool checked){
+        // 불투명 코어로 깊이를 먼저 채워 가려진 스플랫 프래그먼트를 블렌딩 전에 버림
+        m_splatWidget->setDepthPrepass(checked);
+    });
+
+    connect(coreAlphaSlider, &QSlider::valueChanged, [this](int value){
+        m_splatWidget->setDepthPrepassThreshold(value / 100.0f);
+    });
+
+    connect(occlusionCullingCheck, &QCheckBox::toggled, [this](bool checked){
+        // 가까운 클러스터의 코어 깊이로 Hi-Z를 만들어 그 뒤에 숨은 클러스터를 정렬/그리기에서 뺌
+        m_splatWidget->setOcclusionCulling(checked);
+    });
+
+    connect(fragmentStatsCheck, &QCheckBox::toggled, [this](bool checked){
+        // 스플랫 드로우를 GPU 쿼리로 감싸 셰이더 실행 수/통과 수를 오버레이에 표시
+        m_splatWidget->setFragmentStats(checked);
+    });
+
+    connect(progressiveCheck, &QCheckBox::toggled, [this](bool checked){
+        // 카메라 조작 중에는 중요도 상위 일부만, 멈추면 몇 프레임에 걸쳐 전체를 그림
+        m_splatWidget->setProgressiveRefinement(checked);
+    });
+
+    connect(frameTarget, &QSpinBox::valueChanged, [this](int value){
+        m_splatWidget->setInteractiveFrameTarget(float(value));
+    });
+
+    connect(latencyCheck, &QCheckBox::toggled, [this](bool checked){
+        // 입력 이벤트마다 정렬/그리기/스왑 구간 지연을 모아 오버레이에 히스토그램 표시 (끌 때 요약 출력)
+        m_splatWidget->setLatencyMeasurement(checked);
+    });
+
+    connect(lateStartCheck, &QCheckBox::toggled, [this](bool checked){
+        m_splatWidget->setLateFrameStart(checked);
+    });
+
     // 샘플 ply 파일 만들기 위한 코드
     //createDummyPly("d:/test_cube.ply");
 }
@@ -175,24 +350,299 @@ void MainWindow::createDummyPly(const QString& filename)
 
 void MainWindow::onOpenActionTriggered()
 {
-    QString fileName = QFileDialog::getOpenFileName(this, "Open Gaussian Splatting PLY", "", "PLY Files (*.ply)");
+    QString fileName = QFileDialog::getOpenFileName(this, "Open Gaussian Splatting File", "", SplatFileLoader::fileDialogFilter());
+
+    if (!fileName.isEmpty()) loadSceneFile(fileName);
+}
+
+bool MainWindow::loadSceneFile(const QString &fileName)
+{
+    SplatFileLoader loader;
+    std::vector<RenderSplat> splats;
+    ShPalette sh;
+
+    // 로딩 시작 로그
+    qDebug() << "Start loading" << SplatFileLoader::formatName(SplatFileLoader::detectFormat(fileName)) << "...";
+
+    if (!loader.load(fileName, splats, &sh)) {
+        qCritical() << "Failed to load splat file.";
+        return false;
+    }
+    qDebug() << "Loaded" << splats.size() << "points. Uploading to GPU...";
+
+    // [연결] 위젯에 데이터 전달
+    m_splatWidget->loadData(splats, &sh);
+
+    m_sceneList->clear();
+    QListWidgetItem *item = new QListWidgetItem(QFileInfo(fileName).fileName(), m_sceneList);
+    item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+    item->setCheckState(Qt::Checked);
+    m_sceneList->setCurrentRow(0);
+
+    qDebug() << "Upload Complete!";
+    return true;
+}
 
+void MainWindow::onRecordCameraToggled(bool checked)
+{
+    if (checked) {
+        m_splatWidget->startCameraRecording();
+        return;
+    }
+
+    CameraPath path = m_splatWidget->stopCameraRecording();
+    if (path.isEmpty()) return;
+
+    QString fileName = QFileDialog::getSaveFileName(this, "Save Camera Path", "", "Camera Path (*.campath)");
     if (!fileName.isEmpty()) {
-        PlyLoader loader;
-        std::vector<RenderSplat> splats;
+        path.save(fileName);
+    }
+}
 
-        // 로딩 시작 로그
-        qDebug() << "Start loading PLY...";
+void MainWindow::onPlayCameraPathTriggered()
+{
+    QString fileName = QFileDialog::getOpenFileName(this, "Open Camera Path", "", "Camera Path (*.campath)");
+    if (fileName.isEmpty()) return;
 
-        if (loader.loadPly(fileName, splats)) {
-            qDebug() << "Loaded" << splats.size() << "points. Uploading to GPU...";
+    CameraPath path;
+    if (path.load(fileName)) {
+        m_splatWidget->playCameraPath(path);
+    }
+}
+
+void MainWindow::onCompareOitTriggered()
+{
+    // 비교 이미지 저장은 선택 사항 (취소하면 수치만 출력)
+    QString fileName = QFileDialog::getSaveFileName(this, "Save Side-by-Side Image (optional)", "", "PNG (*.png)");
+    m_splatWidget->compareOitWithSorted(fileName);
+}
+
+void MainWindow::onCompareTemporalTriggered()
+{
+    // 비교 이미지 저장은 선택 사항 (취소하면 수치만 출력)
+    QString fileName = QFileDialog::getSaveFileName(this, "Save RCAS vs Temporal Image (optional)", "", "PNG (*.png)");
+    m_splatWidget->compareTemporalWithRcas(32, fileName);
+}
 
-            // [연결] 위젯에 데이터 전달
-            m_splatWidget->loadData(splats);
+void MainWindow::onCompareFrontToBackTriggered()
+{
+    // 비교 이미지 저장은 선택 사항 (취소하면 수치만 출력)
+    QString fileName = QFileDialog::getSaveFileName(this, "Save Back-to-Front vs Front-to-Back Image (optional)", "",
+                                                    "PNG (*.png)");
+    m_splatWidget->compareFrontToBack(16, fileName);
+}
 
-            qDebug() << "Upload Complete!";
-        } else {
-            qCritical() << "Failed to load PLY.";
-        }
+void MainWindow::onCompareDepthPrepassTriggered()
+{
+    // 비교 이미지 저장은 선택 사항 (취소하면 수치만 출력)
+    QString fileName = QFileDialog::getSaveFileName(this, "Save Without vs With Depth Pre-pass Image (optional)", "",
+                                                    "PNG (*.png)");
+    m_splatWidget->compareDepthPrepass(16, fileName);
+}
+
+void MainWindow::onCheckOcclusionCullingTriggered()
+{
+    // 비교 이미지 저장은 선택 사항 (취소하면 수치만 출력)
+    QString fileName = QFileDialog::getSaveFileName(this, "Save Unculled vs Culled Image (optional)", "",
+                                                    "PNG (*.png)");
+    m_splatWidget->checkOcclusionCulling(4, fileName);
+}
+
+void MainWindow::onMeasurePickLatencyTriggered()
+{
+    m_splatWidget->measurePickLatency();
+}
+
+void MainWindow::createSceneDock()
+{
+    // 여러 캡처를 한 화면에 배치하기 위한 씬 목록 + 변환 편집 패널
+    QDockWidget *dock = new QDockWidget("Scenes", this);
+    dock->setAllowedAreas(Qt::LeftDockWidgetArea | Qt::RightDockWidgetArea);
+
+    QWidget *panel = new QWidget();
+    QVBoxLayout *layout = new QVBoxLayout(panel);
+
+    // 체크박스 = 표시 여부
+    m_sceneList = new QListWidget();
+    layout->addWidget(m_sceneList);
+
+    auto makeSpin = [](double min, double max, double step, double value) {
+        QDoubleSpinBox *spin = new QDoubleSpinBox();
+        spin->setRange(min, max);
+        spin->setSingleStep(step);
+        spin->setDecimals(2);
+        spin->setValue(value);
+        return spin;
+    };
+    m_sceneTx = makeSpin(-1000.0, 1000.0, 0.1, 0.0);
+    m_sceneTy = makeSpin(-1000.0, 1000.0, 0.1, 0.0);
+    m_sceneTz = makeSpin(-1000.0, 1000.0, 0.1, 0.0);
+    m_sceneYaw = makeSpin(-180.0, 180.0, 5.0, 0.0);
+    m_sceneScale = makeSpin(0.01, 100.0, 0.1, 1.0);
+
+    QGroupBox *transformGroup = new QGroupBox("Selected Scene Transform");
+    QFormLayout *form = new QFormLayout(transformGroup);
+    form->addRow("X", m_sceneTx);
+    form->addRow("Y", m_sceneTy);
+    form->addRow("Z", m_sceneTz);
+    form->addRow("Yaw", m_sceneYaw);
+    form->addRow("Scale", m_sceneScale);
+    layout->addWidget(transformGroup);
+
+    dock->setWidget(panel);
+    addDockWidget(Qt::RightDockWidgetArea, dock);
+
+    connect(m_sceneList, &QListWidget::currentRowChanged, this, &MainWindow::onSceneSelectionChanged);
+    connect(m_sceneList, &QListWidget::itemChanged, [this](QListWidgetItem *item){
+        m_splatWidget->setSceneVisible(m_sceneList->row(item), item->checkState() == Qt::Checked);
+    });
+
+    for (QDoubleSpinBox *spin : { m_sceneTx, m_sceneTy, m_sceneTz, m_sceneYaw, m_sceneScale }) {
+        connect(spin, &QDoubleSpinBox::valueChanged, this, &MainWindow::onSceneTransformEdited);
+    }
+}
+
+void MainWindow::onAddSceneTriggered()
+{
+    QString fileName = QFileDialog::getOpenFileName(this, "Add Gaussian Splatting File as Scene", "", SplatFileLoader::fileDialogFilter());
+    if (fileName.isEmpty()) return;
+
+    SplatFileLoader loader;
+    std::vector<RenderSplat> splats;
+    ShPalette sh;
+    if (!loader.load(fileName, splats, &sh)) {
+        qCritical() << "Failed to load splat file.";
+        return;
+    }
+
+    int index = m_splatWidget->addScene(QFileInfo(fileName).fileName(), splats, true, &sh);
+    if (index < 0) return;
+
+    QListWidgetItem *item = new QListWidgetItem(QFileInfo(fileName).fileName(), m_sceneList);
+    item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+    item->setCheckState(Qt::Checked);
+    m_sceneList->setCurrentRow(index);
+}
+
+void MainWindow::onOpenStreamedTriggered()
+{
+    QString fileName = QFileDialog::getOpenFileName(this, "Open Chunked Scene", "", "Chunked Scene (*.s2sc)");
+    if (fileName.isEmpty()) return;
+
+    m_splatWidget->setStreamingBudgets(qint64(m_streamCpuBudget->value()) * 1024 * 1024,
+                                       qint64(m_streamGpuBudget->value()) * 1024 * 1024);
+    if (!m_splatWidget->openStreamedScene(fileName)) {
+        qCritical() << "Failed to open chunked scene.";
+        return;
     }
+
+    m_sceneList->clear();
+    QListWidgetItem *item = new QListWidgetItem(QFileInfo(fileName).fileName() + " (streaming)", m_sceneList);
+    item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+    item->setCheckState(Qt::Checked);
+    m_sceneList->setCurrentRow(0);
+}
+
+void MainWindow::onOpenRemoteTriggered()
+{
+    QString text = QInputDialog::getText(this, "Open PLY URL", "URL (http/https, server must support Range):",
+                                         QLineEdit::Normal, "http://127.0.0.1:8080/scene.ply");
+    if (text.isEmpty()) return;
+
+    const QUrl url(text.trimmed());
+    if (!m_splatWidget->openRemoteScene(url)) {
+        qCritical() << "Failed to start remote load:" << text;
+        return;
+    }
+
+    m_sceneList->clear();
+    QListWidgetItem *item = new QListWidgetItem(url.fileName() + " (remote)", m_sceneList);
+    item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+    item->setCheckState(Qt::Checked);
+    m_sceneList->setCurrentRow(0);
+}
+
+void MainWindow::onBuildChunkedSceneTriggered()
+{
+    QString plyName = QFileDialog::getOpenFileName(this, "Source Splat File", "", SplatFileLoader::fileDialogFilter());
+    if (plyName.isEmpty()) return;
+    QString outName = QFileDialog::getSaveFileName(this, "Save Chunked Scene", "", "Chunked Scene (*.s2sc)");
+    if (outName.isEmpty()) return;
+
+    SplatFileLoader loader;
+    std::vector<RenderSplat> splats;
+    if (!loader.load(plyName, splats)) {
+        qCritical() << "Failed to load splat file.";
+        return;
+    }
+    ChunkedScene::build(std::move(splats), outName);
+}
+
+void MainWindow::onBenchmarkSpatialOrderTriggered()
+{
+    QString fileName = QFileDialog::getOpenFileName(this, "Benchmark Splat File", "", SplatFileLoader::fileDialogFilter());
+    if (fileName.isEmpty()) return;
+
+    // 파일 순서 그대로 읽어서 위젯이 두 순서로 각각 측정
+    SplatFileLoader loader;
+    std::vector<RenderSplat> splats;
+    if (!loader.load(fileName, splats)) {
+        qCritical() << "Failed to load splat file.";
+        return;
+    }
+    m_splatWidget->benchmarkSpatialOrder(splats);
+
+    m_sceneList->clear();
+    QListWidgetItem *item = new QListWidgetItem(QFileInfo(fileName).fileName(), m_sceneList);
+    item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+    item->setCheckState(Qt::Checked);
+    m_sceneList->setCurrentRow(0);
+}
+
+void MainWindow::onBenchmarkLoadFormatsTriggered()
+{
+    // 같은 씬을 여러 포맷으로 저장한 파일들을 골라 로드 시간 비교
+    QStringList fileNames = QFileDialog::getOpenFileNames(this, "Select the same scene in several formats", "",
+                                                          SplatFileLoader::fileDialogFilter());
+    if (fileNames.isEmpty()) return;
+    SplatFileLoader::benchmarkLoad(fileNames);
+}
+
+void MainWindow::onExportSplatTriggered()
+{
+    int row = std::max(0, m_sceneList->currentRow());
+    if (row >= m_splatWidget->sceneCount()) return;
+
+    QString fileName = QFileDialog::getSaveFileName(this, "Export Scene as .splat", "", "Splat (*.splat)");
+    if (fileName.isEmpty()) return;
+    SplatFileLoader::saveSplat(fileName, m_splatWidget->scene(row)->splats());
+}
+
+void MainWindow::onSceneSelectionChanged(int row)
+{
+    if (row < 0 || row >= m_splatWidget->sceneCount()) return;
+
+    // 선택한 씬의 현재 변환을 스핀박스에 표시 (이때 발생하는 valueChanged는 무시)
+    const SceneTransform &t = m_splatWidget->scene(row)->transform();
+    m_updatingSceneUi = true;
+    m_sceneTx->setValue(t.translation.x());
+    m_sceneTy->setValue(t.translation.y());
+    m_sceneTz->setValue(t.translation.z());
+    m_sceneYaw->setValue(t.yawDegrees);
+    m_sceneScale->setValue(t.scale);
+    m_updatingSceneUi = false;
+}
+
+void MainWindow::onSceneTransformEdited()
+{
+    if (m_updatingSceneUi) return;
+
+    int row = m_sceneList->currentRow();
+    if (row < 0) return;
+
+    SceneTransform t;
+    t.translation = QVector3D(m_sceneTx->value(), m_sceneTy->value(), m_sceneTz->value());
+    t.yawDegrees = m_sceneYaw->value();
+    t.scale = m_sceneScale->value();
+    m_splatWidget->setSceneTransform(row, t);
 }
@@ -11,14 +11,49 @@ public:
     MainWindow(QWidget *parent = nullptr);
     ~MainWindow();
 
+    bool loadSceneFile(const QString &fileName); // 장면을 이 파일 하나로 교체 (File > Open과 같음)
+    class SplattingWidget *splatWidget() const { return m_splatWidget; }
+
 private:
     void createDummyPly(const QString& filename);
 
 private slots:
     void onOpenActionTriggered(); // 파일 열기 슬롯
+    void onRecordCameraToggled(bool checked);
+    void onPlayCameraPathTriggered();
+    void onCompareOitTriggered();
+    void onCompareTemporalTriggered();
+    void onCompareFrontToBackTriggered();
+    void onCompareDepthPrepassTriggered();
+    void onCheckOcclusionCullingTriggered();
+    void onMeasurePickLatencyTriggered();
+    void onAddSceneTriggered();
+    void onOpenStreamedTriggered();
+    void onOpenRemoteTriggered();
+    void onBuildChunkedSceneTriggered();
+    void onBenchmarkSpatialOrderTriggered();
+    void onBenchmarkLoadFormatsTriggered();
+    void onExportSplatTriggered();
+    void onSceneSelectionChanged(int row);
+    void onSceneTransformEdited();
 
 private:
+    void createSceneDock();
+
     class SplattingWidget *m_splatWidget; // 전방 선언 사용
+
+    // 씬 목록 패널
+    class QListWidget *m_sceneList = nullptr;
+    class QDoubleSpinBox *m_sceneTx = nullptr;
+    class QDoubleSpinBox *m_sceneTy = nullptr;
+    class QDoubleSpinBox *m_sceneTz = nullptr;
+    class QDoubleSpinBox *m_sceneYaw = nullptr;
+    class QDoubleSpinBox *m_sceneScale = nullptr;
+    bool m_updatingSceneUi = false; // 선택 변경 중 스핀박스 시그널 무시
+
+    // 스트리밍 메모리 예산 (MB)
+    class QSpinBox *m_streamCpuBudget = nullptr;
+    class QSpinBox *m_streamGpuBudget = nullptr;
 };
 
 #endif // MAINWINDOW_H
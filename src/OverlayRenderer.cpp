@@ -0,0 +1,266 @@
+#include "OverlayRenderer.h"
+#include "ShaderCache.h"
+#include <QFontMetricsF>
+#include <QImage>
+#include <QPainter>
+#include <QVector2D>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdio>
+
+namespace {
+
+const int ATLAS_COLUMNS = 16;
+const int ATLAS_ROWS = 6; // 95 글리프 + 불투명 칸 1개
+const int WHITE_CELL = 95;
+
+const char *OVERLAY_VERTEX_SOURCE = R"(
+    #version 330 core
+    layout(location = 0) in vec2 aPos;
+    layout(location = 1) in vec2 aUv;
+    layout(location = 2) in vec4 aColor;
+
+    uniform vec2 uScreen; // 논리 픽셀 크기
+
+    out vec2 vUv;
+    out vec4 vColor;
+
+    void main() {
+        vUv = aUv;
+        vColor = aColor;
+        gl_Position = vec4(aPos.x / uScreen.x * 2.0 - 1.0, 1.0 - aPos.y / uScreen.y * 2.0, 0.0, 1.0);
+    }
+)";
+
+const char *OVERLAY_FRAGMENT_SOURCE = R"(
+    #version 330 core
+    in vec2 vUv;
+    in vec4 vColor;
+
+    uniform sampler2D uAtlas;
+
+    out vec4 FragColor;
+
+    void main() {
+        FragColor = vec4(vColor.rgb, vColor.a * texture(uAtlas, vUv).a);
+    }
+)";
+
+} // namespace
+
+bool OverlayRenderer::initialize(ShaderCache &cache, const QFont &font, qreal devicePixelRatio)
+{
+    initializeOpenGLFunctions();
+    destroy();
+
+    m_program = cache.program(OVERLAY_VERTEX_SOURCE, OVERLAY_FRAGMENT_SOURCE);
+    if (!m_program) return false;
+
+    // 1. 글리프 아틀라스 (논리 픽셀로 배치, 이미지는 devicePixelRatio배 해상도)
+    QImage probe(1, 1, QImage::Format_ARGB32_Premultiplied);
+    const QFontMetricsF metrics(font, &probe);
+    m_padding = 1.0f;
+    m_ascent = float(metrics.ascent());
+    m_cellWidth = std::ceil(float(metrics.maxWidth())) + 2.0f * m_padding;
+    m_cellHeight = std::ceil(float(metrics.ascent() + metrics.descent())) + 2.0f * m_padding;
+
+    const int atlasWidth = int(std::ceil(ATLAS_COLUMNS * m_cellWidth * devicePixelRatio));
+    const int atlasHeight = int(std::ceil(ATLAS_ROWS * m_cellHeight * devicePixelRatio));
+    QImage atlas(atlasWidth, atlasHeight, QImage::Format_ARGB32_Premultiplied);
+    atlas.setDevicePixelRatio(devicePixelRatio);
+    atlas.fill(Qt::transparent);
+
+    const float logicalWidth = ATLAS_COLUMNS * m_cellWidth;
+    const float logicalHeight = ATLAS_ROWS * m_cellHeight;
+    QPainter painter(&atlas);
+    painter.setFont(font);
+    painter.setPen(Qt::white);
+    for (int i = 0; i <= WHITE_CELL; ++i) {
+        const float x = (i % ATLAS_COLUMNS) * m_cellWidth;
+        const float y = (i / ATLAS_COLUMNS) * m_cellHeight;
+        if (i == WHITE_CELL) {
+            painter.fillRect(QRectF(x, y, m_cellWidth, m_cellHeight), Qt::white);
+            m_whiteU = (x + 0.5f * m_cellWidth) / logicalWidth;
+            m_whiteV = (y + 0.5f * m_cellHeight) / logicalHeight;
+            break;
+        }
+        const QChar c(ushort(' ' + i));
+        painter.drawText(QPointF(x + m_padding, y + m_padding + m_ascent), QString(c));
+
+        Glyph &glyph = m_glyphs[i];
+        glyph.advance = float(metrics.horizontalAdvance(c));
+        glyph.u0 = x / logicalWidth;
+        glyph.v0 = y / logicalHeight;
+        glyph.u1 = (x + m_cellWidth) / logicalWidth;
+        glyph.v1 = (y + m_cellHeight) / logicalHeight;
+    }
+    painter.end();
+
+    const QImage rgba = atlas.convertToFormat(QImage::Format_RGBA8888_Premultiplied);
+    glGenTextures(1, &m_atlas);
+    glBindTexture(GL_TEXTURE_2D, m_atlas);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, rgba.width(), rgba.height(), 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                 rgba.constBits());
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    // 2. 고정 크기 정점 버퍼 (프레임마다 앞부분만 덮어씀)
+    m_vertices.clear();
+    m_vertices.reserve(size_t(MAX_QUADS) * 6);
+
+    m_vao.create();
+    m_vao.bind();
+    m_vbo = QOpenGLBuffer(QOpenGLBuffer::VertexBuffer);
+    m_vbo.create();
+    m_vbo.setUsagePattern(QOpenGLBuffer::StreamDraw);
+    m_vbo.bind();
+    m_vbo.allocate(int(m_vertices.capacity() * sizeof(Vertex)));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<const void *>(offsetof(Vertex, x)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<const void *>(offsetof(Vertex, u)));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex),
+                          reinterpret_cast<const void *>(offsetof(Vertex, r)));
+    m_vao.release();
+    m_vbo.release();
+
+    m_program->bind();
+    m_program->setUniformValue("uAtlas", 0);
+    m_program->release();
+
+    qDebug() << "Overlay atlas:" << rgba.width() << "x" << rgba.height() << "for" << font.family() << font.pointSize()
+             << "pt";
+    return true;
+}
+
+void OverlayRenderer::destroy()
+{
+    if (m_atlas) glDeleteTextures(1, &m_atlas);
+    m_atlas = 0;
+    m_vbo.destroy();
+    m_vao.destroy();
+    m_program = nullptr; // ShaderCache 소유
+}
+
+void OverlayRenderer::setColor(const QColor &color)
+{
+    m_color[0] = quint8(color.red());
+    m_color[1] = quint8(color.green());
+    m_color[2] = quint8(color.blue());
+    m_color[3] = quint8(color.alpha());
+}
+
+void OverlayRenderer::quad(float x0, float y0, float x1, float y1, float x2, float y2,
+                           float u0, float v0, float u1, float v1)
+{
+    if (m_vertices.size() + 6 > m_vertices.capacity()) {
+        ++m_dropped;
+        return;
+    }
+    // p0 = 왼쪽 위, p1 = 오른쪽 위, p2 = 왼쪽 아래
+    const float x3 = x1 + x2 - x0, y3 = y1 + y2 - y0;
+    const quint8 r = m_color[0], g = m_color[1], b = m_color[2], a = m_color[3];
+    const Vertex v[4] = {
+        { x0, y0, u0, v0, r, g, b, a },
+        { x1, y1, u1, v0, r, g, b, a },
+        { x2, y2, u0, v1, r, g, b, a },
+        { x3, y3, u1, v1, r, g, b, a },
+    };
+    m_vertices.push_back(v[0]);
+    m_vertices.push_back(v[1]);
+    m_vertices.push_back(v[2]);
+    m_vertices.push_back(v[2]);
+    m_vertices.push_back(v[1]);
+    m_vertices.push_back(v[3]);
+}
+
+void OverlayRenderer::text(float x, float y, const char *text)
+{
+    if (!isValid()) return;
+    const float top = y - m_ascent - m_padding;
+    for (const char *p = text; *p; ++p) {
+        int c = static_cast<unsigned char>(*p);
+        if (c < ' ' || c > '~') c = '?';
+        const Glyph &glyph = m_glyphs[c - ' '];
+        if (c != ' ') {
+            const float left = x - m_padding;
+            quad(left, top, left + m_cellWidth, top, left, top + m_cellHeight, glyph.u0, glyph.v0, glyph.u1, glyph.v1);
+        }
+        x += glyph.advance;
+    }
+}
+
+void OverlayRenderer::printf(float x, float y, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    std::vsnprintf(m_format, sizeof(m_format), format, args);
+    va_end(args);
+    text(x, y, m_format);
+}
+
+void OverlayRenderer::rect(float x, float y, float w, float h)
+{
+    if (!isValid()) return;
+    quad(x, y, x + w, y, x, y + h, m_whiteU, m_whiteV, m_whiteU, m_whiteV);
+}
+
+void OverlayRenderer::line(float x0, float y0, float x1, float y1, float width, float dash)
+{
+    if (!isValid()) return;
+    const float dx = x1 - x0, dy = y1 - y0;
+    const float length = std::sqrt(dx * dx + dy * dy);
+    if (length <= 0.0f) return;
+
+    // 선에 수직인 방향으로 두께의 절반씩
+    const float tx = dx / length, ty = dy / length;
+    const float nx = -ty * 0.5f * width, ny = tx * 0.5f * width;
+    const float step = dash > 0.0f ? dash * 1.5f : length;
+    for (float s = 0.0f; s < length; s += step) {
+        const float e = dash > 0.0f ? std::min(length, s + dash) : length;
+        const float ax = x0 + tx * s, ay = y0 + ty * s;
+        const float bx = x0 + tx * e, by = y0 + ty * e;
+        quad(ax - nx, ay - ny, bx - nx, by - ny, ax + nx, ay + ny, m_whiteU, m_whiteV, m_whiteU, m_whiteV);
+    }
+}
+
+void OverlayRenderer::draw(int width, int height, qreal devicePixelRatio)
+{
+    m_lastDropped = m_dropped;
+    m_dropped = 0;
+    if (!isValid() || m_vertices.empty() || width <= 0 || height <= 0) {
+        m_vertices.clear();
+        return;
+    }
+
+    glViewport(0, 0, int(width * devicePixelRatio), int(height * devicePixelRatio));
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_STENCIL_TEST);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    m_program->bind();
+    m_program->setUniformValue("uScreen", QVector2D(float(width), float(height)));
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, m_atlas);
+
+    m_vao.bind();
+    m_vbo.bind();
+    m_vbo.write(0, m_vertices.data(), int(m_vertices.size() * sizeof(Vertex)));
+    glDrawArrays(GL_TRIANGLES, 0, GLsizei(m_vertices.size()));
+    m_vbo.release();
+    m_vao.release();
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    m_program->release();
+    glDisable(GL_BLEND);
+
+    m_vertices.clear(); // 용량은 그대로
+}
@@ -0,0 +1,81 @@
+#ifndef OVERLAYRENDERER_H
+#define OVERLAYRENDERER_H
+
+#include <QOpenGLExtraFunctions>
+#include <QOpenGLShaderProgram>
+#include <QOpenGLBuffer>
+#include <QOpenGLVertexArrayObject>
+#include <QColor>
+#include <QFont>
+#include <vector>
+
+class ShaderCache;
+
+// 화면 위 디버그 오버레이 (텍스트 + 단색 사각형/선)를 GL로 직접 그림
+//
+// initialize()에서 글꼴의 ASCII 글리프(32~126)를 아틀라스 텍스처 하나에 한 번 그려 두고,
+// 프레임마다 고정 크기 정점 배열에 사각형을 채워 드로우 한 번으로 그립니다.
+// QPainter와 달리 프레임 중 힙 할당이 없습니다 (printf 형식 문자열도 고정 버퍼에 씀).
+// 좌표는 위젯 논리 픽셀 (왼쪽 위 원점), text()의 y는 QPainter::drawText처럼 기준선입니다.
+// 사각형이 MAX_QUADS를 넘으면 나머지는 버리고 droppedQuads()로 셉니다.
+class OverlayRenderer : protected QOpenGLExtraFunctions
+{
+public:
+    static const int MAX_QUADS = 8192;
+
+    // 컨텍스트가 current인 상태에서. 프로그램은 cache 소유
+    bool initialize(ShaderCache &cache, const QFont &font, qreal devicePixelRatio);
+    void destroy();
+    bool isValid() const { return m_program != nullptr; }
+
+    void setColor(const QColor &color);
+    void text(float x, float y, const char *text);
+    void printf(float x, float y, const char *format, ...)
+#if defined(__GNUC__) || defined(__clang__)
+        __attribute__((format(printf, 4, 5)))
+#endif
+        ;
+    void rect(float x, float y, float w, float h);
+    // dash > 0이면 dash 길이만큼 그리고 dash / 2만큼 띄움
+    void line(float x0, float y0, float x1, float y1, float width, float dash = 0.0f);
+
+    // 지금 바인딩된 프레임버퍼(논리 크기 width x height)에 모은 사각형을 그리고 비움
+    void draw(int width, int height, qreal devicePixelRatio);
+
+    int droppedQuads() const { return m_lastDropped; } // 마지막 draw()에서 버린 사각형
+
+private:
+    struct Vertex {
+        float x, y;
+        float u, v;
+        quint8 r, g, b, a;
+    };
+    struct Glyph {
+        float advance = 0.0f; // 논리 픽셀
+        float u0 = 0.0f, v0 = 0.0f, u1 = 0.0f, v1 = 0.0f;
+    };
+
+    // p0 = 왼쪽 위, p1 = 오른쪽 위, p2 = 왼쪽 아래인 평행사변형 (p3 = p1 + p2 - p0)
+    void quad(float x0, float y0, float x1, float y1, float x2, float y2, float u0, float v0, float u1, float v1);
+
+    QOpenGLShaderProgram *m_program = nullptr;
+    QOpenGLVertexArrayObject m_vao;
+    QOpenGLBuffer m_vbo;
+    GLuint m_atlas = 0;
+
+    Glyph m_glyphs[95];          // ' ' ~ '~'
+    float m_whiteU = 0.0f;       // 아틀라스에서 불투명한 칸의 중심 (단색 사각형용)
+    float m_whiteV = 0.0f;
+    float m_cellWidth = 0.0f;    // 글리프 칸 크기 (논리 픽셀, 여백 포함)
+    float m_cellHeight = 0.0f;
+    float m_ascent = 0.0f;
+    float m_padding = 0.0f;
+
+    std::vector<Vertex> m_vertices; // MAX_QUADS * 6 용량으로 한 번 잡고 이후로는 늘리지 않음
+    quint8 m_color[4] = { 255, 255, 255, 255 };
+    char m_format[512];
+    int m_dropped = 0;
+    int m_lastDropped = 0;
+};
+
+#endif // OVERLAYRENDERER_H
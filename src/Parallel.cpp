@@ -0,0 +1,41 @@
+#include "Parallel.h"
+#include "TaskScheduler.h"
+#include <algorithm>
+
+namespace {
+
+// 스레드당 조각 수 (훔치기로 부하를 맞출 여지)
+const size_t CHUNKS_PER_THREAD = 4;
+
+} // namespace
+
+int parallelWorkerCount()
+{
+    return TaskScheduler::instance().concurrency();
+}
+
+void parallelForRangeImpl(size_t begin, size_t end, size_t grain,
+                          const std::function<void(size_t, size_t)> &fn)
+{
+    if (end <= begin) return;
+
+    const size_t count = end - begin;
+    grain = std::max<size_t>(grain, 1);
+
+    const size_t threads = size_t(parallelWorkerCount());
+    const size_t chunks = std::min<size_t>(threads > 1 ? threads * CHUNKS_PER_THREAD : 1, (count + grain - 1) / grain);
+    if (chunks <= 1) {
+        fn(begin, end);
+        return;
+    }
+
+    const size_t chunkSize = (count + chunks - 1) / chunks;
+
+    // 첫 조각은 호출한 스레드가 직접 처리하고, 나머지는 기다리면서 함께 처리
+    TaskGroup group("parallelFor");
+    for (size_t b = begin + chunkSize; b < end; b += chunkSize) {
+        group.runRange(fn, b, std::min(end, b + chunkSize));
+    }
+    fn(begin, std::min(end, begin + chunkSize));
+    group.wait();
+}
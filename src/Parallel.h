@@ -0,0 +1,88 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+// 아래 템플릿의 구현. std::function에는 참조 하나만 잡은 람다가 들어가므로 힙 할당이 없습니다.
+// (캡처가 큰 람다를 std::function으로 바로 넘기면 호출마다 할당 -> 프레임마다 정렬할 때 문제)
+void parallelForRangeImpl(size_t begin, size_t end, size_t grain,
+                          const std::function<void(size_t, size_t)> &fn);
+
+// 간단한 병렬 실행 헬퍼 (TaskScheduler 위에서 동작)
+// [begin, end) 구간을 grain 크기 이상의 조각으로 나눠 여러 스레드에서 실행합니다.
+// fn(chunkBegin, chunkEnd)는 서로 겹치지 않는 구간을 받습니다.
+// 조각은 스레드 수보다 여러 배 많게 나누므로, 먼저 끝난 스레드가 남은 조각을 훔쳐 가 부하가 고르게 맞춰집니다.
+// 작업 안에서 다시 호출해도 됩니다 (기다리는 스레드가 대기 중인 작업을 실행).
+template <typename Fn>
+void parallelForRange(size_t begin, size_t end, size_t grain, const Fn &fn)
+{
+    parallelForRangeImpl(begin, end, grain, [&fn](size_t b, size_t e) { fn(b, e); });
+}
+
+// 항목 하나씩 처리하는 버전 (씬 단위처럼 개수가 적고 항목이 무거운 경우)
+template <typename Fn>
+void parallelFor(int begin, int end, const Fn &fn)
+{
+    if (end <= begin) return;
+    parallelForRangeImpl(static_cast<size_t>(begin), static_cast<size_t>(end), 1, [&fn](size_t b, size_t e) {
+        for (size_t i = b; i < e; ++i) fn(static_cast<int>(i));
+    });
+}
+
+// 동시에 일하는 스레드 수 (스케줄러 풀 + 호출 스레드)
+int parallelWorkerCount();
+
+// 정렬된 구간 [bounds[i], bounds[i + 1])들을 두 개씩 병렬로 병합해 data 전체를 정렬
+// temp는 작업 버퍼 (재사용 가능), bounds는 병합하면서 줄어듦 (끝나면 { 0, data.size() })
+template <typename T>
+void parallelMergeRuns(std::vector<T> &data, std::vector<size_t> &bounds, std::vector<T> &temp)
+{
+    const size_t count = data.size();
+    temp.resize(count);
+    while (bounds.size() > 2) {
+        const int pairs = static_cast<int>(bounds.size() - 1) / 2;
+        parallelFor(0, pairs, [&](int p) {
+            const size_t b = bounds[2 * p], m = bounds[2 * p + 1], e = bounds[2 * p + 2];
+            std::merge(data.begin() + b, data.begin() + m, data.begin() + m, data.begin() + e, temp.begin() + b);
+        });
+        // 짝이 없는 마지막 조각은 그대로 복사
+        if ((bounds.size() - 1) % 2 == 1) {
+            const size_t b = bounds[bounds.size() - 2];
+            std::copy(data.begin() + b, data.end(), temp.begin() + b);
+        }
+        size_t merged = 0;
+        for (size_t i = 0; i < bounds.size(); i += 2) bounds[merged++] = bounds[i];
+        if (bounds[merged - 1] != count) bounds[merged++] = count;
+        bounds.resize(merged);
+        data.swap(temp);
+    }
+}
+
+// 조각별 병렬 정렬 후 두 개씩 병렬 병합 (조각 수 = 스레드 수, 작은 입력은 std::sort 한 번)
+template <typename T>
+void parallelSort(std::vector<T> &data)
+{
+    const size_t count = data.size();
+    const size_t parts = std::max<size_t>(1, std::min<size_t>(parallelWorkerCount(), count / 65536));
+    if (parts == 1) {
+        std::sort(data.begin(), data.end());
+        return;
+    }
+    const size_t partSize = (count + parts - 1) / parts;
+
+    std::vector<size_t> bounds;
+    for (size_t b = 0; b < count; b += partSize) bounds.push_back(b);
+    bounds.push_back(count);
+
+    parallelFor(0, static_cast<int>(bounds.size()) - 1, [&](int p) {
+        std::sort(data.begin() + bounds[p], data.begin() + bounds[p + 1]);
+    });
+
+    std::vector<T> temp;
+    parallelMergeRuns(data, bounds, temp);
+}
+
+#endif // PARALLEL_H
@@ -1,9 +1,21 @@
 #include "PlyLoader.h"
+#include "TaskScheduler.h"
 #include <QFile>
 #include <QTextStream>
 #include <QDataStream>
 #include <QDebug>
+#include <algorithm>
 #include <cmath>
+#include <functional>
+
+namespace {
+
+// 한 번에 읽을 블록 크기와 디코딩 작업 하나의 정점 수 (블록 하나 = 작업 30여 개)
+const qint64 BLOCK_BYTES = 32 * 1024 * 1024;
+const size_t DECODE_GRAIN = 4096;
+const size_t SH_REST_FLOATS = 45;
+
+} // namespace
 
 PlyLoader::PlyLoader() {}
 
@@ -11,7 +23,86 @@ float PlyLoader::sigmoid(float x) {
     return 1.0f / (1.0f + std::exp(-x));
 }
 
-bool PlyLoader::loadPly(const QString &filePath, std::vector<RenderSplat> &outSplats)
+bool PlyLoader::parseHeader(const QByteArray &bytes, Header &outHeader)
+{
+    outHeader = Header();
+    qint64 pos = 0;
+    bool inVertexElement = false;
+    while (pos < bytes.size()) {
+        const qint64 lineEnd = bytes.indexOf('\n', pos);
+        if (lineEnd < 0) return false; // 헤더가 더 이어짐
+        const QByteArray line = bytes.mid(pos, lineEnd - pos).trimmed();
+        pos = lineEnd + 1;
+
+        if (line == "end_header") {
+            outHeader.dataOffset = pos;
+            return outHeader.vertexCount > 0;
+        }
+        if (line.startsWith("format binary_little_endian")) {
+            outHeader.binary = true;
+        } else if (line.startsWith("element")) {
+            QList<QByteArray> parts = line.split(' ');
+            inVertexElement = parts.size() >= 3 && parts[1] == "vertex";
+            if (inVertexElement) outHeader.vertexCount = parts[2].toLongLong();
+        } else if (line.startsWith("property") && inVertexElement) {
+            ++outHeader.propertyCount;
+        }
+    }
+    return false;
+}
+
+bool PlyLoader::checkHeader(const Header &header, QString &error)
+{
+    if (header.vertexCount <= 0) {
+        error = "no vertices";
+        return false;
+    }
+    if (!header.binary || header.propertyCount != FLOATS_PER_VERTEX) {
+        error = QString("unsupported PLY layout (binary=%1, %2 properties, expected %3 floats)")
+                    .arg(header.binary)
+                    .arg(header.propertyCount)
+                    .arg(FLOATS_PER_VERTEX);
+        return false;
+    }
+    return true;
+}
+
+void PlyLoader::decodeVertices(const float *raw, size_t count, RenderSplat *out)
+{
+    for (size_t i = 0; i < count; ++i) {
+        const float *record = raw + i * FLOATS_PER_VERTEX;
+        RenderSplat &s = out[i];
+
+        // 1. Position
+        s.x = record[0];
+        s.y = record[1];
+        s.z = record[2];
+
+        // 2. Color (f_dc)
+        // SH 0th order는 RGB로 변환 시 0.28209... 상수가 붙음 + 0.5 offset
+        const float SH_C0 = 0.28209479177387814f;
+        s.r = std::clamp(0.5f + SH_C0 * record[6], 0.0f, 1.0f);
+        s.g = std::clamp(0.5f + SH_C0 * record[7], 0.0f, 1.0f);
+        s.b = std::clamp(0.5f + SH_C0 * record[8], 0.0f, 1.0f);
+
+        // 3. Opacity (Sigmoid 적용 필요)
+        s.opacity = sigmoid(record[54]);
+
+        // 4. Scale (Exp 적용 필요)
+        s.scale[0] = std::exp(record[55]);
+        s.scale[1] = std::exp(record[56]);
+        s.scale[2] = std::exp(record[57]);
+
+        // 5. Rotation
+        s.rot[0] = record[58];
+        s.rot[1] = record[59];
+        s.rot[2] = record[60];
+        s.rot[3] = record[61];
+    }
+}
+
+bool PlyLoader::loadPly(const QString &filePath, std::vector<RenderSplat> &outSplats,
+                        std::vector<float> *outShRest)
 {
     QFile file(filePath);
     if (!file.open(QIODevice::ReadOnly)) {
@@ -20,97 +111,96 @@ bool PlyLoader::loadPly(const QString &filePath, std::vector<RenderSplat> &outSp
     }
 
     // --- 1. Header Parsing ---
-    int vertexCount = 0;
-    bool isBinary = false;
-
+    // end_header까지 줄 단위로 모아 네트워크 로더와 같은 parseHeader/checkHeader로 해석
+    QByteArray headerBytes;
     while (!file.atEnd()) {
-        QByteArray line = file.readLine().trimmed();
-        if (line == "end_header") break;
-
-        if (line.startsWith("format binary_little_endian")) {
-            isBinary = true;
-        }
-        else if (line.startsWith("element vertex")) {
-            // "element vertex 123456" 형태에서 숫자만 추출
-            QList<QByteArray> parts = line.split(' ');
-            if (parts.size() >= 3) {
-                vertexCount = parts[2].toInt();
-            }
-        }
+        const QByteArray line = file.readLine();
+        headerBytes += line;
+        if (line.trimmed() == "end_header") break;
     }
 
-    if (vertexCount <= 0 || !isBinary) {
-        qCritical() << "Invalid PLY format or empty file.";
+    Header header;
+    QString error;
+    if (!parseHeader(headerBytes, header)) error = "PLY header not found or empty";
+    if (error.isEmpty()) checkHeader(header, error);
+    if (!error.isEmpty()) {
+        qCritical().noquote() << "Invalid PLY file:" << filePath << "-" << error;
         return false;
     }
 
-    qDebug() << "Loading" << vertexCount << "splats...";
+    qDebug() << "Loading" << header.vertexCount << "splats...";
 
     // --- 2. Binary Body Reading ---
-    // 전체 데이터를 담을 버퍼 준비
     // 주의: 표준 3DGS PLY 포맷 순서를 가정합니다.
     // (x,y,z, nx,ny,nz, f_dc_0,1,2, f_rest(45개), opacity, scale_0,1,2, rot_0,1,2,3)
     // 총 62개의 float = 248 bytes per splat
-
     // 파일 포인터는 현재 'end_header' 다음 줄(바이너리 시작점)에 있음
-    QByteArray data = file.readAll();
-
-    // 데이터 크기 검증 (간단히)
-    // const int splatSize = 62 * sizeof(float);
-    // 실제로는 property 순서에 따라 다를 수 있으나, 표준 학습 모델 결과물 기준
-
-    const float* rawData = reinterpret_cast<const float*>(data.constData());
+    const int STRIDE = FLOATS_PER_VERTEX;
+    const qint64 stride = qint64(STRIDE) * sizeof(float);
 
+    // 파일 끝 체크 (잘린 파일은 온전한 레코드까지만)
+    const size_t count = std::min(size_t(header.vertexCount), size_t((file.size() - file.pos()) / stride));
     outSplats.clear();
-    outSplats.reserve(vertexCount);
-
-    // 표준 구조체 스트라이드 (float 개수)
-    // x,y,z(3) + n(3) + f_dc(3) + f_rest(45) + op(1) + scale(3) + rot(4) = 62
-    const int STRIDE = 62;
-
-    for (int i = 0; i < vertexCount; ++i) {
-        int base = i * STRIDE;
-
-        // 파일 끝 체크
-        if (base + STRIDE > data.size() / sizeof(float)) break;
-
-        RenderSplat s;
-
-        // 1. Position
-        s.x = rawData[base + 0];
-        s.y = rawData[base + 1];
-        s.z = rawData[base + 2];
-
-        // 2. Color (f_dc)
-        // SH 0th order는 RGB로 변환 시 0.28209... 상수가 붙음 + 0.5 offset
-        const float SH_C0 = 0.28209479177387814f;
-        s.r = (0.5f + SH_C0 * rawData[base + 6]);
-        s.g = (0.5f + SH_C0 * rawData[base + 7]);
-        s.b = (0.5f + SH_C0 * rawData[base + 8]);
-
-        // 클램핑 (0~1)
-        if (s.r < 0) s.r = 0; if (s.r > 1) s.r = 1;
-        if (s.g < 0) s.g = 0; if (s.g > 1) s.g = 1;
-        if (s.b < 0) s.b = 0; if (s.b > 1) s.b = 1;
-
-        // 3. Opacity (Sigmoid 적용 필요)
-        s.opacity = sigmoid(rawData[base + 54]);
-
-        // 4. Scale (Exp 적용 필요)
-        s.scale[0] = std::exp(rawData[base + 55]);
-        s.scale[1] = std::exp(rawData[base + 56]);
-        s.scale[2] = std::exp(rawData[base + 57]);
-
-        // 5. Rotation
-        s.rot[0] = rawData[base + 58];
-        s.rot[1] = rawData[base + 59];
-        s.rot[2] = rawData[base + 60];
-        s.rot[3] = rawData[base + 61];
+    outSplats.resize(count);
+    if (outShRest) {
+        outShRest->clear();
+        outShRest->resize(count * SH_REST_FLOATS);
+    }
 
-        outSplats.push_back(s);
+    // 블록 단위로 읽으면서, 읽은 블록은 스케줄러 작업으로 잘게 나눠 디코딩 (다음 블록을 읽는 동안 디코딩이 진행됨)
+    // 버퍼 두 개를 번갈아 쓰고, 버퍼를 다시 채우기 전에 그 버퍼의 디코딩 작업을 기다립니다.
+    struct Block {
+        QByteArray data;
+        size_t first = 0;
+    };
+    Block blocks[2];
+    std::function<void(size_t, size_t)> decode[2];
+    for (int k = 0; k < 2; ++k) {
+        decode[k] = [&, k](size_t begin, size_t end) {
+            const float *raw = reinterpret_cast<const float *>(blocks[k].data.constData());
+            const size_t first = blocks[k].first;
+            decodeVertices(raw + begin * STRIDE, end - begin, outSplats.data() + first + begin);
+
+            // 6. SH 1~3차 (f_rest 45개, 채널 우선 배치)
+            if (outShRest) {
+                for (size_t i = begin; i < end; ++i) {
+                    const float *record = raw + i * STRIDE;
+                    std::copy(record + 9, record + 54, outShRest->data() + (first + i) * SH_REST_FLOATS);
+                }
+            }
+        };
+    }
+    TaskGroup decodeA("ply decode"), decodeB("ply decode");
+    TaskGroup *decoding[2] = { &decodeA, &decodeB };
+
+    const size_t blockVertices = std::max<size_t>(1, size_t(BLOCK_BYTES / stride));
+    bool ok = true;
+    int k = 0;
+    for (size_t first = 0; first < count; first += blockVertices, k ^= 1) {
+        decoding[k]->wait();
+
+        const size_t n = std::min(blockVertices, count - first);
+        const qint64 bytes = qint64(n) * stride;
+        blocks[k].data.resize(bytes);
+        blocks[k].first = first;
+        if (file.read(blocks[k].data.data(), bytes) != bytes) {
+            qCritical() << "Unexpected end of PLY data at vertex" << first;
+            ok = false;
+            break;
+        }
+        for (size_t b = 0; b < n; b += DECODE_GRAIN) {
+            decoding[k]->runRange(decode[k], b, std::min(n, b + DECODE_GRAIN), "ply decode");
+        }
+    }
+    decodeA.wait();
+    decodeB.wait();
+    file.close();
+    if (!ok) {
+        outSplats.clear();
+        if (outShRest) outShRest->clear();
+        return false;
     }
 
     qDebug() << "Successfully loaded" << outSplats.size() << "splats.";
-    file.close();
     return true;
 }
@@ -1,6 +1,7 @@
 #ifndef PLYLOADER_H
 #define PLYLOADER_H
 
+#include <QByteArray>
 #include <QString>
 #include <vector>
 #include "GaussianData.h"
@@ -8,14 +9,37 @@
 class PlyLoader
 {
 public:
+    // 표준 3DGS PLY 정점 하나 = float 62개
+    // (x,y,z, nx,ny,nz, f_dc_0,1,2, f_rest(45개), opacity, scale_0,1,2, rot_0,1,2,3)
+    static const int FLOATS_PER_VERTEX = 62;
+
+    struct Header {
+        qint64 vertexCount = 0;
+        int propertyCount = 0;  // element vertex의 property 줄 수
+        bool binary = false;    // binary_little_endian
+        qint64 dataOffset = 0;  // 바이너리 본문 시작 (end_header 줄 다음)
+    };
+
     PlyLoader();
 
+    // 파일 앞부분으로 헤더 해석 (end_header가 bytes 안에 없으면 false)
+    // 네트워크 로더처럼 파일 전체가 없을 때 씁니다.
+    static bool parseHeader(const QByteArray &bytes, Header &outHeader);
+    // 표준 3DGS 바이너리 레이아웃(정점당 float FLOATS_PER_VERTEX개)인지 확인. 아니면 error에 이유
+    // 파일/네트워크 로더가 같은 파일을 받아들이고 거부하도록 둘 다 이것으로 검사합니다.
+    static bool checkHeader(const Header &header, QString &error);
+
+    // 정점 레코드 count개를 RenderSplat으로 변환 (raw는 FLOATS_PER_VERTEX * count개)
+    static void decodeVertices(const float *raw, size_t count, RenderSplat *out);
+
     // 파일을 읽어서 가공된 데이터(RenderSplat 목록)를 반환
-    bool loadPly(const QString &filePath, std::vector<RenderSplat> &outSplats);
+    // outShRest가 있으면 스플랫마다 f_rest 45개(SH 1~3차)도 함께 담음 (SH 코드북 도구용)
+    bool loadPly(const QString &filePath, std::vector<RenderSplat> &outSplats,
+                 std::vector<float> *outShRest = nullptr);
 
 private:
     // 0~255 범위로 변환 등을 수행하는 헬퍼 함수
-    float sigmoid(float x);
+    static float sigmoid(float x);
 };
 
 #endif // PLYLOADER_H
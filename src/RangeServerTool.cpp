@@ -0,0 +1,371 @@
+// HTTP Range 스트리밍 로더(HttpPlyStream) 시험용 로컬 파일 서버
+//
+//   Switch2RangeServer <root-dir> [--port 8080] [--latency-ms 40] [--bandwidth-mbps 50] [--fail-rate 0.05]
+//                                 [--verify scene.ply]
+//
+// - GET만 지원. Range: bytes=a-b / bytes=a- 는 206, 없으면 200, 범위 밖은 416
+// - 요청마다 --latency-ms만큼 기다린 뒤 응답 시작 (왕복 지연 흉내)
+// - --bandwidth-mbps: 모든 연결이 나눠 쓰는 전체 대역폭 (MB/s, 0 = 무제한)
+// - --fail-rate: 그 비율의 요청을 503으로 거절하거나 본문 중간에 연결을 끊음 (재시도 경로 확인용)
+// - --verify: 서버를 띄운 채 HttpPlyStream으로 root 아래 파일을 받아 PlyLoader로 직접 읽은 결과와 비교하고 종료
+//   (0 = 일치, 1 = 로드 실패, 2 = 내용 불일치)
+//
+// 요청마다 Connection: close로 응답합니다.
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QHostAddress>
+#include <QFile>
+#include <QDir>
+#include <QFileInfo>
+#include <QUrl>
+#include <QTimer>
+#include <QRandomGenerator>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include "HttpPlyStream.h"
+#include "PlyLoader.h"
+
+namespace {
+
+struct ServerOptions {
+    QString root;
+    int latencyMs = 0;
+    double bandwidthMBps = 0.0;
+    double failRate = 0.0;
+};
+
+// 연결 하나 = 요청 하나 (응답 후 닫음)
+class RangeConnection : public QObject
+{
+public:
+    RangeConnection(QTcpSocket *socket, const ServerOptions &options, QObject *parent)
+        : QObject(parent), m_socket(socket), m_options(options)
+    {
+        m_socket->setParent(this);
+        connect(m_socket, &QTcpSocket::readyRead, this, [this]() { onReadyRead(); });
+        connect(m_socket, &QTcpSocket::disconnected, this, [this]() { finish(); });
+    }
+
+    bool isSending() const { return m_sending; }
+
+    // 이번 틱에 보낼 수 있는 바이트 (소켓 버퍼가 차 있으면 쉼). 보낸 양 반환
+    qint64 send(qint64 budget)
+    {
+        if (!m_sending) return 0;
+        const qint64 BUFFER_LIMIT = 4 * 1024 * 1024; // 소켓에 쌓아 둘 최대량
+        budget = std::min({ budget, m_remaining, BUFFER_LIMIT - m_socket->bytesToWrite() });
+        if (m_dropAt >= 0) budget = std::min(budget, m_dropAt);
+        if (budget <= 0) {
+            if (m_dropAt == 0) drop();
+            return 0;
+        }
+
+        const QByteArray data = m_file.read(budget);
+        if (data.isEmpty()) {
+            drop();
+            return 0;
+        }
+        m_socket->write(data);
+        m_remaining -= data.size();
+        if (m_dropAt > 0) m_dropAt -= data.size();
+        if (m_remaining == 0) {
+            m_sending = false;
+            m_socket->disconnectFromHost(); // 남은 버퍼를 다 보낸 뒤 닫힘
+        }
+        return data.size();
+    }
+
+private:
+    void onReadyRead()
+    {
+        m_request += m_socket->readAll();
+        const qsizetype end = m_request.indexOf("\r\n\r\n");
+        if (end < 0) {
+            if (m_request.size() > 64 * 1024) respond(431, "Request Header Fields Too Large");
+            return;
+        }
+        disconnect(m_socket, &QTcpSocket::readyRead, this, nullptr);
+
+        // 요청 줄 + 헤더
+        const QList<QByteArray> lines = m_request.left(end).split('\n');
+        const QList<QByteArray> requestLine = lines.value(0).trimmed().split(' ');
+        QByteArray rangeHeader;
+        for (int i = 1; i < lines.size(); ++i) {
+            const QByteArray line = lines[i].trimmed();
+            if (line.toLower().startsWith("range:")) rangeHeader = line.mid(6).trimmed();
+        }
+
+        // 지연은 응답 시작 전에 (헤더 해석 결과는 그대로 둠)
+        QTimer::singleShot(m_options.latencyMs, this, [this, requestLine, rangeHeader]() {
+            handle(requestLine, rangeHeader);
+        });
+    }
+
+    void handle(const QList<QByteArray> &requestLine, const QByteArray &rangeHeader)
+    {
+        if (requestLine.size() < 3) {
+            respond(400, "Bad Request");
+            return;
+        }
+        if (requestLine[0] != "GET") {
+            respond(405, "Method Not Allowed");
+            return;
+        }
+
+        // root 밖으로 나가는 경로는 거부
+        const QString path = QUrl::fromPercentEncoding(requestLine[1].split('?').value(0));
+        const QString filePath = QDir::cleanPath(m_options.root + "/" + path);
+        if (path.contains("..") || !filePath.startsWith(QDir::cleanPath(m_options.root))
+            || !QFileInfo(filePath).isFile()) {
+            respond(404, "Not Found");
+            return;
+        }
+
+        const bool fail = m_options.failRate > 0.0 && QRandomGenerator::global()->generateDouble() < m_options.failRate;
+        if (fail && QRandomGenerator::global()->bounded(2) == 0) {
+            qInfo().noquote() << "GET" << path << rangeHeader << "-> 503 (injected)";
+            respond(503, "Service Unavailable");
+            return;
+        }
+
+        m_file.setFileName(filePath);
+        if (!m_file.open(QIODevice::ReadOnly)) {
+            respond(500, "Internal Server Error");
+            return;
+        }
+        const qint64 total = m_file.size();
+
+        // bytes=a-b 또는 bytes=a- (여러 구간, 접미사 구간은 지원하지 않음)
+        qint64 first = 0, last = total - 1;
+        const bool ranged = !rangeHeader.isEmpty();
+        if (ranged) {
+            bool ok = rangeHeader.startsWith("bytes=") && !rangeHeader.contains(',');
+            const QList<QByteArray> bounds = rangeHeader.mid(6).split('-');
+            if (ok && bounds.size() == 2 && !bounds[0].isEmpty()) {
+                first = bounds[0].toLongLong(&ok);
+                if (ok && !bounds[1].isEmpty()) last = std::min(bounds[1].toLongLong(&ok), total - 1);
+            } else {
+                ok = false;
+            }
+            if (!ok || first > last || first >= total) {
+                respond(416, "Range Not Satisfiable",
+                        "Content-Range: bytes */" + QByteArray::number(total) + "\r\n");
+                return;
+            }
+        }
+
+        QByteArray header = (ranged ? "HTTP/1.1 206 Partial Content\r\n" : "HTTP/1.1 200 OK\r\n");
+        header += "Content-Type: application/octet-stream\r\n";
+        header += "Accept-Ranges: bytes\r\n";
+        header += "Content-Length: " + QByteArray::number(last - first + 1) + "\r\n";
+        if (ranged) {
+            header += "Content-Range: bytes " + QByteArray::number(first) + "-" + QByteArray::number(last) + "/"
+                      + QByteArray::number(total) + "\r\n";
+        }
+        header += "Connection: close\r\n\r\n";
+        m_socket->write(header);
+
+        m_file.seek(first);
+        m_remaining = last - first + 1;
+        m_dropAt = fail ? QRandomGenerator::global()->bounded(m_remaining) : -1;
+        m_sending = true;
+        qInfo().noquote() << "GET" << path << (ranged ? rangeHeader : QByteArray("(full)")) << "->"
+                          << (ranged ? 206 : 200) << (fail ? "(will drop)" : "");
+    }
+
+    void respond(int status, const QByteArray &reason, const QByteArray &extraHeaders = QByteArray())
+    {
+        QByteArray response = "HTTP/1.1 " + QByteArray::number(status) + " " + reason + "\r\n";
+        response += extraHeaders;
+        response += "Content-Length: 0\r\nConnection: close\r\n\r\n";
+        m_socket->write(response);
+        m_socket->disconnectFromHost();
+    }
+
+    // 본문 중간에 끊기 (--fail-rate)
+    void drop()
+    {
+        m_sending = false;
+        m_socket->abort();
+    }
+
+    void finish()
+    {
+        m_sending = false;
+        deleteLater();
+    }
+
+    QTcpSocket *m_socket;
+    const ServerOptions &m_options;
+    QByteArray m_request;
+    QFile m_file;
+    qint64 m_remaining = 0;
+    qint64 m_dropAt = -1; // 이만큼 보낸 뒤 끊음 (-1 = 끊지 않음)
+    bool m_sending = false;
+};
+
+// 연결을 받고, 10ms마다 대역폭 예산을 보내는 중인 연결에 나눠 줌
+class RangeServer : public QObject
+{
+public:
+    explicit RangeServer(const ServerOptions &options)
+        : m_options(options)
+    {
+        connect(&m_server, &QTcpServer::newConnection, this, [this]() {
+            while (QTcpSocket *socket = m_server.nextPendingConnection()) {
+                m_connections.push_back(new RangeConnection(socket, m_options, this));
+                connect(m_connections.back(), &QObject::destroyed, this, [this](QObject *object) {
+                    m_connections.erase(std::remove(m_connections.begin(), m_connections.end(), object),
+                                        m_connections.end());
+                });
+            }
+        });
+        m_tick.setInterval(TICK_MS);
+        m_tick.setTimerType(Qt::PreciseTimer);
+        connect(&m_tick, &QTimer::timeout, this, [this]() { pumpSends(); });
+        m_clock.start();
+    }
+
+    bool listen(quint16 port)
+    {
+        if (!m_server.listen(QHostAddress::LocalHost, port)) {
+            qCritical().noquote() << "Cannot listen on port" << port << ":" << m_server.errorString();
+            return false;
+        }
+        m_tick.start();
+        return true;
+    }
+    quint16 port() const { return m_server.serverPort(); }
+
+private:
+    static const int TICK_MS = 10;
+
+    void pumpSends()
+    {
+        // 실제 경과 시간만큼 예산 (타이머가 늦어도 평균 대역폭 유지, 버스트는 틱 4개분까지)
+        const qint64 now = m_clock.nsecsElapsed();
+        const double seconds = std::min((now - m_lastTickNs) / 1.0e9, 4.0 * TICK_MS / 1000.0);
+        m_lastTickNs = now;
+
+        std::vector<RangeConnection *> sending;
+        for (QObject *object : m_connections) {
+            RangeConnection *connection = static_cast<RangeConnection *>(object);
+            if (connection->isSending()) sending.push_back(connection);
+        }
+        if (sending.empty()) return;
+
+        if (m_options.bandwidthMBps <= 0.0) {
+            for (RangeConnection *connection : sending) connection->send(4 * 1024 * 1024);
+            return;
+        }
+        m_budget += m_options.bandwidthMBps * 1024.0 * 1024.0 * seconds;
+        const qint64 share = qint64(m_budget / sending.size());
+        for (RangeConnection *connection : sending) m_budget -= connection->send(share);
+        // 못 쓴 예산은 틱 4개분까지만 이월 (소켓 버퍼가 찬 동안 쌓였다가 한꺼번에 나가지 않게)
+        m_budget = std::clamp(m_budget, 0.0, m_options.bandwidthMBps * 1024.0 * 1024.0 * 4.0 * TICK_MS / 1000.0);
+    }
+
+    const ServerOptions &m_options;
+    QTcpServer m_server;
+    std::vector<QObject *> m_connections;
+    QTimer m_tick;
+    QElapsedTimer m_clock;
+    qint64 m_lastTickNs = 0;
+    double m_budget = 0.0;
+};
+
+// --verify: HTTP로 받은 결과와 로컬 디코딩 결과를 비교
+int verify(const QString &root, const QString &fileName, quint16 port)
+{
+    PlyLoader loader;
+    std::vector<RenderSplat> expected;
+    if (!loader.loadPly(QDir(root).filePath(fileName), expected)) return 1;
+
+    std::vector<RenderSplat> received;
+    std::vector<char> seen;
+    HttpPlyStream stream;
+    QObject::connect(&stream, &HttpPlyStream::headerReady, [&](qint64 count) {
+        received.assign(size_t(count), RenderSplat());
+        seen.assign(size_t(count), 0);
+    });
+    QObject::connect(&stream, &HttpPlyStream::chunkReady, [&](qint64 first, const std::vector<RenderSplat> &splats) {
+        std::copy(splats.begin(), splats.end(), received.begin() + first);
+        std::fill(seen.begin() + first, seen.begin() + first + qint64(splats.size()), 1);
+    });
+
+    int result = 1;
+    QObject::connect(&stream, &HttpPlyStream::finished, [&](bool ok, const QString &error) {
+        if (!ok) {
+            qCritical().noquote() << "Verify: load failed -" << error;
+            result = 1;
+        } else if (received.size() != expected.size()
+                   || std::count(seen.begin(), seen.end(), 0) != 0
+                   || std::memcmp(received.data(), expected.data(), expected.size() * sizeof(RenderSplat)) != 0) {
+            qCritical() << "Verify: content mismatch (" << received.size() << "vs" << expected.size() << "splats)";
+            result = 2;
+        } else {
+            qInfo().noquote() << "Verify: OK -" << stream.statsString();
+            result = 0;
+        }
+        QCoreApplication::exit(result);
+    });
+
+    const QUrl url(QString("http://127.0.0.1:%1/%2").arg(port).arg(fileName));
+    if (!stream.start(url)) return 1;
+    QCoreApplication::exec();
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("Switch2RangeServer");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Local HTTP file server with Range support, latency, bandwidth limit and "
+                                     "failure injection (for testing the streaming PLY loader)");
+    parser.addHelpOption();
+    parser.addPositionalArgument("root", "Directory to serve");
+    QCommandLineOption portOption("port", "Port (0 = any free port)", "port", "8080");
+    QCommandLineOption latencyOption("latency-ms", "Delay before each response", "ms", "0");
+    QCommandLineOption bandwidthOption("bandwidth-mbps", "Total bandwidth shared by all connections (MB/s, 0 = unlimited)",
+                                       "mbps", "0");
+    QCommandLineOption failOption("fail-rate", "Fraction of requests answered with 503 or cut mid-body", "rate", "0");
+    QCommandLineOption verifyOption("verify", "Stream <file> from this server, compare with a local load and exit",
+                                    "file");
+    parser.addOption(portOption);
+    parser.addOption(latencyOption);
+    parser.addOption(bandwidthOption);
+    parser.addOption(failOption);
+    parser.addOption(verifyOption);
+    parser.process(app);
+
+    const QStringList args = parser.positionalArguments();
+    if (args.size() != 1 || !QFileInfo(args[0]).isDir()) parser.showHelp(1);
+
+    ServerOptions options;
+    options.root = QFileInfo(args[0]).absoluteFilePath();
+    options.latencyMs = parser.value(latencyOption).toInt();
+    options.bandwidthMBps = parser.value(bandwidthOption).toDouble();
+    options.failRate = std::clamp(parser.value(failOption).toDouble(), 0.0, 1.0);
+
+    RangeServer server(options);
+    if (!server.listen(quint16(parser.value(portOption).toUInt()))) return 1;
+    qInfo().noquote() << QString("Serving %1 on http://127.0.0.1:%2 (latency %3 ms, bandwidth %4, fail rate %5)")
+                             .arg(options.root)
+                             .arg(server.port())
+                             .arg(options.latencyMs)
+                             .arg(options.bandwidthMBps > 0.0 ? QString("%1 MB/s").arg(options.bandwidthMBps)
+                                                              : QString("unlimited"))
+                             .arg(options.failRate);
+
+    if (parser.isSet(verifyOption)) return verify(options.root, parser.value(verifyOption), server.port());
+    return app.exec();
+}
@@ -0,0 +1,44 @@
+#include "RenderGraph.h"
+
+int RenderGraph::addPass(const char *name, quint32 inputs, int upstream)
+{
+    Q_ASSERT(upstream < static_cast<int>(m_passes.size()));
+
+    // 처음에는 결과가 없으므로 더티 상태로 시작
+    m_passes.push_back({ name, inputs, upstream, true, 0, 0 });
+    return static_cast<int>(m_passes.size()) - 1;
+}
+
+bool RenderGraph::invalidate(quint32 inputs)
+{
+    bool changed = false;
+
+    // 패스는 위상 순서로 등록되므로 한 번의 순회로 하류까지 전파됩니다.
+    for (Pass &pass : m_passes) {
+        bool upstreamDirty = pass.upstream >= 0 && m_passes[pass.upstream].dirty;
+        if (!pass.dirty && ((pass.inputs & inputs) || upstreamDirty)) {
+            pass.dirty = true;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+void RenderGraph::markExecuted(int pass)
+{
+    m_passes[pass].dirty = false;
+    m_passes[pass].executed++;
+}
+
+void RenderGraph::markSkipped(int pass)
+{
+    m_passes[pass].skipped++;
+}
+
+void RenderGraph::markBypassed(int pass)
+{
+    // 더티로 남겨두면 하류 패스가 매번 같이 더티가 되므로 해제해 둡니다.
+    // 모드가 돌아오면 Input_RenderMode로 다시 더티가 됩니다.
+    m_passes[pass].dirty = false;
+    m_passes[pass].skipped++;
+}
@@ -0,0 +1,65 @@
+#ifndef RENDERGRAPH_H
+#define RENDERGRAPH_H
+
+#include <QtGlobal>
+#include <vector>
+
+// 패스가 의존하는 입력 종류 (비트 플래그)
+enum RenderInput : quint32 {
+    Input_Camera      = 1u << 0,  // 뷰 행렬
+    Input_SplatData   = 1u << 1,  // 업로드된 스플랫 데이터
+    Input_GlobalScale = 1u << 2,  // uGlobalScale
+    Input_AlphaCutoff = 1u << 3,  // uAlphaCutoff
+    Input_Sharpness   = 1u << 4,  // RCAS 샤프니스
+    Input_FilterMode  = 1u << 5,  // Linear/Nearest, FSR on/off
+    Input_WindowSize  = 1u << 6,  // 화면(출력) 크기
+    Input_RenderMode  = 1u << 7,  // 정렬 합성 / OIT 등 스플랫 패스 방식
+    Input_SceneLayout = 1u << 8,  // 씬별 모델 행렬 / 표시 여부
+    Input_Jitter      = 1u << 9,  // 시간적 업스케일의 서브픽셀 투영 지터
+    Input_DrawBudget  = 1u << 10, // 점진적 정제의 중요도 접두부 크기
+    Input_DepthPrepass = 1u << 11, // 깊이 프리패스 on/off, 코어 불투명도 임계값
+    Input_OcclusionCulling = 1u << 12, // 클러스터 가림 컬링 on/off (정렬 결과가 바뀜)
+
+    Input_All         = 0xFFFFFFFFu
+};
+
+// 더티 트래킹 렌더 그래프
+// 각 패스는 자신이 읽는 입력과 상류(upstream) 패스를 선언합니다.
+// 입력이 바뀌면 해당 패스와 그 하류 패스만 더티가 되고,
+// 더티가 아닌 패스는 이전 결과(FBO 등)를 그대로 재사용합니다.
+class RenderGraph
+{
+public:
+    // 패스 등록. upstream은 먼저 등록된 패스여야 합니다 (위상 순서 유지).
+    int addPass(const char *name, quint32 inputs, int upstream = -1);
+
+    // 바뀐 입력을 알림. 새로 더티가 된 패스가 있으면 true
+    bool invalidate(quint32 inputs);
+    void invalidateAll() { invalidate(Input_All); }
+
+    bool isDirty(int pass) const { return m_passes[pass].dirty; }
+
+    // 패스를 실행했으면 markExecuted, 캐시를 재사용했으면 markSkipped
+    void markExecuted(int pass);
+    void markSkipped(int pass);
+    // 현재 모드에서 결과가 필요 없는 패스 (실행하지 않고 더티만 해제)
+    void markBypassed(int pass);
+
+    const char *passName(int pass) const { return m_passes[pass].name; }
+    quint64 executedCount(int pass) const { return m_passes[pass].executed; }
+    quint64 skippedCount(int pass) const { return m_passes[pass].skipped; }
+
+private:
+    struct Pass {
+        const char *name;
+        quint32 inputs;
+        int upstream;
+        bool dirty;
+        quint64 executed;
+        quint64 skipped;
+    };
+
+    std::vector<Pass> m_passes;
+};
+
+#endif // RENDERGRAPH_H
@@ -0,0 +1,256 @@
+// 작업 스케줄러 확장성 벤치마크
+//
+//   Switch2ScalingBench [scene.ply] [--splats 5000000] [--max-threads N] [--runs 3] [--views 8] [--pin] [--trace]
+//
+// 스레드 수 1, 2, 4, ..., N마다 스케줄러를 다시 구성하고
+//  - 로드: PlyLoader::loadPly (블록 읽기 + 병렬 디코딩)
+//  - 준비: SplatScene::reorderSpatially (Morton 재배치 -> 가지치기 인덱스/BVH를 병렬로 만드는 작업 그래프)
+//  - 정렬: SplatScene::sortBackToFront를 서로 다른 시점 views개에 대해
+// 을 runs번씩 재서 가장 빠른 값과 1스레드 대비 속도 향상/효율을 출력합니다.
+// 파일을 주지 않으면 --splats개의 합성 스플랫으로 임시 PLY를 만들어 씁니다 (500만 개 = 약 1.2GB).
+// 첫 측정 전에 한 번 읽어 두므로 로드 시간은 디스크보다 디코딩 확장성을 봅니다 (OS 파일 캐시에 들어갈 때).
+// 가장 많은 스레드에서의 준비 그래프 단계별 시간도 출력합니다.
+// --trace: 가장 많은 스레드에서 작업 이름별 개수/합계/최대 시간 (작업 시간 훅)
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QTemporaryFile>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QtMath>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "PlyLoader.h"
+#include "SplatScene.h"
+#include "TaskScheduler.h"
+
+namespace {
+
+// 표준 3DGS 레이아웃의 합성 PLY (위치는 정육면체 안에 고르게, 나머지는 학습 결과 범위의 값)
+bool writeSyntheticPly(QFile &file, qint64 count)
+{
+    QByteArray header = "ply\nformat binary_little_endian 1.0\n";
+    header += "element vertex " + QByteArray::number(count) + "\n";
+    QList<QByteArray> names = { "x", "y", "z", "nx", "ny", "nz", "f_dc_0", "f_dc_1", "f_dc_2" };
+    for (int i = 0; i < 45; ++i) names << "f_rest_" + QByteArray::number(i);
+    names << "opacity" << "scale_0" << "scale_1" << "scale_2" << "rot_0" << "rot_1" << "rot_2" << "rot_3";
+    for (const QByteArray &name : names) header += "property float " + name + "\n";
+    header += "end_header\n";
+    if (file.write(header) != header.size()) return false;
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::vector<float> block;
+    const qint64 BLOCK = 65536;
+    for (qint64 first = 0; first < count; first += BLOCK) {
+        const qint64 n = std::min(BLOCK, count - first);
+        block.assign(size_t(n) * PlyLoader::FLOATS_PER_VERTEX, 0.0f);
+        for (qint64 i = 0; i < n; ++i) {
+            float *v = block.data() + i * PlyLoader::FLOATS_PER_VERTEX;
+            for (int a = 0; a < 3; ++a) v[a] = unit(rng) * 10.0f;
+            for (int c = 6; c < 54; ++c) v[c] = unit(rng);
+            v[54] = unit(rng) * 4.0f;
+            for (int a = 55; a < 58; ++a) v[a] = -4.0f + unit(rng);
+            for (int a = 58; a < 62; ++a) v[a] = unit(rng);
+        }
+        const qint64 bytes = qint64(block.size() * sizeof(float));
+        if (file.write(reinterpret_cast<const char *>(block.data()), bytes) != bytes) return false;
+    }
+    return file.flush();
+}
+
+struct Measurement {
+    int threads = 0;
+    double loadMs = 0.0;
+    double prepareMs = 0.0;
+    double sortMs = 0.0; // 시점 하나당
+    qint64 steals = 0;
+};
+
+// --trace용 작업 이름별 합계
+struct TraceEntry {
+    qint64 count = 0;
+    qint64 totalNs = 0;
+    qint64 maxNs = 0;
+};
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("Switch2ScalingBench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Measure load and sort scaling of the task scheduler from 1 to N threads");
+    parser.addHelpOption();
+    parser.addPositionalArgument("scene", "Standard 3DGS PLY (optional, synthetic if omitted)", "[scene.ply]");
+    QCommandLineOption splatsOption("splats", "Synthetic splat count", "n", "5000000");
+    QCommandLineOption maxThreadsOption("max-threads", "Largest thread count (0 = hardware threads)", "n", "0");
+    QCommandLineOption runsOption("runs", "Runs per measurement (best is reported)", "n", "3");
+    QCommandLineOption viewsOption("views", "Camera views sorted per run", "n", "8");
+    QCommandLineOption pinOption("pin", "Pin pool threads to cores");
+    QCommandLineOption traceOption("trace", "Per-task timing summary at the largest thread count");
+    parser.addOption(splatsOption);
+    parser.addOption(maxThreadsOption);
+    parser.addOption(runsOption);
+    parser.addOption(viewsOption);
+    parser.addOption(pinOption);
+    parser.addOption(traceOption);
+    parser.process(app);
+
+    const int runs = std::max(1, parser.value(runsOption).toInt());
+    const int views = std::max(1, parser.value(viewsOption).toInt());
+    int maxThreads = parser.value(maxThreadsOption).toInt();
+    if (maxThreads <= 0) maxThreads = std::max(1, int(std::thread::hardware_concurrency()));
+
+    QString path;
+    QTemporaryFile synthetic;
+    const QStringList args = parser.positionalArguments();
+    if (!args.isEmpty()) {
+        path = args[0];
+    } else {
+        const qint64 count = std::max<qint64>(1, parser.value(splatsOption).toLongLong());
+        QElapsedTimer timer;
+        timer.start();
+        if (!synthetic.open() || !writeSyntheticPly(synthetic, count)) {
+            qCritical() << "Failed to write the synthetic PLY.";
+            return 1;
+        }
+        path = synthetic.fileName();
+        qInfo().noquote() << QString("Synthetic scene: %1 splats, %2 MB in %3 s")
+                                 .arg(count)
+                                 .arg(synthetic.size() / (1024.0 * 1024.0), 0, 'f', 0)
+                                 .arg(timer.elapsed() / 1000.0, 0, 'f', 1);
+    }
+
+    // 파일 캐시 데우기 + 정렬용 씬
+    std::vector<RenderSplat> splats;
+    PlyLoader loader;
+    if (!loader.loadPly(path, splats) || splats.empty()) {
+        qCritical() << "Failed to load" << path;
+        return 1;
+    }
+    const size_t splatCount = splats.size();
+    QVector3D bboxMin(splats[0].x, splats[0].y, splats[0].z), bboxMax = bboxMin;
+    for (const RenderSplat &s : splats) {
+        bboxMin = QVector3D(std::min(bboxMin.x(), s.x), std::min(bboxMin.y(), s.y), std::min(bboxMin.z(), s.z));
+        bboxMax = QVector3D(std::max(bboxMax.x(), s.x), std::max(bboxMax.y(), s.y), std::max(bboxMax.z(), s.z));
+    }
+    SplatScene scene("bench", std::move(splats));
+
+    // 씬 중심을 도는 시점들 (매번 다른 행이므로 정렬을 건너뛰지 않음)
+    const QVector3D center = (bboxMin + bboxMax) * 0.5f;
+    const float radius = std::max(1.0f, (bboxMax - bboxMin).length() * 1.25f);
+    std::vector<QMatrix4x4> viewMatrices(views);
+    for (int v = 0; v < views; ++v) {
+        const float angle = 2.0f * float(M_PI) * v / views;
+        viewMatrices[v].lookAt(center + QVector3D(std::cos(angle), 0.3f, std::sin(angle)) * radius, center,
+                               QVector3D(0, 1, 0));
+    }
+
+    std::vector<int> threadCounts;
+    for (int t = 1; t < maxThreads; t *= 2) threadCounts.push_back(t);
+    threadCounts.push_back(maxThreads);
+
+    TaskScheduler &scheduler = TaskScheduler::instance();
+    const TaskScheduler::Options original = scheduler.options();
+    std::vector<Measurement> results;
+
+    QMutex traceMutex;
+    QHash<QString, TraceEntry> trace;
+    QString prepareTiming;
+
+    for (int threads : threadCounts) {
+        TaskScheduler::Options options = original;
+        options.threadCount = threads;
+        options.pinThreads = parser.isSet(pinOption);
+        scheduler.configure(options);
+
+        const bool tracing = parser.isSet(traceOption) && threads == threadCounts.back();
+        if (tracing) {
+            scheduler.setTaskObserver([&traceMutex, &trace](const TaskTiming &timing) {
+                const qint64 ns = timing.endNs - timing.startNs;
+                QMutexLocker locker(&traceMutex);
+                TraceEntry &entry = trace[QString::fromLatin1(timing.name)];
+                ++entry.count;
+                entry.totalNs += ns;
+                entry.maxNs = std::max(entry.maxNs, ns);
+            });
+        }
+        scheduler.resetStats();
+
+        Measurement m;
+        m.threads = threads;
+        for (int r = 0; r < runs; ++r) {
+            std::vector<RenderSplat> loaded;
+            QElapsedTimer timer;
+            timer.start();
+            loader.loadPly(path, loaded);
+            const double loadMs = timer.nsecsElapsed() / 1.0e6;
+
+            // 뷰어가 로드 직후 하는 처리와 같음 (생성자의 가지치기 인덱스는 재배치 뒤 다시 만드므로 제외)
+            SplatScene prepared("prepare", std::move(loaded));
+            timer.restart();
+            prepared.reorderSpatially();
+            const double prepareMs = timer.nsecsElapsed() / 1.0e6;
+            prepareTiming = prepared.prepareTiming();
+
+            timer.restart();
+            for (const QMatrix4x4 &view : viewMatrices) scene.sortBackToFront(view);
+            const double sortMs = timer.nsecsElapsed() / 1.0e6 / views;
+
+            m.loadMs = (r == 0) ? loadMs : std::min(m.loadMs, loadMs);
+            m.prepareMs = (r == 0) ? prepareMs : std::min(m.prepareMs, prepareMs);
+            m.sortMs = (r == 0) ? sortMs : std::min(m.sortMs, sortMs);
+        }
+        for (const TaskScheduler::WorkerStats &stats : scheduler.stats()) m.steals += stats.steals;
+        if (tracing) scheduler.setTaskObserver(nullptr);
+        results.push_back(m);
+
+        qInfo().noquote() << QString("%1 threads: load %2 ms, prepare %3 ms, sort %4 ms/view, %5 steals")
+                                 .arg(threads)
+                                 .arg(m.loadMs, 0, 'f', 1)
+                                 .arg(m.prepareMs, 0, 'f', 1)
+                                 .arg(m.sortMs, 0, 'f', 2)
+                                 .arg(m.steals);
+    }
+    scheduler.configure(original);
+
+    const Measurement &base = results.front();
+    qInfo().noquote() << QString("\n%1 splats, best of %2 runs, %3 views").arg(splatCount).arg(runs).arg(views);
+    qInfo().noquote() << "threads | load ms | speedup | eff   | prep ms | speedup | eff   | sort ms | speedup | eff";
+    for (const Measurement &m : results) {
+        const double loadSpeedup = base.loadMs / m.loadMs;
+        const double prepareSpeedup = base.prepareMs / m.prepareMs;
+        const double sortSpeedup = base.sortMs / m.sortMs;
+        qInfo().noquote() << QString("%1 | %2 | %3x | %4% | %5 | %6x | %7% | %8 | %9x | %10%")
+                                 .arg(m.threads, 7)
+                                 .arg(m.loadMs, 7, 'f', 1)
+                                 .arg(loadSpeedup, 6, 'f', 2)
+                                 .arg(100.0 * loadSpeedup / m.threads, 4, 'f', 0)
+                                 .arg(m.prepareMs, 7, 'f', 1)
+                                 .arg(prepareSpeedup, 6, 'f', 2)
+                                 .arg(100.0 * prepareSpeedup / m.threads, 4, 'f', 0)
+                                 .arg(m.sortMs, 7, 'f', 2)
+                                 .arg(sortSpeedup, 6, 'f', 2)
+                                 .arg(100.0 * sortSpeedup / m.threads, 4, 'f', 0);
+    }
+    qInfo().noquote() << QString("\nPrepare graph at %1 threads: %2").arg(threadCounts.back()).arg(prepareTiming);
+
+    if (!trace.isEmpty()) {
+        qInfo().noquote() << QString("\nTasks at %1 threads:").arg(threadCounts.back());
+        for (auto it = trace.constBegin(); it != trace.constEnd(); ++it) {
+            qInfo().noquote() << QString("  %1: %2 tasks, total %3 ms, avg %4 us, max %5 us")
+                                     .arg(it.key())
+                                     .arg(it.value().count)
+                                     .arg(it.value().totalNs / 1.0e6, 0, 'f', 1)
+                                     .arg(it.value().totalNs / 1.0e3 / it.value().count, 0, 'f', 1)
+                                     .arg(it.value().maxNs / 1.0e3, 0, 'f', 1);
+        }
+    }
+    return 0;
+}
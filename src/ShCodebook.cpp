@@ -0,0 +1,359 @@
+#include "ShCodebook.h"
+#include "Parallel.h"
+#include <QFile>
+#include <QtEndian>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+
+namespace {
+
+const int D = ShPalette::COEFFS;
+const int COEFFS_PER_CHANNEL = 15;
+
+const char VQ_MAGIC[4] = { 'S', '2', 'V', 'Q' };
+const quint32 VQ_VERSION = 1;
+
+// 파일의 필드는 모두 리틀 엔디언으로 하나씩 읽고 씀 (구조체 배치/패딩, 호스트 엔디언과 무관)
+const qint64 VQ_HEADER_BYTES = 20;
+const int SPLAT_RECORD_FLOATS = 14; // x y z, r g b, opacity, scale 3, rot 4
+const qint64 SPLAT_RECORD_BYTES = SPLAT_RECORD_FLOATS * 4;
+const size_t IO_BLOCK_SPLATS = 65536;
+
+void packSplat(const RenderSplat &s, char *out)
+{
+    const float v[SPLAT_RECORD_FLOATS] = { s.x, s.y, s.z, s.r, s.g, s.b, s.opacity,
+                                           s.scale[0], s.scale[1], s.scale[2],
+                                           s.rot[0], s.rot[1], s.rot[2], s.rot[3] };
+    for (int k = 0; k < SPLAT_RECORD_FLOATS; ++k) qToLittleEndian<float>(v[k], out + 4 * k);
+}
+
+void unpackSplat(const char *rec, RenderSplat &s)
+{
+    auto f = [rec](int k) { return qFromLittleEndian<float>(rec + 4 * k); };
+    s.x = f(0); s.y = f(1); s.z = f(2);
+    s.r = f(3); s.g = f(4); s.b = f(5);
+    s.opacity = f(6);
+    for (int k = 0; k < 3; ++k) s.scale[k] = f(7 + k);
+    for (int k = 0; k < 4; ++k) s.rot[k] = f(10 + k);
+}
+
+float squaredDistance(const float *a, const float *b)
+{
+    float sum = 0.0f;
+    for (int d = 0; d < D; ++d) {
+        float diff = a[d] - b[d];
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+// 가장 가까운 코드북 항목 (단순 전수 탐색, D=45라 캐시에 잘 맞음)
+int nearestEntry(const float *x, const std::vector<float> &codebook, int k, float *outDist = nullptr)
+{
+    int best = 0;
+    float bestDist = std::numeric_limits<float>::max();
+    for (int c = 0; c < k; ++c) {
+        float dist = squaredDistance(x, &codebook[size_t(c) * D]);
+        if (dist < bestDist) {
+            bestDist = dist;
+            best = c;
+        }
+    }
+    if (outDist) *outDist = bestDist;
+    return best;
+}
+
+// 구면 위에 고르게 퍼진 방향 (Fibonacci sphere)
+std::vector<QVector3D> sphereDirections(int count)
+{
+    std::vector<QVector3D> dirs;
+    const float golden = 3.14159265f * (3.0f - std::sqrt(5.0f));
+    for (int i = 0; i < count; ++i) {
+        float y = 1.0f - 2.0f * (i + 0.5f) / count;
+        float r = std::sqrt(std::max(0.0f, 1.0f - y * y));
+        float phi = golden * i;
+        dirs.emplace_back(r * std::cos(phi), y, r * std::sin(phi));
+    }
+    return dirs;
+}
+
+float clamp01(float v) { return std::min(1.0f, std::max(0.0f, v)); }
+
+} // namespace
+
+QVector3D ShCodebook::evaluate(const float *coeffs, const QVector3D &dir)
+{
+    // 3DGS 레퍼런스 구현과 같은 실수 SH 기저 (1~3차)
+    const float C1 = 0.4886025119029199f;
+    const float C2[5] = { 1.0925484305920792f, -1.0925484305920792f, 0.31539156525252005f,
+                          -1.0925484305920792f, 0.5462742152960396f };
+    const float C3[7] = { -0.5900435899266435f, 2.890611442640554f, -0.4570457994644658f, 0.3731763325901154f,
+                          -0.4570457994644658f, 1.445305721320277f, -0.5900435899266435f };
+
+    const float x = dir.x(), y = dir.y(), z = dir.z();
+    const float xx = x * x, yy = y * y, zz = z * z;
+    const float basis[COEFFS_PER_CHANNEL] = {
+        -C1 * y, C1 * z, -C1 * x,
+        C2[0] * x * y, C2[1] * y * z, C2[2] * (2.0f * zz - xx - yy), C2[3] * x * z, C2[4] * (xx - yy),
+        C3[0] * y * (3.0f * xx - yy), C3[1] * x * y * z, C3[2] * y * (4.0f * zz - xx - yy),
+        C3[3] * z * (2.0f * zz - 3.0f * xx - 3.0f * yy), C3[4] * x * (4.0f * zz - xx - yy),
+        C3[5] * z * (xx - yy), C3[6] * x * (xx - 3.0f * yy)
+    };
+
+    float rgb[3] = { 0.0f, 0.0f, 0.0f };
+    for (int ch = 0; ch < 3; ++ch) {
+        const float *c = coeffs + ch * COEFFS_PER_CHANNEL;
+        for (int i = 0; i < COEFFS_PER_CHANNEL; ++i) rgb[ch] += basis[i] * c[i];
+    }
+    return QVector3D(rgb[0], rgb[1], rgb[2]);
+}
+
+ShPalette ShCodebook::train(const std::vector<float> &shRest, const TrainParams &params)
+{
+    ShPalette palette;
+    const size_t n = shRest.size() / D;
+    if (n == 0) return palette;
+
+    const int k = static_cast<int>(std::min<size_t>(std::min(params.codebookSize, 65536), n));
+    std::mt19937 rng(params.seed);
+    QElapsedTimer timer;
+    timer.start();
+
+    // 1. k-means++ 초기화 (전체 대신 표본 풀에서)
+    const size_t poolSize = std::min<size_t>(n, size_t(k) * std::max(1, params.seedPoolPerEntry));
+    std::vector<size_t> pool(poolSize);
+    if (poolSize == n) {
+        for (size_t i = 0; i < n; ++i) pool[i] = i;
+    } else {
+        std::uniform_int_distribution<size_t> pick(0, n - 1);
+        for (size_t &p : pool) p = pick(rng);
+    }
+
+    std::vector<float> &codebook = palette.codebook;
+    codebook.resize(size_t(k) * D);
+    auto copyEntry = [&](int c, size_t point) {
+        std::memcpy(&codebook[size_t(c) * D], &shRest[point * D], D * sizeof(float));
+    };
+
+    copyEntry(0, pool[std::uniform_int_distribution<size_t>(0, poolSize - 1)(rng)]);
+    std::vector<float> minDist(poolSize, std::numeric_limits<float>::max());
+    for (int c = 1; c < k; ++c) {
+        // 새로 추가된 중심까지의 거리로 최소 거리 갱신 (병렬)
+        const float *last = &codebook[size_t(c - 1) * D];
+        parallelForRange(0, poolSize, 4096, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                minDist[i] = std::min(minDist[i], squaredDistance(&shRest[pool[i] * D], last));
+            }
+        });
+
+        // D^2 가중 확률로 다음 중심 선택
+        double total = 0.0;
+        for (float d : minDist) total += d;
+        size_t chosen = 0;
+        if (total > 0.0) {
+            double target = std::uniform_real_distribution<double>(0.0, total)(rng);
+            for (size_t i = 0; i < poolSize; ++i) {
+                target -= minDist[i];
+                if (target <= 0.0) { chosen = i; break; }
+            }
+        } else {
+            chosen = std::uniform_int_distribution<size_t>(0, poolSize - 1)(rng);
+        }
+        copyEntry(c, pool[chosen]);
+    }
+    qDebug() << "k-means++ init:" << k << "entries from" << poolSize << "samples in" << timer.elapsed() << "ms";
+
+    // 2. 미니배치 k-means (Sculley 2010): 배치 배정은 병렬, 중심 갱신은 항목별 학습률 1/count
+    std::vector<quint32> counts(k, 0);
+    std::vector<size_t> batch(std::min<size_t>(n, std::max(1, params.batchSize)));
+    std::vector<int> batchAssign(batch.size());
+    std::uniform_int_distribution<size_t> pickPoint(0, n - 1);
+
+    for (int it = 0; it < params.iterations; ++it) {
+        for (size_t &b : batch) b = pickPoint(rng);
+
+        parallelForRange(0, batch.size(), 256, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) batchAssign[i] = nearestEntry(&shRest[batch[i] * D], codebook, k);
+        });
+
+        for (size_t i = 0; i < batch.size(); ++i) {
+            const int c = batchAssign[i];
+            const float eta = 1.0f / float(++counts[c]);
+            float *center = &codebook[size_t(c) * D];
+            const float *x = &shRest[batch[i] * D];
+            for (int d = 0; d < D; ++d) center[d] += eta * (x[d] - center[d]);
+        }
+    }
+    qDebug() << "Mini-batch k-means:" << params.iterations << "x" << batch.size() << "in" << timer.elapsed() << "ms";
+
+    // 3. 전체 배정 (병렬)
+    palette.indices.resize(n);
+    parallelForRange(0, n, 1024, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            palette.indices[i] = quint16(nearestEntry(&shRest[i * D], codebook, k));
+        }
+    });
+    qDebug() << "Assigned" << n << "splats in" << timer.elapsed() << "ms total";
+
+    return palette;
+}
+
+double ShCodebook::colorPsnr(const std::vector<RenderSplat> &splats, const std::vector<float> &shRest,
+                             const ShPalette *quantized, int directionCount)
+{
+    const size_t n = splats.size();
+    if (n == 0 || shRest.size() < n * D) return 0.0;
+
+    const std::vector<QVector3D> dirs = sphereDirections(std::max(1, directionCount));
+
+    // 스레드별 부분합 후 합산
+    const int parts = parallelWorkerCount();
+    std::vector<double> partial(parts, 0.0);
+    parallelFor(0, parts, [&](int p) {
+        const size_t begin = n * p / parts, end = n * (p + 1) / parts;
+        double sum = 0.0;
+        for (size_t i = begin; i < end; ++i) {
+            const RenderSplat &s = splats[i];
+            const float *original = &shRest[i * D];
+            const float *approx = quantized ? quantized->entry(quantized->indices[i]) : nullptr;
+            for (const QVector3D &dir : dirs) {
+                QVector3D a = ShCodebook::evaluate(original, dir);
+                QVector3D b = approx ? ShCodebook::evaluate(approx, dir) : QVector3D(0, 0, 0);
+                const float ref[3] = { clamp01(s.r + a.x()), clamp01(s.g + a.y()), clamp01(s.b + a.z()) };
+                const float cmp[3] = { clamp01(s.r + b.x()), clamp01(s.g + b.y()), clamp01(s.b + b.z()) };
+                for (int ch = 0; ch < 3; ++ch) {
+                    double diff = ref[ch] - cmp[ch];
+                    sum += diff * diff;
+                }
+            }
+        }
+        partial[p] = sum;
+    });
+
+    double total = 0.0;
+    for (double v : partial) total += v;
+    const double mse = total / (double(n) * dirs.size() * 3.0);
+    return mse > 0.0 ? 10.0 * std::log10(1.0 / mse) : 99.0;
+}
+
+bool ShCodebook::save(const QString &filePath, const std::vector<RenderSplat> &splats, const ShPalette &palette)
+{
+    if (palette.indices.size() != splats.size()) {
+        qCritical() << "SH index count does not match splat count";
+        return false;
+    }
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCritical() << "Failed to open file for writing:" << filePath;
+        return false;
+    }
+
+    QByteArray buffer(VQ_HEADER_BYTES, '\0');
+    std::memcpy(buffer.data(), VQ_MAGIC, 4);
+    qToLittleEndian<quint32>(VQ_VERSION, buffer.data() + 4);
+    qToLittleEndian<quint32>(quint32(splats.size()), buffer.data() + 8);
+    qToLittleEndian<quint32>(quint32(D), buffer.data() + 12);
+    qToLittleEndian<quint32>(quint32(palette.entryCount()), buffer.data() + 16);
+    bool ok = file.write(buffer) == buffer.size();
+
+    for (size_t first = 0; ok && first < splats.size(); first += IO_BLOCK_SPLATS) {
+        const size_t n = std::min(IO_BLOCK_SPLATS, splats.size() - first);
+        buffer.resize(qint64(n) * SPLAT_RECORD_BYTES);
+        for (size_t i = 0; i < n; ++i) packSplat(splats[first + i], buffer.data() + i * SPLAT_RECORD_BYTES);
+        ok = file.write(buffer) == buffer.size();
+    }
+
+    if (ok) {
+        buffer.resize(qint64(palette.codebook.size()) * 4);
+        for (size_t i = 0; i < palette.codebook.size(); ++i) {
+            qToLittleEndian<float>(palette.codebook[i], buffer.data() + 4 * i);
+        }
+        ok = file.write(buffer) == buffer.size();
+    }
+    if (ok) {
+        buffer.resize(qint64(palette.indices.size()) * 2);
+        for (size_t i = 0; i < palette.indices.size(); ++i) {
+            qToLittleEndian<quint16>(palette.indices[i], buffer.data() + 2 * i);
+        }
+        ok = file.write(buffer) == buffer.size();
+    }
+    ok = ok && file.flush();
+    if (!ok) qCritical() << "Failed to write" << filePath;
+    return ok;
+}
+
+bool ShCodebook::load(const QString &filePath, std::vector<RenderSplat> &splats, ShPalette &palette)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCritical() << "Failed to open file:" << filePath;
+        return false;
+    }
+
+    QByteArray buffer = file.read(VQ_HEADER_BYTES);
+    if (buffer.size() != VQ_HEADER_BYTES || std::memcmp(buffer.constData(), VQ_MAGIC, 4) != 0
+        || qFromLittleEndian<quint32>(buffer.constData() + 4) != VQ_VERSION
+        || qFromLittleEndian<quint32>(buffer.constData() + 12) != quint32(D)) {
+        qCritical() << "Invalid SH codebook scene file:" << filePath;
+        return false;
+    }
+    const quint32 splatCount = qFromLittleEndian<quint32>(buffer.constData() + 8);
+    const quint32 entryCount = qFromLittleEndian<quint32>(buffer.constData() + 16);
+
+    // 헤더의 개수를 믿고 할당하기 전에 파일 크기와 맞는지 확인
+    const qint64 expected = VQ_HEADER_BYTES + qint64(splatCount) * (SPLAT_RECORD_BYTES + 2)
+                            + qint64(entryCount) * D * 4;
+    if (expected != file.size()) {
+        qCritical() << "SH codebook scene header (" << splatCount << "splats," << entryCount << "entries) needs"
+                    << expected << "bytes but" << filePath << "has" << file.size();
+        return false;
+    }
+
+    splats.resize(splatCount);
+    palette.codebook.resize(size_t(entryCount) * D);
+    palette.indices.resize(splatCount);
+
+    bool ok = true;
+    for (size_t first = 0; ok && first < splats.size(); first += IO_BLOCK_SPLATS) {
+        const size_t n = std::min(IO_BLOCK_SPLATS, splats.size() - first);
+        buffer = file.read(qint64(n) * SPLAT_RECORD_BYTES);
+        ok = buffer.size() == qint64(n) * SPLAT_RECORD_BYTES;
+        for (size_t i = 0; ok && i < n; ++i) {
+            unpackSplat(buffer.constData() + i * SPLAT_RECORD_BYTES, splats[first + i]);
+        }
+    }
+    if (ok) {
+        buffer = file.read(qint64(palette.codebook.size()) * 4);
+        ok = buffer.size() == qint64(palette.codebook.size()) * 4;
+        for (size_t i = 0; ok && i < palette.codebook.size(); ++i) {
+            palette.codebook[i] = qFromLittleEndian<float>(buffer.constData() + 4 * i);
+        }
+    }
+    if (ok) {
+        buffer = file.read(qint64(palette.indices.size()) * 2);
+        ok = buffer.size() == qint64(palette.indices.size()) * 2;
+        for (size_t i = 0; ok && i < palette.indices.size(); ++i) {
+            palette.indices[i] = qFromLittleEndian<quint16>(buffer.constData() + 2 * i);
+        }
+    }
+    if (!ok) {
+        qCritical() << "Truncated SH codebook scene file:" << filePath;
+        return false;
+    }
+
+    for (quint16 index : palette.indices) {
+        if (index >= entryCount) {
+            qCritical() << "SH index out of range in" << filePath;
+            return false;
+        }
+    }
+
+    qDebug() << "Loaded" << splats.size() << "splats with" << entryCount << "SH codebook entries";
+    return true;
+}
@@ -0,0 +1,56 @@
+#ifndef SHCODEBOOK_H
+#define SHCODEBOOK_H
+
+#include <QString>
+#include <QVector3D>
+#include <vector>
+#include "GaussianData.h"
+
+// 벡터 양자화(VQ)된 SH 계수
+// 스플랫마다 f_rest 45개(180바이트) 대신 코드북 인덱스 하나(2바이트)만 저장합니다.
+//
+// 계수 배치는 PLY의 f_rest 순서 그대로: [R 계수 15개][G 15개][B 15개]
+struct ShPalette {
+    static const int COEFFS = 45;
+
+    std::vector<float> codebook;   // entryCount() * COEFFS
+    std::vector<quint16> indices;  // 스플랫마다 하나
+
+    int entryCount() const { return static_cast<int>(codebook.size() / COEFFS); }
+    bool isEmpty() const { return codebook.empty() || indices.empty(); }
+    const float *entry(int i) const { return &codebook[size_t(i) * COEFFS]; }
+};
+
+namespace ShCodebook
+{
+    struct TrainParams {
+        int codebookSize = 1024;   // 최대 65536 (인덱스 16비트)
+        int batchSize = 4096;      // 미니배치 크기
+        int iterations = 100;      // 미니배치 반복 횟수
+        int seedPoolPerEntry = 16; // k-means++ 초기화에 쓸 표본 수 (코드북 크기의 배수)
+        quint32 seed = 1;
+    };
+
+    // k-means++ 초기화 + 미니배치 k-means로 코드북을 만들고 모든 스플랫에 가장 가까운 항목을 배정
+    // shRest: 스플랫마다 COEFFS개 (PlyLoader::loadPly의 outShRest)
+    ShPalette train(const std::vector<float> &shRest, const TrainParams &params);
+
+    // 1~3차 SH 항 (DC 제외)을 방향 dir(정규화, 스플랫 -> 카메라 반대 방향)에 대해 평가
+    QVector3D evaluate(const float *coeffs, const QVector3D &dir);
+
+    // 원본과 양자화된 SH로 계산한 시점별 색의 PSNR (dB)
+    // directionCount개 방향에서 각 스플랫 색(DC + SH, [0, 1] 클램프)을 비교합니다.
+    // quantized가 nullptr이면 SH를 버린 DC 색과 비교 (기준선)
+    double colorPsnr(const std::vector<RenderSplat> &splats, const std::vector<float> &shRest,
+                     const ShPalette *quantized, int directionCount = 14);
+
+    // 압축 씬 파일 (.s2vq, 모든 필드 리틀 엔디언)
+    //   Header : magic "S2VQ", version(u32), splatCount(u32), coeffCount(u32), entryCount(u32)
+    //   Body   : splatCount x { x, y, z, r, g, b, opacity, scale[3], rot[4] (f32 14개) },
+    //            f32 codebook[entryCount * coeffCount], u16 index[splatCount]
+    // load는 헤더의 개수가 파일 크기와 정확히 맞아야 받아들입니다.
+    bool save(const QString &filePath, const std::vector<RenderSplat> &splats, const ShPalette &palette);
+    bool load(const QString &filePath, std::vector<RenderSplat> &splats, ShPalette &palette);
+}
+
+#endif // SHCODEBOOK_H
@@ -0,0 +1,85 @@
+// SH 코드북 압축 도구 (오프라인)
+//
+//   Switch2ShVq input.ply output.s2vq [-k 1024] [--batch 4096] [--iterations 100]
+//
+// 표준 3DGS PLY의 f_rest(SH 1~3차, 스플랫당 180바이트)를 k-means 코드북 + 스플랫당 16비트 인덱스로 바꿔
+// .s2vq 파일로 저장합니다. 시점별 색 PSNR과 100만 스플랫당 압축 시간을 출력합니다.
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QDebug>
+#include "PlyLoader.h"
+#include "ShCodebook.h"
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("Switch2ShVq");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Vector-quantize SH coefficients of a 3DGS PLY into a codebook scene (.s2vq)");
+    parser.addHelpOption();
+    parser.addPositionalArgument("input", "Source PLY with f_rest_0..44");
+    parser.addPositionalArgument("output", "Compressed scene (.s2vq)");
+    QCommandLineOption codebookOption(QStringList{ "k", "codebook" }, "Codebook entries (max 65536)", "n", "1024");
+    QCommandLineOption batchOption("batch", "Mini-batch size", "n", "4096");
+    QCommandLineOption iterOption("iterations", "Mini-batch iterations", "n", "100");
+    parser.addOption(codebookOption);
+    parser.addOption(batchOption);
+    parser.addOption(iterOption);
+    parser.process(app);
+
+    const QStringList args = parser.positionalArguments();
+    if (args.size() != 2) parser.showHelp(1);
+
+    std::vector<RenderSplat> splats;
+    std::vector<float> shRest;
+    PlyLoader loader;
+    if (!loader.loadPly(args[0], splats, &shRest) || splats.empty()) {
+        qCritical() << "Failed to load PLY.";
+        return 1;
+    }
+
+    ShCodebook::TrainParams params;
+    params.codebookSize = parser.value(codebookOption).toInt();
+    params.batchSize = parser.value(batchOption).toInt();
+    params.iterations = parser.value(iterOption).toInt();
+    if (params.codebookSize < 1 || params.codebookSize > 65536 || params.batchSize < 1 || params.iterations < 0) {
+        qCritical() << "Invalid codebook/batch/iteration settings.";
+        return 1;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    ShPalette palette = ShCodebook::train(shRest, params);
+    const double compressMs = timer.nsecsElapsed() / 1.0e6;
+
+    if (!ShCodebook::save(args[1], splats, palette)) return 1;
+
+    // 품질: 원본 SH vs 코드북 SH (그리고 SH를 버렸을 때의 기준선)
+    const double psnr = ShCodebook::colorPsnr(splats, shRest, &palette);
+    const double dcOnlyPsnr = ShCodebook::colorPsnr(splats, shRest, nullptr);
+
+    const double millions = splats.size() / 1.0e6;
+    const double inputMB = QFileInfo(args[0]).size() / (1024.0 * 1024.0);
+    const double outputMB = QFileInfo(args[1]).size() / (1024.0 * 1024.0);
+    const double shBytesBefore = double(splats.size()) * ShPalette::COEFFS * sizeof(float);
+    const double shBytesAfter = double(palette.codebook.size()) * sizeof(float)
+                                + double(palette.indices.size()) * sizeof(quint16);
+
+    qInfo().noquote() << QString("Splats: %1, codebook: %2 entries").arg(splats.size()).arg(palette.entryCount());
+    qInfo().noquote() << QString("Size: %1 MB -> %2 MB (SH %3 MB -> %4 MB, %5x)")
+                             .arg(inputMB, 0, 'f', 1)
+                             .arg(outputMB, 0, 'f', 1)
+                             .arg(shBytesBefore / (1024.0 * 1024.0), 0, 'f', 1)
+                             .arg(shBytesAfter / (1024.0 * 1024.0), 0, 'f', 2)
+                             .arg(shBytesBefore / shBytesAfter, 0, 'f', 1);
+    qInfo().noquote() << QString("View-dependent color PSNR: %1 dB (DC only: %2 dB)")
+                             .arg(psnr, 0, 'f', 2)
+                             .arg(dcOnlyPsnr, 0, 'f', 2);
+    qInfo().noquote() << QString("Compression time: %1 ms (%2 ms per million splats)")
+                             .arg(compressMs, 0, 'f', 0)
+                             .arg(compressMs / millions, 0, 'f', 0);
+    return 0;
+}
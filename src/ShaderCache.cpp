@@ -0,0 +1,212 @@
+#include "ShaderCache.h"
+#include <QCryptographicHash>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QOpenGLContext>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QDebug>
+#include <cstring>
+
+// GL 4.1 / GL_ARB_get_program_binary (3.3 헤더에는 없을 수 있음)
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#endif
+#ifndef GL_PROGRAM_BINARY_LENGTH
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+#ifndef GL_NUM_PROGRAM_BINARY_FORMATS
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+
+namespace {
+
+const char BINARY_MAGIC[4] = { 'S', '2', 'P', 'B' };
+const quint32 BINARY_VERSION = 1;
+
+#pragma pack(push, 1)
+struct BinaryHeader {
+    char magic[4];
+    quint32 version;
+    quint32 format; // glGetProgramBinary가 돌려준 binaryFormat
+    quint32 length;
+};
+#pragma pack(pop)
+
+} // namespace
+
+void ShaderCache::initialize(const QString &cacheDir)
+{
+    if (m_initialized) return;
+    initializeOpenGLFunctions();
+    m_initialized = true;
+
+    QOpenGLContext *context = QOpenGLContext::currentContext();
+    const QSurfaceFormat format = context->format();
+    const bool core41 = format.majorVersion() > 4 || (format.majorVersion() == 4 && format.minorVersion() >= 1);
+    GLint binaryFormats = 0;
+    if (core41 || context->hasExtension("GL_ARB_get_program_binary")) {
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormats);
+    }
+    m_binarySupported = binaryFormats > 0 && !cacheDir.isEmpty();
+
+    // 같은 소스라도 드라이버가 다르면 바이너리가 호환되지 않으므로 키에 포함
+    m_driverId = QByteArray(reinterpret_cast<const char *>(glGetString(GL_VENDOR))) + "|"
+                 + QByteArray(reinterpret_cast<const char *>(glGetString(GL_RENDERER))) + "|"
+                 + QByteArray(reinterpret_cast<const char *>(glGetString(GL_VERSION)));
+
+    if (m_binarySupported) {
+        m_cacheDir = cacheDir;
+        if (!QDir().mkpath(m_cacheDir)) {
+            qWarning() << "Shader cache: cannot create" << m_cacheDir << "- binaries will not be cached";
+            m_binarySupported = false;
+        }
+    }
+    qDebug() << "Shader cache:" << (m_binarySupported ? m_cacheDir : QString("memory only"))
+             << "(" << binaryFormats << "binary formats )";
+}
+
+void ShaderCache::clear()
+{
+    for (QOpenGLShaderProgram *program : m_owned) delete program;
+    m_owned.clear();
+    m_programs.clear();
+}
+
+QString ShaderCache::defaultCacheDir()
+{
+    const QString base = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    return base.isEmpty() ? QString() : QDir(base).filePath("shaders");
+}
+
+QByteArray ShaderCache::withDefines(const char *source, const QByteArrayList &defines)
+{
+    const QByteArray text(source);
+    if (defines.isEmpty()) return text;
+
+    // GLSL은 #version이 첫 지시문이어야 하므로 그 줄 다음에 넣음
+    const qsizetype version = text.indexOf("#version");
+    const qsizetype lineEnd = version >= 0 ? text.indexOf("\n", version) : -1;
+    const qsizetype insertAt = lineEnd >= 0 ? lineEnd + 1 : 0;
+
+    QByteArray result = text.left(insertAt);
+    for (const QByteArray &define : defines) {
+        result += "#define ";
+        result += define;
+        result += "\n";
+    }
+    result += text.mid(insertAt);
+    return result;
+}
+
+QOpenGLShaderProgram *ShaderCache::program(const char *vertexSource, const char *fragmentSource,
+                                           const QByteArrayList &defines)
+{
+    const QByteArray vertex = withDefines(vertexSource, defines);
+    const QByteArray fragment = withDefines(fragmentSource, defines);
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(m_driverId);
+    hash.addData(vertex);
+    hash.addData("\n--fragment--\n");
+    hash.addData(fragment);
+    const QByteArray key = hash.result().toHex();
+
+    if (QOpenGLShaderProgram *cached = m_programs.value(key, nullptr)) {
+        ++m_stats.reused;
+        return cached;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    QOpenGLShaderProgram *program = new QOpenGLShaderProgram;
+    program->create();
+    const QString path = m_binarySupported ? QDir(m_cacheDir).filePath(QString::fromLatin1(key) + ".bin") : QString();
+
+    if (m_binarySupported && loadBinary(program, path)) {
+        ++m_stats.loaded;
+        m_stats.loadMs += timer.nsecsElapsed() / 1.0e6;
+    } else {
+        // 바이너리를 받으려면 링크 전에 힌트를 줘야 함
+        if (m_binarySupported) glProgramParameteri(program->programId(), GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        const bool ok = program->addShaderFromSourceCode(QOpenGLShader::Vertex, vertex)
+                        && program->addShaderFromSourceCode(QOpenGLShader::Fragment, fragment)
+                        && program->link();
+        if (!ok) {
+            qCritical() << "Shader build failed" << defines << ":" << program->log();
+            delete program;
+            return nullptr;
+        }
+        ++m_stats.compiled;
+        m_stats.compileMs += timer.nsecsElapsed() / 1.0e6;
+        if (m_binarySupported) saveBinary(program, path);
+    }
+
+    m_programs.insert(key, program);
+    m_owned.push_back(program);
+    return program;
+}
+
+bool ShaderCache::loadBinary(QOpenGLShaderProgram *program, const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+    const QByteArray data = file.readAll();
+
+    BinaryHeader header;
+    if (data.size() < qsizetype(sizeof(header))) return false;
+    std::memcpy(&header, data.constData(), sizeof(header));
+    if (std::memcmp(header.magic, BINARY_MAGIC, 4) != 0 || header.version != BINARY_VERSION
+        || qsizetype(sizeof(header) + header.length) != data.size()) {
+        qWarning() << "Shader cache: ignoring malformed" << path;
+        return false;
+    }
+
+    glProgramBinary(program->programId(), GLenum(header.format), data.constData() + sizeof(header),
+                    GLsizei(header.length));
+
+    // 셰이더를 붙이지 않은 프로그램의 link()는 GL_LINK_STATUS만 확인해 링크 상태를 맞춤
+    if (!program->link()) {
+        qDebug() << "Shader cache: driver rejected" << path << "- rebuilding from source";
+        return false;
+    }
+    return true;
+}
+
+void ShaderCache::saveBinary(QOpenGLShaderProgram *program, const QString &path)
+{
+    GLint length = 0;
+    glGetProgramiv(program->programId(), GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+
+    QByteArray data(qsizetype(sizeof(BinaryHeader)) + length, '\0');
+    GLenum binaryFormat = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(program->programId(), length, &written, &binaryFormat, data.data() + sizeof(BinaryHeader));
+    if (written <= 0) return;
+
+    BinaryHeader header;
+    std::memcpy(header.magic, BINARY_MAGIC, 4);
+    header.version = BINARY_VERSION;
+    header.format = quint32(binaryFormat);
+    header.length = quint32(written);
+    std::memcpy(data.data(), &header, sizeof(header));
+    data.resize(qsizetype(sizeof(header)) + written);
+
+    // 쓰는 도중에 죽어도 반쪽 파일이 남지 않게
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+        qWarning() << "Shader cache: failed to write" << path;
+    }
+}
+
+QString ShaderCache::statsString() const
+{
+    return QString("compiled %1 (%2 ms), from disk %3 (%4 ms), reused %5")
+        .arg(m_stats.compiled)
+        .arg(m_stats.compileMs, 0, 'f', 1)
+        .arg(m_stats.loaded)
+        .arg(m_stats.loadMs, 0, 'f', 1)
+        .arg(m_stats.reused);
+}
@@ -0,0 +1,59 @@
+#ifndef SHADERCACHE_H
+#define SHADERCACHE_H
+
+#include <QByteArray>
+#include <QByteArrayList>
+#include <QHash>
+#include <QString>
+#include <QOpenGLExtraFunctions>
+#include <QOpenGLShaderProgram>
+#include <vector>
+
+// 링크된 셰이더 프로그램 캐시
+// 메모리: (소스 + #define) 조합마다 프로그램을 하나씩 만들어 두고 재사용 (모드를 바꿔도 다시 컴파일하지 않음)
+// 디스크: glGetProgramBinary로 받은 바이너리를 드라이버(벤더/렌더러/버전)와 최종 소스의 SHA-1로 키를 잡아 저장하고,
+//         다음 실행부터는 glProgramBinary로 바로 올립니다. 드라이버가 바뀌면 키가 달라지므로 옛 파일은 쓰이지 않고,
+//         올리기에 실패하면(드라이버가 거부) 소스로 다시 빌드해 덮어씁니다.
+// GL 4.1 또는 GL_ARB_get_program_binary가 없으면 메모리 캐시만 씁니다.
+// 모든 호출은 컨텍스트가 current인 상태에서. 프로그램은 캐시가 소유합니다.
+class ShaderCache : protected QOpenGLExtraFunctions
+{
+public:
+    ~ShaderCache() { clear(); }
+
+    // cacheDir가 비어 있으면 디스크 캐시를 쓰지 않음
+    void initialize(const QString &cacheDir);
+    void clear(); // 메모리의 프로그램 삭제
+
+    // 실패하면 nullptr (로그는 qCritical)
+    QOpenGLShaderProgram *program(const char *vertexSource, const char *fragmentSource,
+                                  const QByteArrayList &defines = QByteArrayList());
+
+    // #version 줄 바로 다음에 "#define NAME" 줄들을 넣은 소스
+    static QByteArray withDefines(const char *source, const QByteArrayList &defines);
+    static QString defaultCacheDir(); // 앱 캐시 폴더 아래 shaders
+
+    struct Stats {
+        int compiled = 0; // 소스에서 빌드
+        int loaded = 0;   // 디스크 바이너리에서
+        int reused = 0;   // 메모리에 있던 것
+        double compileMs = 0.0;
+        double loadMs = 0.0;
+    };
+    const Stats &stats() const { return m_stats; }
+    QString statsString() const;
+
+private:
+    bool loadBinary(QOpenGLShaderProgram *program, const QString &path);
+    void saveBinary(QOpenGLShaderProgram *program, const QString &path);
+
+    bool m_initialized = false;
+    bool m_binarySupported = false;
+    QString m_cacheDir;
+    QByteArray m_driverId;
+    QHash<QByteArray, QOpenGLShaderProgram *> m_programs;
+    std::vector<QOpenGLShaderProgram *> m_owned;
+    Stats m_stats;
+};
+
+#endif // SHADERCACHE_H
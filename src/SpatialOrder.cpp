@@ -0,0 +1,144 @@
+#include "SpatialOrder.h"
+#include "Parallel.h"
+#include <QElapsedTimer>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 21비트 값의 각 비트 사이에 0을 두 개씩 끼워 넣음 (bit i -> bit 3i)
+quint64 expandBits21(quint32 v)
+{
+    quint64 x = v & 0x1FFFFFu;
+    x = (x | (x << 32)) & 0x001F00000000FFFFull;
+    x = (x | (x << 16)) & 0x001F0000FF0000FFull;
+    x = (x | (x << 8))  & 0x100F00F00F00F00Full;
+    x = (x | (x << 4))  & 0x10C30C30C30C30C3ull;
+    x = (x | (x << 2))  & 0x1249249249249249ull;
+    return x;
+}
+
+struct MortonKey {
+    quint64 code;
+    quint32 index;
+    bool operator<(const MortonKey &o) const { return code < o.code || (code == o.code && index < o.index); }
+};
+
+} // namespace
+
+quint64 SpatialOrder::mortonCode(quint32 x, quint32 y, quint32 z)
+{
+    return expandBits21(x) | (expandBits21(y) << 1) | (expandBits21(z) << 2);
+}
+
+std::vector<SplatCluster> SpatialOrder::reorderMorton(std::vector<RenderSplat> &splats, quint32 clusterSize,
+                                                      std::vector<quint32> *outOrder)
+{
+    if (splats.empty()) return {};
+
+    QElapsedTimer timer;
+    timer.start();
+    const size_t count = splats.size();
+    const size_t grain = 65536;
+
+    // 1. 씬 AABB (조각별 최소/최대 후 합침)
+    const int parts = parallelWorkerCount();
+    std::vector<QVector3D> partMin(parts, QVector3D(splats[0].x, splats[0].y, splats[0].z));
+    std::vector<QVector3D> partMax = partMin;
+    parallelFor(0, parts, [&](int p) {
+        size_t b = count * p / parts, e = count * (p + 1) / parts;
+        float mn[3] = { splats[0].x, splats[0].y, splats[0].z };
+        float mx[3] = { mn[0], mn[1], mn[2] };
+        for (size_t i = b; i < e; ++i) {
+            const float v[3] = { splats[i].x, splats[i].y, splats[i].z };
+            for (int a = 0; a < 3; ++a) {
+                mn[a] = std::min(mn[a], v[a]);
+                mx[a] = std::max(mx[a], v[a]);
+            }
+        }
+        partMin[p] = QVector3D(mn[0], mn[1], mn[2]);
+        partMax[p] = QVector3D(mx[0], mx[1], mx[2]);
+    });
+    QVector3D sceneMin = partMin[0], sceneMax = partMax[0];
+    for (int p = 1; p < parts; ++p) {
+        sceneMin = QVector3D(std::min(sceneMin.x(), partMin[p].x()), std::min(sceneMin.y(), partMin[p].y()),
+                             std::min(sceneMin.z(), partMin[p].z()));
+        sceneMax = QVector3D(std::max(sceneMax.x(), partMax[p].x()), std::max(sceneMax.y(), partMax[p].y()),
+                             std::max(sceneMax.z(), partMax[p].z()));
+    }
+
+    // 2. Morton 코드 (축별 21비트 양자화)
+    const float maxQ = float((1u << 21) - 1);
+    const QVector3D extent = sceneMax - sceneMin;
+    const float sx = extent.x() > 0 ? maxQ / extent.x() : 0.0f;
+    const float sy = extent.y() > 0 ? maxQ / extent.y() : 0.0f;
+    const float sz = extent.z() > 0 ? maxQ / extent.z() : 0.0f;
+
+    std::vector<MortonKey> keys(count);
+    parallelForRange(0, count, grain, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const RenderSplat &s = splats[i];
+            // NaN 위치는 0으로 (가지치기에서 어차피 빠짐)
+            auto quantize = [maxQ](float v) { return quint32(std::clamp(v == v ? v : 0.0f, 0.0f, maxQ)); };
+            keys[i].code = mortonCode(quantize((s.x - sceneMin.x()) * sx),
+                                      quantize((s.y - sceneMin.y()) * sy),
+                                      quantize((s.z - sceneMin.z()) * sz));
+            keys[i].index = quint32(i);
+        }
+    });
+
+    // 3. 정렬 후 재배치
+    parallelSort(keys);
+
+    std::vector<RenderSplat> reordered(count);
+    parallelForRange(0, count, grain, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) reordered[i] = splats[keys[i].index];
+    });
+    splats.swap(reordered);
+
+    if (outOrder) {
+        outOrder->resize(count);
+        for (size_t i = 0; i < count; ++i) (*outOrder)[i] = keys[i].index;
+    }
+
+    std::vector<SplatCluster> clusters = buildClusters(splats, clusterSize);
+
+    qDebug() << "Morton reorder:" << count << "splats," << clusters.size() << "clusters in"
+             << timer.elapsed() << "ms";
+    return clusters;
+}
+
+std::vector<SplatCluster> SpatialOrder::buildClusters(const std::vector<RenderSplat> &splats, quint32 clusterSize)
+{
+    clusterSize = std::max<quint32>(clusterSize, 1);
+    const size_t count = splats.size();
+    std::vector<SplatCluster> clusters((count + clusterSize - 1) / clusterSize);
+
+    parallelForRange(0, clusters.size(), 64, [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c) {
+            SplatCluster &cluster = clusters[c];
+            cluster.begin = quint32(c * clusterSize);
+            cluster.count = quint32(std::min<size_t>(clusterSize, count - cluster.begin));
+
+            const RenderSplat &first = splats[cluster.begin];
+            float mn[3] = { first.x, first.y, first.z };
+            float mx[3] = { first.x, first.y, first.z };
+            float maxScale = 0.0f;
+            for (quint32 i = cluster.begin; i < cluster.begin + cluster.count; ++i) {
+                const float v[3] = { splats[i].x, splats[i].y, splats[i].z };
+                for (int a = 0; a < 3; ++a) {
+                    mn[a] = std::min(mn[a], v[a]);
+                    mx[a] = std::max(mx[a], v[a]);
+                }
+                // NaN/Inf 스케일(가지치기 대상)은 무시
+                const float scale = std::max({ splats[i].scale[0], splats[i].scale[1], splats[i].scale[2] });
+                if (std::isfinite(scale)) maxScale = std::max(maxScale, scale);
+            }
+            cluster.bboxMin = QVector3D(mn[0], mn[1], mn[2]);
+            cluster.bboxMax = QVector3D(mx[0], mx[1], mx[2]);
+            cluster.maxScale = maxScale;
+        }
+    });
+    return clusters;
+}
@@ -0,0 +1,36 @@
+#ifndef SPATIALORDER_H
+#define SPATIALORDER_H
+
+#include <QVector3D>
+#include <vector>
+#include "GaussianData.h"
+
+// 공간적으로 연속된 스플랫 묶음 (Morton 정렬 후 연속 구간)
+// 정렬된 스플랫 배열의 [begin, begin + count) 범위와 그 AABB
+// AABB는 중심 위치만 담으므로, 스플랫이 차지하는 부피까지 보려면 maxScale만큼 넓혀야 합니다.
+struct SplatCluster {
+    QVector3D bboxMin;
+    QVector3D bboxMax;
+    quint32 begin = 0;
+    quint32 count = 0;
+    float maxScale = 0.0f; // 클러스터 안 스플랫의 가장 큰 축 스케일 (로컬 좌표)
+};
+
+// 로드 직후 스플랫을 공간 순서로 재배치
+// 학습 결과 파일의 순서는 공간적으로 무작위라서 깊이 키 계산, 컬링, GPU 정점 fetch 모두 캐시 효율이 나쁩니다.
+namespace SpatialOrder
+{
+    // 축마다 21비트로 양자화한 좌표를 비트 교차 -> 63비트 Morton(Z-order) 코드
+    quint64 mortonCode(quint32 x, quint32 y, quint32 z);
+
+    // 씬 AABB 기준 Morton 코드로 splats를 병렬 재정렬하고,
+    // 부산물로 clusterSize개씩 묶은 구간의 AABB를 돌려줍니다.
+    // outOrder가 있으면 새 위치 i에 온 스플랫의 원래 인덱스를 담습니다 (스플랫별 부가 데이터 재배치용).
+    std::vector<SplatCluster> reorderMorton(std::vector<RenderSplat> &splats, quint32 clusterSize = 1024,
+                                            std::vector<quint32> *outOrder = nullptr);
+
+    // 이미 공간 순서인 배열에서 구간 AABB만 계산
+    std::vector<SplatCluster> buildClusters(const std::vector<RenderSplat> &splats, quint32 clusterSize = 1024);
+}
+
+#endif // SPATIALORDER_H
@@ -0,0 +1,121 @@
+#include "SplatBvh.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+float SplatBvh::footprintRadius(const RenderSplat &s)
+{
+    // 셰이더는 scale.x, scale.y만 씀 (빌보드의 가로/세로 반폭)
+    const float r = std::max(s.scale[0], s.scale[1]);
+    return std::isfinite(r) && r > 0.0f ? r : 0.0f;
+}
+
+void SplatBvh::nodeBounds(const Node &node, float scale, float outMin[3], float outMax[3])
+{
+    const float pad = node.radius * scale;
+    for (int a = 0; a < 3; ++a) {
+        outMin[a] = node.centerMin[a] - pad;
+        outMax[a] = node.centerMax[a] + pad;
+    }
+}
+
+void SplatBvh::clear()
+{
+    m_nodes.clear();
+    m_nodes.shrink_to_fit();
+}
+
+void SplatBvh::build(const std::vector<RenderSplat> &splats)
+{
+    clear();
+    if (splats.empty()) return;
+
+    m_nodes.reserve(2 * (splats.size() / LEAF_SIZE + 1));
+    m_nodes.push_back(Node());
+    buildRange(splats, 0, 0, static_cast<quint32>(splats.size()));
+}
+
+void SplatBvh::buildRange(const std::vector<RenderSplat> &splats, quint32 nodeIndex, quint32 begin, quint32 end)
+{
+    if (end - begin <= quint32(LEAF_SIZE)) {
+        Node leaf;
+        for (int a = 0; a < 3; ++a) {
+            leaf.centerMin[a] = std::numeric_limits<float>::max();
+            leaf.centerMax[a] = -std::numeric_limits<float>::max();
+        }
+        leaf.radius = 0.0f;
+        for (quint32 i = begin; i < end; ++i) {
+            const RenderSplat &s = splats[i];
+            const float center[3] = { s.x, s.y, s.z };
+            for (int a = 0; a < 3; ++a) {
+                leaf.centerMin[a] = std::min(leaf.centerMin[a], center[a]);
+                leaf.centerMax[a] = std::max(leaf.centerMax[a], center[a]);
+            }
+            leaf.radius = std::max(leaf.radius, footprintRadius(s));
+        }
+        leaf.first = begin;
+        leaf.count = end - begin;
+        m_nodes[nodeIndex] = leaf;
+        return;
+    }
+
+    // 벡터가 커지면 참조가 무효가 되므로 인덱스로만 다룸
+    const quint32 left = static_cast<quint32>(m_nodes.size());
+    m_nodes.push_back(Node());
+    m_nodes.push_back(Node());
+    const quint32 mid = begin + (end - begin) / 2;
+    buildRange(splats, left, begin, mid);
+    buildRange(splats, left + 1, mid, end);
+
+    Node node;
+    const Node &a = m_nodes[left];
+    const Node &b = m_nodes[left + 1];
+    for (int i = 0; i < 3; ++i) {
+        node.centerMin[i] = std::min(a.centerMin[i], b.centerMin[i]);
+        node.centerMax[i] = std::max(a.centerMax[i], b.centerMax[i]);
+    }
+    node.radius = std::max(a.radius, b.radius);
+    node.first = left;
+    node.count = 0;
+    m_nodes[nodeIndex] = node;
+}
+
+bool SplatBvh::intersectBox(const Node &node, float scale, const QVector3D &origin, const QVector3D &invDir,
+                            float &tEnter)
+{
+    float bboxMin[3], bboxMax[3];
+    nodeBounds(node, scale, bboxMin, bboxMax);
+    float tMin = 0.0f;
+    float tMax = std::numeric_limits<float>::max();
+    for (int a = 0; a < 3; ++a) {
+        // 축과 평행한 광선은 invDir = +-inf -> t가 +-inf 또는 NaN. NaN은 min/max에서 무시되도록 순서 유지
+        float t0 = (bboxMin[a] - origin[a]) * invDir[a];
+        float t1 = (bboxMax[a] - origin[a]) * invDir[a];
+        if (t0 > t1) std::swap(t0, t1);
+        if (t0 > tMin) tMin = t0;
+        if (t1 < tMax) tMax = t1;
+        if (tMin > tMax) return false;
+    }
+    tEnter = tMin;
+    return true;
+}
+
+bool SplatBvh::intersectFootprint(const RenderSplat &s, const Billboard &billboard, const QVector3D &origin,
+                                  const QVector3D &dir, float &t, float &alpha)
+{
+    // 빌보드 평면 (중심을 지나고 법선 = right x up)과의 교점
+    const QVector3D center(s.x, s.y, s.z);
+    const float denom = QVector3D::dotProduct(dir, billboard.normal);
+    if (!(std::abs(denom) > 1e-12f)) return false;
+    t = QVector3D::dotProduct(center - origin, billboard.normal) / denom;
+
+    // 교점의 쿼드 좌표 (셰이더의 vQuadPos)
+    const QVector3D q = origin + dir * t - center;
+    const float u = QVector3D::dotProduct(q, billboard.right) / std::max(s.scale[0] * billboard.scale, 1e-12f);
+    const float v = QVector3D::dotProduct(q, billboard.up) / std::max(s.scale[1] * billboard.scale, 1e-12f);
+    const float distSq = u * u + v * v;
+    if (!(distSq <= 1.0f)) return false;
+
+    alpha = s.opacity * std::exp(-3.0f * distSq);
+    return true;
+}
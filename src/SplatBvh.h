@@ -0,0 +1,67 @@
+#ifndef SPLATBVH_H
+#define SPLATBVH_H
+
+#include <QVector3D>
+#include <vector>
+#include "GaussianData.h"
+
+// 스플랫 발자국 위의 BVH (피킹/영역 선택용, 씬 로컬 좌표)
+//
+// 셰이더는 스플랫을 카메라를 향한 빌보드(반폭 scale.x, scale.y x 전역 스케일, 회전 무시)로 그리므로
+// 발자국은 뷰마다 방향이 바뀌지만 항상 중심에서 max(scale.x, scale.y) x 전역 스케일 안에 있습니다.
+// 노드는 중심의 AABB와 그 반지름의 최댓값을 보관하고, 질의할 때 전역 스케일만큼 넓혀 씁니다 (슬라이더가 바뀌어도 재빌드 없음).
+// 잎은 LEAF_SIZE개 이하의 연속된 스플랫 구간입니다.
+// 씬은 로드 시 Morton 순서로 재배치되므로(SplatScene::reorderSpatially) 인덱스 구간을 반씩 나누는 것만으로
+// 공간적으로 뭉친 트리가 됩니다 (빌드 O(n), 인덱스 배열 없음). 순서가 무작위면 결과는 같고 속도만 느려집니다.
+// 노드는 전위 순서이고 형제가 붙어 있습니다 (왼쪽 = first, 오른쪽 = first + 1).
+class SplatBvh
+{
+public:
+    struct Node {
+        float centerMin[3];
+        quint32 first; // 내부 노드: 왼쪽 자식, 잎: 첫 스플랫 인덱스
+        float centerMax[3];
+        quint32 count; // 0이면 내부 노드
+        float radius;  // 구간 안 발자국 반지름의 최댓값 (전역 스케일 1 기준)
+    };
+    static const int LEAF_SIZE = 8;
+
+    // 셰이더가 래스터화하는 발자국: 중심 + (u * scale.x * right + v * scale.y * up) * scale, u^2 + v^2 <= 1
+    // right/up은 씬 로컬 공간의 단위 벡터 (뷰 행렬 1, 2열을 모델 역행렬로 옮긴 것), scale은 전역 스케일
+    // (씬 스케일은 로컬 공간으로 옮기면서 빠짐)
+    struct Billboard {
+        QVector3D right;
+        QVector3D up;
+        QVector3D normal;
+        float scale = 1.0f;
+    };
+
+    void build(const std::vector<RenderSplat> &splats);
+    void clear();
+    bool isEmpty() const { return m_nodes.empty(); }
+
+    const std::vector<Node> &nodes() const { return m_nodes; }
+    size_t memoryBytes() const { return m_nodes.size() * sizeof(Node); }
+
+    // 전역 스케일 scale에서 노드의 모든 발자국을 감싸는 AABB
+    static void nodeBounds(const Node &node, float scale, float outMin[3], float outMax[3]);
+
+    // 광선-AABB (slab, nodeBounds 기준). 교차하면 tEnter = max(0, 진입 t)
+    static bool intersectBox(const Node &node, float scale, const QVector3D &origin, const QVector3D &invDir,
+                             float &tEnter);
+
+    // 광선-발자국: 빌보드 평면과의 교점에서 렌더러와 같은 감쇠 opacity * exp(-3 r^2), r^2 <= 1 밖은 빗나감
+    // t는 dir 길이 단위
+    static bool intersectFootprint(const RenderSplat &s, const Billboard &billboard, const QVector3D &origin,
+                                   const QVector3D &dir, float &t, float &alpha);
+
+    // 발자국 반지름 (전역 스케일 1 기준, 어느 방향에서 봐도 중심에서 이 거리 안)
+    static float footprintRadius(const RenderSplat &s);
+
+private:
+    void buildRange(const std::vector<RenderSplat> &splats, quint32 nodeIndex, quint32 begin, quint32 end);
+
+    std::vector<Node> m_nodes;
+};
+
+#endif // SPLATBVH_H
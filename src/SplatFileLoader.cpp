@@ -0,0 +1,628 @@
+#include "SplatFileLoader.h"
+#include "PlyLoader.h"
+#include "ShCodebook.h"
+#include "Parallel.h"
+#include "TaskScheduler.h"
+#include "SplatScene.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+
+#ifdef S2S_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace {
+
+const float SH_C0 = 0.28209479177387814f;
+
+// 한 번에 읽을 블록 크기. 디코딩 스레드가 이전 블록을 처리하는 동안 다음 블록을 읽습니다.
+const qint64 BLOCK_BYTES = 8 * 1024 * 1024;
+
+float clamp01(float v) { return std::min(1.0f, std::max(0.0f, v)); }
+
+float unpackUnorm(quint32 value, int bits)
+{
+    const quint32 mask = (1u << bits) - 1;
+    return float(value & mask) / float(mask);
+}
+
+float lerp(float a, float b, float t) { return a + (b - a) * t; }
+
+// 고정 크기 레코드를 블록 단위로 스트리밍 디코딩
+// decode(record, index)는 여러 스레드에서 서로 다른 index로 동시에 호출됩니다.
+template <typename Decode>
+bool streamRecords(QFile &file, qint64 recordSize, size_t count, const Decode &decode)
+{
+    const size_t blockRecords = std::max<size_t>(1, size_t(BLOCK_BYTES / recordSize));
+    QByteArray buffers[2];
+    TaskGroup worker("block decode");
+    bool ok = true;
+
+    int current = 0;
+    for (size_t first = 0; first < count; first += blockRecords, current ^= 1) {
+        const size_t n = std::min(blockRecords, count - first);
+        const qint64 bytes = qint64(n) * recordSize;
+
+        // 이 버퍼를 쓰던 작업은 두 블록 전이므로 이미 끝났음 (아래 wait)
+        QByteArray &buffer = buffers[current];
+        buffer.resize(bytes);
+        if (file.read(buffer.data(), bytes) != bytes) {
+            qCritical() << "Unexpected end of file at record" << first;
+            ok = false;
+            break;
+        }
+
+        worker.wait();
+        worker.run([&decode, &buffer, first, n, recordSize] {
+            const char *data = buffer.constData();
+            parallelForRange(0, n, 16384, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) decode(data + i * recordSize, first + i);
+            });
+        });
+    }
+    worker.wait();
+    return ok;
+}
+
+// PLY 헤더 (compressed.ply 용)
+struct PlyProperty {
+    QByteArray name;
+    int size = 4;
+    int offset = 0;
+};
+
+struct PlyElement {
+    QByteArray name;
+    size_t count = 0;
+    std::vector<PlyProperty> properties;
+    int stride = 0;
+
+    int offsetOf(const char *property) const
+    {
+        for (const PlyProperty &p : properties) {
+            if (p.name == property) return p.offset;
+        }
+        return -1;
+    }
+};
+
+int plyTypeSize(const QByteArray &type)
+{
+    if (type == "char" || type == "uchar" || type == "int8" || type == "uint8") return 1;
+    if (type == "short" || type == "ushort" || type == "int16" || type == "uint16") return 2;
+    if (type == "double" || type == "float64") return 8;
+    return 4; // int, uint, float
+}
+
+bool readPlyHeader(QFile &file, std::vector<PlyElement> &elements)
+{
+    QByteArray first = file.readLine().trimmed();
+    if (first != "ply") return false;
+
+    bool binary = false;
+    while (!file.atEnd()) {
+        QByteArray line = file.readLine().trimmed();
+        if (line == "end_header") return binary;
+
+        QList<QByteArray> parts = line.split(' ');
+        if (line.startsWith("format binary_little_endian")) {
+            binary = true;
+        } else if (parts.size() >= 3 && parts[0] == "element") {
+            PlyElement element;
+            element.name = parts[1];
+            element.count = parts[2].toULongLong();
+            elements.push_back(element);
+        } else if (parts.size() >= 3 && parts[0] == "property" && !elements.empty()) {
+            PlyElement &element = elements.back();
+            PlyProperty property;
+            property.name = parts[2];
+            property.size = plyTypeSize(parts[1]);
+            property.offset = element.stride;
+            element.stride += property.size;
+            element.properties.push_back(property);
+        }
+    }
+    return false;
+}
+
+template <typename T>
+T readValue(const char *p)
+{
+    T v;
+    std::memcpy(&v, p, sizeof(T));
+    return v;
+}
+
+#ifdef S2S_HAVE_ZLIB
+// gzip 파일의 압축 해제 크기 상한 (-1 = 읽을 수 없음)
+// 트레일러의 ISIZE는 크기 mod 2^32이므로, deflate 최대 압축률(약 1032:1)로도 4GB를 넘을 수 없는 파일에서만 그대로 쓰고
+// 그보다 크면 압축률로 잡은 상한을 씀. gzopen은 압축되지 않은 파일도 그대로 읽으므로 그때는 파일 크기
+qint64 gzipPayloadBound(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) return -1;
+    const qint64 size = file.size();
+    const QByteArray magic = file.read(2);
+    if (magic.size() != 2 || quint8(magic[0]) != 0x1f || quint8(magic[1]) != 0x8b) return size;
+
+    const qint64 bound = size * 1032;
+    if (size < 18 || bound >= (qint64(1) << 32)) return bound;
+    if (!file.seek(size - 4)) return -1;
+    const QByteArray trailer = file.read(4);
+    return trailer.size() == 4 ? qint64(readValue<quint32>(trailer.constData())) : -1;
+}
+#endif
+
+} // namespace
+
+SplatFileLoader::Format SplatFileLoader::detectFormat(const QString &filePath)
+{
+    const QString suffix = QFileInfo(filePath).suffix().toLower();
+    if (suffix == "splat") return Format::Splat;
+    if (suffix == "spz") return Format::Spz;
+    if (suffix == "s2vq") return Format::ShVq;
+    if (suffix != "ply") return Format::Unknown;
+
+    // compressed.ply는 확장자가 같으므로 헤더의 chunk 요소로 구분
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) return Format::Unknown;
+    std::vector<PlyElement> elements;
+    readPlyHeader(file, elements);
+    for (const PlyElement &e : elements) {
+        if (e.name == "chunk") return Format::CompressedPly;
+    }
+    return Format::Ply;
+}
+
+QString SplatFileLoader::formatName(Format format)
+{
+    switch (format) {
+    case Format::Ply: return "PLY";
+    case Format::CompressedPly: return "Compressed PLY";
+    case Format::Splat: return ".splat";
+    case Format::Spz: return "SPZ";
+    case Format::ShVq: return "SH codebook (.s2vq)";
+    default: return "Unknown";
+    }
+}
+
+QString SplatFileLoader::fileDialogFilter()
+{
+    return "Splat Files (*.ply *.splat *.spz *.s2vq);;PLY Files (*.ply);;All Files (*)";
+}
+
+bool SplatFileLoader::load(const QString &filePath, std::vector<RenderSplat> &outSplats, ShPalette *outSh)
+{
+    if (outSh) *outSh = ShPalette();
+
+    switch (detectFormat(filePath)) {
+    case Format::Ply: {
+        PlyLoader loader;
+        return loader.loadPly(filePath, outSplats);
+    }
+    case Format::CompressedPly:
+        return loadCompressedPly(filePath, outSplats);
+    case Format::Splat:
+        return loadSplat(filePath, outSplats);
+    case Format::Spz:
+        return loadSpz(filePath, outSplats);
+    case Format::ShVq: {
+        ShPalette palette;
+        if (!ShCodebook::load(filePath, outSplats, palette)) return false;
+        if (outSh) *outSh = std::move(palette);
+        return true;
+    }
+    default:
+        qCritical() << "Unknown splat file format:" << filePath;
+        return false;
+    }
+}
+
+bool SplatFileLoader::loadSplat(const QString &filePath, std::vector<RenderSplat> &outSplats)
+{
+    // 32바이트 레코드: 위치 float3, 스케일 float3(선형), RGBA u8, 회전 u8x4 (w, x, y, z)
+    const qint64 RECORD = 32;
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCritical() << "Failed to open file:" << filePath;
+        return false;
+    }
+    if (file.size() % RECORD != 0) {
+        qWarning() << ".splat size is not a multiple of 32 bytes, trailing bytes ignored";
+    }
+
+    const size_t count = size_t(file.size() / RECORD);
+    outSplats.assign(count, RenderSplat());
+
+    bool ok = streamRecords(file, RECORD, count, [&outSplats](const char *rec, size_t i) {
+        RenderSplat &s = outSplats[i];
+        const quint8 *u = reinterpret_cast<const quint8 *>(rec + 24);
+
+        s.x = readValue<float>(rec + 0);
+        s.y = readValue<float>(rec + 4);
+        s.z = readValue<float>(rec + 8);
+        s.scale[0] = readValue<float>(rec + 12);
+        s.scale[1] = readValue<float>(rec + 16);
+        s.scale[2] = readValue<float>(rec + 20);
+
+        s.r = u[0] / 255.0f;
+        s.g = u[1] / 255.0f;
+        s.b = u[2] / 255.0f;
+        s.opacity = u[3] / 255.0f;
+        for (int k = 0; k < 4; ++k) s.rot[k] = (u[4 + k] - 128) / 128.0f;
+    });
+
+    qDebug() << "Loaded" << outSplats.size() << "splats from .splat";
+    return ok;
+}
+
+bool SplatFileLoader::loadCompressedPly(const QString &filePath, std::vector<RenderSplat> &outSplats)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCritical() << "Failed to open file:" << filePath;
+        return false;
+    }
+
+    std::vector<PlyElement> elements;
+    if (!readPlyHeader(file, elements) || elements.size() < 2
+        || elements[0].name != "chunk" || elements[1].name != "vertex") {
+        qCritical() << "Invalid compressed PLY header:" << filePath;
+        return false;
+    }
+    const PlyElement &chunkElem = elements[0];
+    const PlyElement &vertexElem = elements[1];
+
+    // 헤더의 개수를 믿고 할당하기 전에 남은 파일 크기에 들어가는지 확인 (손상된 헤더가 수 GB 할당을 일으키지 않게)
+    const qint64 bytesLeft = file.size() - file.pos();
+    if (chunkElem.stride <= 0 || vertexElem.stride <= 0
+        || chunkElem.count > size_t(bytesLeft / chunkElem.stride)
+        || vertexElem.count > size_t((bytesLeft - qint64(chunkElem.count) * chunkElem.stride) / vertexElem.stride)) {
+        qCritical() << "Compressed PLY header declares" << chunkElem.count << "chunks and" << vertexElem.count
+                    << "vertices, more than the" << bytesLeft << "bytes left in" << filePath;
+        return false;
+    }
+
+    // 1. 청크 테이블 (256개 스플랫마다 위치/스케일/색 범위)
+    struct ChunkRange {
+        float posMin[3], posMax[3];
+        float scaleMin[3], scaleMax[3];
+        float colorMin[3] = { 0, 0, 0 }, colorMax[3] = { 1, 1, 1 };
+    };
+    const char *posNames[6] = { "min_x", "min_y", "min_z", "max_x", "max_y", "max_z" };
+    const char *scaleNames[6] = { "min_scale_x", "min_scale_y", "min_scale_z",
+                                  "max_scale_x", "max_scale_y", "max_scale_z" };
+    const char *colorNames[6] = { "min_r", "min_g", "min_b", "max_r", "max_g", "max_b" };
+    int posOff[6], scaleOff[6], colorOff[6];
+    bool hasColorRange = true;
+    for (int k = 0; k < 6; ++k) {
+        posOff[k] = chunkElem.offsetOf(posNames[k]);
+        scaleOff[k] = chunkElem.offsetOf(scaleNames[k]);
+        colorOff[k] = chunkElem.offsetOf(colorNames[k]);
+        if (posOff[k] < 0 || scaleOff[k] < 0) {
+            qCritical() << "Compressed PLY chunk is missing" << (posOff[k] < 0 ? posNames[k] : scaleNames[k]);
+            return false;
+        }
+        hasColorRange = hasColorRange && colorOff[k] >= 0;
+    }
+
+    QByteArray chunkData = file.read(qint64(chunkElem.count) * chunkElem.stride);
+    if (chunkData.size() != qint64(chunkElem.count) * chunkElem.stride) {
+        qCritical() << "Truncated compressed PLY chunk table";
+        return false;
+    }
+    std::vector<ChunkRange> chunks(chunkElem.count);
+    for (size_t c = 0; c < chunkElem.count; ++c) {
+        const char *rec = chunkData.constData() + c * chunkElem.stride;
+        ChunkRange &r = chunks[c];
+        for (int k = 0; k < 3; ++k) {
+            r.posMin[k] = readValue<float>(rec + posOff[k]);
+            r.posMax[k] = readValue<float>(rec + posOff[k + 3]);
+            r.scaleMin[k] = readValue<float>(rec + scaleOff[k]);
+            r.scaleMax[k] = readValue<float>(rec + scaleOff[k + 3]);
+            if (hasColorRange) {
+                r.colorMin[k] = readValue<float>(rec + colorOff[k]);
+                r.colorMax[k] = readValue<float>(rec + colorOff[k + 3]);
+            }
+        }
+    }
+
+    // 2. 스플랫 (uint32 4개: 위치 11/10/11, 회전 2+10/10/10, 스케일 11/10/11, 색 8/8/8/8)
+    const int offPos = vertexElem.offsetOf("packed_position");
+    const int offRot = vertexElem.offsetOf("packed_rotation");
+    const int offScale = vertexElem.offsetOf("packed_scale");
+    const int offColor = vertexElem.offsetOf("packed_color");
+    if (offPos < 0 || offRot < 0 || offScale < 0 || offColor < 0) {
+        qCritical() << "Compressed PLY vertex is missing packed properties";
+        return false;
+    }
+    if ((vertexElem.count + 255) / 256 > chunks.size()) {
+        qCritical() << "Compressed PLY has fewer chunks than vertices require";
+        return false;
+    }
+
+    const size_t count = vertexElem.count;
+    outSplats.assign(count, RenderSplat());
+
+    bool ok = streamRecords(file, vertexElem.stride, count, [&](const char *rec, size_t i) {
+        const ChunkRange &r = chunks[i / 256];
+        RenderSplat &s = outSplats[i];
+
+        const quint32 pos = readValue<quint32>(rec + offPos);
+        s.x = lerp(r.posMin[0], r.posMax[0], unpackUnorm(pos >> 21, 11));
+        s.y = lerp(r.posMin[1], r.posMax[1], unpackUnorm(pos >> 11, 10));
+        s.z = lerp(r.posMin[2], r.posMax[2], unpackUnorm(pos, 11));
+
+        // 가장 큰 성분을 뺀 나머지 세 성분 (x, y, z, w 순서에서), 스케일 = 1/sqrt(2)
+        const quint32 rot = readValue<quint32>(rec + offRot);
+        const float norm = 1.0f / (std::sqrt(2.0f) * 0.5f);
+        const float a = (unpackUnorm(rot >> 20, 10) - 0.5f) * norm;
+        const float b = (unpackUnorm(rot >> 10, 10) - 0.5f) * norm;
+        const float c = (unpackUnorm(rot, 10) - 0.5f) * norm;
+        const float m = std::sqrt(std::max(0.0f, 1.0f - (a * a + b * b + c * c)));
+        float q[4]; // x, y, z, w
+        switch (rot >> 30) {
+        case 0: q[0] = m; q[1] = a; q[2] = b; q[3] = c; break;
+        case 1: q[0] = a; q[1] = m; q[2] = b; q[3] = c; break;
+        case 2: q[0] = a; q[1] = b; q[2] = m; q[3] = c; break;
+        default: q[0] = a; q[1] = b; q[2] = c; q[3] = m; break;
+        }
+        s.rot[0] = q[3]; s.rot[1] = q[0]; s.rot[2] = q[1]; s.rot[3] = q[2];
+
+        // 스케일은 로그 공간에서 양자화되어 있음
+        const quint32 scale = readValue<quint32>(rec + offScale);
+        s.scale[0] = std::exp(lerp(r.scaleMin[0], r.scaleMax[0], unpackUnorm(scale >> 21, 11)));
+        s.scale[1] = std::exp(lerp(r.scaleMin[1], r.scaleMax[1], unpackUnorm(scale >> 11, 10)));
+        s.scale[2] = std::exp(lerp(r.scaleMin[2], r.scaleMax[2], unpackUnorm(scale, 11)));
+
+        // 색은 SH DC를 적용한 최종 색, 알파는 시그모이드를 적용한 최종 불투명도
+        const quint32 color = readValue<quint32>(rec + offColor);
+        s.r = clamp01(lerp(r.colorMin[0], r.colorMax[0], unpackUnorm(color >> 24, 8)));
+        s.g = clamp01(lerp(r.colorMin[1], r.colorMax[1], unpackUnorm(color >> 16, 8)));
+        s.b = clamp01(lerp(r.colorMin[2], r.colorMax[2], unpackUnorm(color >> 8, 8)));
+        s.opacity = unpackUnorm(color, 8);
+    });
+
+    qDebug() << "Loaded" << outSplats.size() << "splats from compressed PLY (" << chunks.size() << "chunks )";
+    return ok;
+}
+
+bool SplatFileLoader::loadSpz(const QString &filePath, std::vector<RenderSplat> &outSplats)
+{
+#ifndef S2S_HAVE_ZLIB
+    qCritical() << "SPZ support requires zlib (rebuild with ZLIB available):" << filePath;
+    Q_UNUSED(outSplats);
+    return false;
+#else
+    gzFile gz = gzopen(filePath.toLocal8Bit().constData(), "rb");
+    if (!gz) {
+        qCritical() << "Failed to open file:" << filePath;
+        return false;
+    }
+    gzbuffer(gz, 1 << 20);
+
+    // gzread는 unsigned int 길이만 받으므로 나눠서 읽음
+    auto readAll = [gz](char *dst, size_t bytes) {
+        while (bytes > 0) {
+            unsigned int n = unsigned(std::min<size_t>(bytes, 1u << 30));
+            int got = gzread(gz, dst, n);
+            if (got <= 0) return false;
+            dst += got;
+            bytes -= size_t(got);
+        }
+        return true;
+    };
+
+    // 헤더 16바이트: magic "NGSP", version, numPoints, shDegree, fractionalBits, flags, reserved
+#pragma pack(push, 1)
+    struct SpzHeader {
+        quint32 magic;
+        quint32 version;
+        quint32 numPoints;
+        quint8 shDegree;
+        quint8 fractionalBits;
+        quint8 flags;
+        quint8 reserved;
+    } header;
+#pragma pack(pop)
+    if (!readAll(reinterpret_cast<char *>(&header), sizeof(header)) || header.magic != 0x5053474e) {
+        qCritical() << "Invalid SPZ header:" << filePath;
+        gzclose(gz);
+        return false;
+    }
+    if (header.version < 2 || header.version > 3) {
+        qCritical() << "Unsupported SPZ version" << header.version;
+        gzclose(gz);
+        return false;
+    }
+
+    const size_t count = header.numPoints;
+    const float posScale = 1.0f / float(1 << header.fractionalBits);
+    const int rotBytes = header.version >= 3 ? 4 : 3;
+
+    // 헤더의 개수를 믿고 할당하기 전에 압축 해제된 본문에 읽을 열들이 들어가는지 확인
+    const qint64 payload = gzipPayloadBound(filePath);
+    const qint64 needed = qint64(sizeof(header)) + qint64(count) * (9 + 1 + 3 + 3 + rotBytes);
+    if (count > SplatRef::INDEX_MASK || payload < 0 || needed > payload) {
+        qCritical() << "SPZ header declares" << count << "points, more than" << filePath << "can hold";
+        gzclose(gz);
+        return false;
+    }
+    outSplats.assign(count, RenderSplat());
+
+    // 열 단위 레이아웃: 위치(9B) | 알파(1B) | 색(3B) | 스케일(3B) | 회전(3B 또는 4B) | SH (읽지 않음)
+    // 압축 해제는 순차적이므로, 열 하나를 푸는 동안 앞 열을 백그라운드에서 병렬 디코딩합니다.
+    // SPZ는 RUB 좌표계, PLY는 RDF이므로 y/z를 뒤집어 PLY와 같은 방향으로 맞춤.
+    struct Column {
+        size_t stride;
+        std::function<void(const quint8 *, RenderSplat &)> decode;
+    };
+    const float colorScale = 0.15f;
+    const Column columns[5] = {
+        { 9, [posScale](const quint8 *p, RenderSplat &s) {
+              float v[3];
+              for (int k = 0; k < 3; ++k) {
+                  qint32 fixed = qint32(p[3 * k] | (p[3 * k + 1] << 8) | (p[3 * k + 2] << 16));
+                  if (fixed & 0x800000) fixed |= qint32(0xff000000);
+                  v[k] = fixed * posScale;
+              }
+              s.x = v[0]; s.y = -v[1]; s.z = -v[2];
+          } },
+        { 1, [](const quint8 *p, RenderSplat &s) { s.opacity = p[0] / 255.0f; } },
+        { 3, [colorScale](const quint8 *p, RenderSplat &s) {
+              // u8 -> SH DC 계수 -> 색
+              float c[3];
+              for (int k = 0; k < 3; ++k) c[k] = clamp01(0.5f + SH_C0 * ((p[k] / 255.0f - 0.5f) / colorScale));
+              s.r = c[0]; s.g = c[1]; s.b = c[2];
+          } },
+        { 3, [](const quint8 *p, RenderSplat &s) {
+              for (int k = 0; k < 3; ++k) s.scale[k] = std::exp(p[k] / 16.0f - 10.0f);
+          } },
+        { size_t(rotBytes), [rotBytes](const quint8 *p, RenderSplat &s) {
+              float q[4]; // x, y, z, w
+              if (rotBytes == 3) {
+                  float sum = 0.0f;
+                  for (int k = 0; k < 3; ++k) {
+                      q[k] = p[k] / 127.5f - 1.0f;
+                      sum += q[k] * q[k];
+                  }
+                  q[3] = std::sqrt(std::max(0.0f, 1.0f - sum));
+              } else {
+                  // smallest-three: 상위 2비트 = 가장 큰 성분, 나머지 셋은 9비트 크기 + 1비트 부호
+                  quint32 comp = quint32(p[0]) | (quint32(p[1]) << 8) | (quint32(p[2]) << 16) | (quint32(p[3]) << 24);
+                  const int largest = int(comp >> 30);
+                  const quint32 mask = (1u << 9) - 1;
+                  float sum = 0.0f;
+                  for (int k = 3; k >= 0; --k) {
+                      if (k == largest) continue;
+                      quint32 mag = comp & mask;
+                      bool negative = (comp >> 9) & 1u;
+                      comp >>= 10;
+                      q[k] = 0.70710678f * float(mag) / float(mask);
+                      if (negative) q[k] = -q[k];
+                      sum += q[k] * q[k];
+                  }
+                  q[largest] = std::sqrt(std::max(0.0f, 1.0f - sum));
+              }
+              s.rot[0] = q[3]; s.rot[1] = q[0]; s.rot[2] = -q[1]; s.rot[3] = -q[2];
+          } },
+    };
+
+    std::vector<quint8> buffers[2];
+    TaskGroup worker("spz column decode");
+    bool ok = true;
+    for (int c = 0; c < 5; ++c) {
+        std::vector<quint8> &buffer = buffers[c & 1];
+        buffer.resize(count * columns[c].stride);
+        if (!readAll(reinterpret_cast<char *>(buffer.data()), buffer.size())) {
+            qCritical() << "Truncated SPZ data (column" << c << ")";
+            ok = false;
+            break;
+        }
+
+        worker.wait();
+        worker.run([&outSplats, &buffer, &column = columns[c], count] {
+            parallelForRange(0, count, 16384, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) column.decode(&buffer[i * column.stride], outSplats[i]);
+            });
+        });
+    }
+    worker.wait();
+    gzclose(gz);
+
+    if (ok) qDebug() << "Loaded" << outSplats.size() << "splats from SPZ v" << header.version;
+    return ok;
+#endif
+}
+
+bool SplatFileLoader::saveSplat(const QString &filePath, const std::vector<RenderSplat> &splats)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCritical() << "Failed to open file for writing:" << filePath;
+        return false;
+    }
+
+    auto toU8 = [](float v) { return quint8(std::lround(clamp01(v) * 255.0f)); };
+    std::vector<char> block;
+    const size_t blockSplats = 65536;
+    for (size_t first = 0; first < splats.size(); first += blockSplats) {
+        const size_t n = std::min(blockSplats, splats.size() - first);
+        block.resize(n * 32);
+        for (size_t i = 0; i < n; ++i) {
+            const RenderSplat &s = splats[first + i];
+            char *rec = &block[i * 32];
+            const float f[6] = { s.x, s.y, s.z, s.scale[0], s.scale[1], s.scale[2] };
+            std::memcpy(rec, f, sizeof(f));
+
+            quint8 *u = reinterpret_cast<quint8 *>(rec + 24);
+            u[0] = toU8(s.r); u[1] = toU8(s.g); u[2] = toU8(s.b); u[3] = toU8(s.opacity);
+
+            // 정규화한 뒤 [-1, 1] -> [0, 255]
+            float len = std::sqrt(s.rot[0] * s.rot[0] + s.rot[1] * s.rot[1] + s.rot[2] * s.rot[2] + s.rot[3] * s.rot[3]);
+            if (len <= 0.0f) len = 1.0f;
+            for (int k = 0; k < 4; ++k) {
+                u[4 + k] = quint8(std::clamp(std::lround(s.rot[k] / len * 128.0f + 128.0f), 0L, 255L));
+            }
+        }
+        if (file.write(block.data(), qint64(block.size())) != qint64(block.size())) {
+            qCritical() << "Failed to write" << filePath;
+            return false;
+        }
+    }
+
+    qDebug() << "Saved" << splats.size() << "splats to" << filePath;
+    return true;
+}
+
+QString SplatFileLoader::benchmarkLoad(const QStringList &filePaths, int runs)
+{
+    QStringList report;
+    for (const QString &path : filePaths) {
+        const Format format = detectFormat(path);
+        const double fileMB = QFileInfo(path).size() / (1024.0 * 1024.0);
+
+        double bestMs = 0.0, totalMs = 0.0;
+        size_t splatCount = 0;
+        bool ok = true;
+        for (int r = 0; r < runs && ok; ++r) {
+            std::vector<RenderSplat> splats;
+            SplatFileLoader loader;
+
+            QElapsedTimer timer;
+            timer.start();
+            ok = loader.load(path, splats);
+            double ms = timer.nsecsElapsed() / 1.0e6;
+
+            splatCount = splats.size();
+            totalMs += ms;
+            bestMs = (r == 0) ? ms : std::min(bestMs, ms);
+        }
+
+        QString line;
+        if (!ok || splatCount == 0) {
+            line = QString("%1 (%2): failed").arg(QFileInfo(path).fileName(), formatName(format));
+        } else {
+            line = QString("%1 (%2): %3 splats, %4 MB (%5 B/splat), best %6 ms, avg %7 ms, "
+                           "%8 ms per million splats, %9 MB/s")
+                       .arg(QFileInfo(path).fileName(), formatName(format))
+                       .arg(splatCount)
+                       .arg(fileMB, 0, 'f', 1)
+                       .arg(fileMB * 1024.0 * 1024.0 / splatCount, 0, 'f', 1)
+                       .arg(bestMs, 0, 'f', 1)
+                       .arg(totalMs / runs, 0, 'f', 1)
+                       .arg(bestMs / (splatCount / 1.0e6), 0, 'f', 1)
+                       .arg(fileMB / (bestMs / 1000.0), 0, 'f', 1);
+        }
+        qInfo().noquote() << line;
+        report << line;
+    }
+    return report.join("\n");
+}
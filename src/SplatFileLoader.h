@@ -0,0 +1,48 @@
+#ifndef SPLATFILELOADER_H
+#define SPLATFILELOADER_H
+
+#include <QString>
+#include <QStringList>
+#include <vector>
+#include "GaussianData.h"
+
+struct ShPalette;
+
+// 여러 스플랫 파일 포맷을 RenderSplat으로 읽는 로더
+//
+//  - .ply           : 표준 3DGS float PLY (PlyLoader, 스플랫당 248바이트)
+//  - .compressed.ply: 256개 청크 단위 양자화 PLY (스플랫당 16바이트 + 청크당 min/max)
+//  - .splat         : 32바이트 고정 레이아웃 (위치/스케일 float, 색/투명도/회전 u8)
+//  - .spz           : gzip으로 압축된 열(Column) 단위 레이아웃 (zlib 필요)
+//  - .s2vq          : SH 코드북 압축 씬 (Switch2ShVq로 생성, 시점별 색 유지)
+//
+// 고정 크기 레코드 포맷은 블록 단위로 읽으면서, 읽은 블록은 스케줄러 작업으로 병렬 디코딩합니다.
+// (디스크 읽기와 디코딩이 겹치므로 큰 파일에서 로드 시간이 읽기 시간에 가까워짐)
+class SplatFileLoader
+{
+public:
+    enum class Format { Ply, CompressedPly, Splat, Spz, ShVq, Unknown };
+
+    // 확장자 + 헤더로 포맷 판별
+    static Format detectFormat(const QString &filePath);
+    static QString formatName(Format format);
+
+    // 포맷을 판별해서 알맞은 로더로 읽음
+    // outSh: .s2vq의 SH 코드북 (다른 포맷이면 비어 있음)
+    bool load(const QString &filePath, std::vector<RenderSplat> &outSplats, ShPalette *outSh = nullptr);
+
+    bool loadSplat(const QString &filePath, std::vector<RenderSplat> &outSplats);
+    bool loadCompressedPly(const QString &filePath, std::vector<RenderSplat> &outSplats);
+    bool loadSpz(const QString &filePath, std::vector<RenderSplat> &outSplats);
+
+    // .splat으로 저장 (포맷별 로드 시간 비교용으로 같은 씬을 만들 때)
+    static bool saveSplat(const QString &filePath, const std::vector<RenderSplat> &splats);
+
+    // 같은 씬의 여러 포맷 파일을 각각 runs번 읽어 로드 시간을 비교
+    static QString benchmarkLoad(const QStringList &filePaths, int runs = 3);
+
+    // 다이얼로그용 필터 문자열
+    static QString fileDialogFilter();
+};
+
+#endif // SPLATFILELOADER_H
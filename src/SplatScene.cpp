@@ -0,0 +1,710 @@
+#include "SplatScene.h"
+#include "Parallel.h"
+#include "TaskScheduler.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <cmath>
+#include <functional>
+#include <queue>
+
+namespace {
+
+// 정렬을 나눌 때 구간 하나의 최소 크기 (이보다 작은 씬은 한 스레드에서 정렬)
+const size_t SORT_PART_MIN = 65536;
+
+// 셰이더의 빌보드 축 (뷰 행렬 1, 2열 = setSplatUniforms의 cameraRight/cameraUp)을 씬 로컬 공간으로
+SplatBvh::Billboard localBillboard(const QMatrix4x4 &view, const QMatrix4x4 &toLocal, float globalScale)
+{
+    SplatBvh::Billboard billboard;
+    billboard.right = toLocal.mapVector(QVector3D(view(0, 0), view(1, 0), view(2, 0))).normalized();
+    billboard.up = toLocal.mapVector(QVector3D(view(0, 1), view(1, 1), view(2, 1))).normalized();
+    billboard.normal = QVector3D::crossProduct(billboard.right, billboard.up);
+    billboard.scale = globalScale;
+    return billboard;
+}
+
+// 원점에서 선분 ab까지 거리의 제곱
+double originSegmentDistanceSq(double ax, double ay, double bx, double by)
+{
+    const double dx = bx - ax, dy = by - ay;
+    const double lenSq = dx * dx + dy * dy;
+    const double t = lenSq > 0.0 ? std::clamp(-(ax * dx + ay * dy) / lenSq, 0.0, 1.0) : 0.0;
+    const double px = ax + dx * t, py = ay + dy * t;
+    return px * px + py * py;
+}
+
+} // namespace
+
+QMatrix4x4 SceneTransform::matrix() const
+{
+    QMatrix4x4 m;
+    m.translate(translation);
+    m.rotate(yawDegrees, QVector3D(0, 1, 0));
+    m.scale(scale);
+    return m;
+}
+
+SplatScene::SplatScene(const QString &name, std::vector<RenderSplat> splats)
+    : m_name(name), m_splats(std::move(splats))
+{
+    buildPruneIndex();
+}
+
+void SplatScene::setTransform(const SceneTransform &transform)
+{
+    m_transform = transform;
+    m_model = transform.matrix();
+}
+
+void SplatScene::reorderSpatially(bool withBvh)
+{
+    // 인덱스가 바뀌므로 활성 집합은 의미가 없어짐 (가지치기 인덱스는 아래에서 한 번만 다시 만듦)
+    m_activeAll.clear();
+    m_active.clear();
+    m_hasActiveSet = false;
+    m_clusterCulled.clear();
+
+    // 재배치 뒤에 만드는 것들은 새 순서에만 의존하고 서로는 독립이므로 그래프로 걸어 병렬로 만듦
+    //   Morton 재배치 -> { SH 인덱스 재배치, 가지치기 인덱스, BVH }
+    // BVH를 여기서 만들어 두므로 첫 피킹이 O(n) 빌드를 떠안지 않음
+    const bool hasSh = hasShPalette();
+    std::vector<quint32> order;
+    TaskGraph graph("scene prepare");
+    const int reorder = graph.add("morton reorder", [&] {
+        m_clusters = SpatialOrder::reorderMorton(m_splats, CLUSTER_SIZE, hasSh ? &order : nullptr);
+    });
+    if (hasSh) {
+        graph.precede(reorder, graph.add("sh reorder", [&] {
+            std::vector<quint16> indices(order.size());
+            for (size_t i = 0; i < order.size(); ++i) indices[i] = m_sh.indices[order[i]];
+            m_sh.indices.swap(indices);
+        }));
+    }
+    graph.precede(reorder, graph.add("prune index", [this] { buildPruneIndex(); }));
+    int bvh = -1;
+    if (withBvh) {
+        bvh = graph.add("bvh build", [this] { m_bvh.build(m_splats); });
+        graph.precede(reorder, bvh);
+    } else {
+        m_bvh.clear();
+    }
+    graph.run();
+
+    m_hasBvh = withBvh;
+    m_bvhBuildMs = bvh >= 0 ? graph.nodeMs(bvh) : 0.0;
+    m_prepareTiming = graph.timingString();
+}
+
+void SplatScene::setActiveIndices(std::vector<quint32> indices)
+{
+    m_activeAll = std::move(indices);
+    m_hasActiveSet = true;
+    m_clusterCulled.clear();
+    filterActive();
+    m_sorted = false;
+}
+
+void SplatScene::appendActiveIndices(const std::vector<quint32> &indices)
+{
+    m_hasActiveSet = true;
+    m_activeAll.insert(m_activeAll.end(), indices.begin(), indices.end());
+    for (quint32 i : indices) {
+        const RenderSplat &s = m_splats[i];
+        if (s.opacity >= m_pruneCutoff && !isDegenerate(s)) m_active.push_back(i);
+    }
+    m_clusterCulled.clear();
+    m_sorted = false;
+}
+
+void SplatScene::clearActiveIndices()
+{
+    m_activeAll.clear();
+    m_active.clear();
+    m_hasActiveSet = false;
+    if (m_pruneIndexDirty) buildPruneIndex();
+    m_sorted = false;
+}
+
+void SplatScene::writeSplats(size_t offset, const std::vector<RenderSplat> &splats)
+{
+    if (offset + splats.size() > m_splats.size()) return;
+    std::copy(splats.begin(), splats.end(), m_splats.begin() + offset);
+    m_sorted = false;
+    m_bvh.clear();
+    m_hasBvh = false;
+    m_clusterCulled.clear();
+
+    // 활성 집합을 쓰는 동안(스트리밍)은 setActiveIndices에서 직접 거르므로 인덱스 재구성을 미룸
+    if (m_hasActiveSet) {
+        m_pruneIndexDirty = true;
+    } else {
+        buildPruneIndex();
+    }
+}
+
+bool SplatScene::isDegenerate(const RenderSplat &s)
+{
+    if (!std::isfinite(s.x + s.y + s.z + s.opacity)) return true;
+
+    // 크기가 0이거나 NaN/Inf인 스케일
+    const float maxScale = std::max({ s.scale[0], s.scale[1], s.scale[2] });
+    if (!std::isfinite(s.scale[0] + s.scale[1] + s.scale[2]) || !(maxScale > 1e-7f)) return true;
+
+    // 정규화할 수 없는 쿼터니언
+    const float q = s.rot[0] * s.rot[0] + s.rot[1] * s.rot[1] + s.rot[2] * s.rot[2] + s.rot[3] * s.rot[3];
+    return !std::isfinite(q) || !(q > 1e-12f);
+}
+
+void SplatScene::buildPruneIndex()
+{
+    // (불투명도 키 << 32 | 인덱스)를 정수 정렬 -> 비교 한 번으로 끝남
+    const size_t count = m_splats.size();
+    std::vector<float> &opacity = m_opacityByIndex;
+    opacity.resize(count);
+    std::vector<quint64> keys(count);
+    for (size_t i = 0; i < count; ++i) {
+        opacity[i] = isDegenerate(m_splats[i]) ? -1.0f : m_splats[i].opacity;
+        keys[i] = (quint64(depthToKey(opacity[i])) << 32) | quint64(i);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    m_opacityOrder.resize(count);
+    m_pruneKeys.resize(count);
+    for (size_t k = 0; k < count; ++k) {
+        quint32 i = quint32(keys[k] & 0xFFFFFFFFu);
+        m_opacityOrder[k] = i;
+        m_pruneKeys[k] = opacity[i];
+    }
+
+    m_pruneBegin = pruneBoundary(m_pruneCutoff);
+    m_pruneThreshold = thresholdFor(m_pruneCutoff);
+    m_pruneIndexDirty = false;
+    m_sorted = false;
+
+    // 중요도 인덱스 (같은 방식: 키를 반전해 내림차순)
+    for (size_t i = 0; i < count; ++i) {
+        const RenderSplat &s = m_splats[i];
+        float importance = -1.0f;
+        if (opacity[i] >= 0.0f) {
+            float a = s.scale[0], b = s.scale[1], c = s.scale[2];
+            if (a < b) std::swap(a, b);
+            if (b < c) std::swap(b, c);
+            if (a < b) std::swap(a, b);
+            importance = opacity[i] * a * b;
+        }
+        keys[i] = (quint64(~depthToKey(importance)) << 32) | quint64(i);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    m_importanceOrder.resize(count);
+    m_importanceRank.resize(count);
+    for (size_t k = 0; k < count; ++k) {
+        quint32 i = quint32(keys[k] & 0xFFFFFFFFu);
+        m_importanceOrder[k] = i;
+        m_importanceRank[i] = quint32(k);
+    }
+    updateRankLimit();
+}
+
+void SplatScene::updateRankLimit()
+{
+    m_clusterDrawCountsDirty = true;
+    const size_t full = m_opacityOrder.size() - m_pruneBegin;
+    if (m_importanceLimit >= full) {
+        m_rankLimit = 0xFFFFFFFFu;
+        m_limitedCount = full;
+        return;
+    }
+
+    // 중요도 순으로 그리기 집합에 드는 것을 한도만큼 셀 때까지 (가지치기된 것은 건너뜀)
+    size_t kept = 0;
+    size_t rank = 0;
+    for (; rank < m_importanceOrder.size() && kept < m_importanceLimit; ++rank) {
+        if (m_opacityByIndex[m_importanceOrder[rank]] >= m_pruneThreshold) ++kept;
+    }
+    m_rankLimit = quint32(rank);
+    m_limitedCount = kept;
+}
+
+bool SplatScene::setImportanceLimit(size_t maxSplats)
+{
+    if (maxSplats == m_importanceLimit) return false;
+    const size_t before = m_limitedCount;
+    const quint32 beforeRank = m_rankLimit;
+    m_importanceLimit = maxSplats;
+    if (m_hasActiveSet) return false;
+
+    updateRankLimit();
+    if (m_rankLimit == beforeRank && m_limitedCount == before) return false;
+    m_sorted = false;
+    return true;
+}
+
+float SplatScene::thresholdFor(float cutoff)
+{
+    // 컷오프가 0이어도 비정상 스플랫(-1)은 항상 빠짐
+    return std::max(cutoff, std::nextafter(-1.0f, 0.0f));
+}
+
+size_t SplatScene::pruneBoundary(float cutoff) const
+{
+    return std::lower_bound(m_pruneKeys.begin(), m_pruneKeys.end(), thresholdFor(cutoff)) - m_pruneKeys.begin();
+}
+
+void SplatScene::filterActive()
+{
+    m_active.clear();
+    m_active.reserve(m_activeAll.size());
+    for (quint32 i : m_activeAll) {
+        const RenderSplat &s = m_splats[i];
+        if (s.opacity >= m_pruneCutoff && !isDegenerate(s)) m_active.push_back(i);
+    }
+}
+
+bool SplatScene::setPruneCutoff(float cutoff)
+{
+    m_pruneCutoff = cutoff;
+    m_pruneThreshold = thresholdFor(cutoff);
+
+    if (m_hasActiveSet) {
+        // 활성 집합은 스트리밍 상주분뿐이므로 그대로 다시 거름
+        size_t before = m_active.size();
+        filterActive();
+        m_sorted = false;
+        return before != m_active.size();
+    }
+
+    size_t newBegin = pruneBoundary(cutoff);
+    if (newBegin == m_pruneBegin) return false;
+    m_clusterDrawCountsDirty = true;
+
+    if (m_importanceLimit != NO_LIMIT) {
+        // 중요도 한도 중: 경계가 움직이면 접두부 구성도 바뀌므로 다시 정렬
+        m_pruneBegin = newBegin;
+        updateRankLimit();
+        m_sorted = false;
+        return true;
+    }
+
+    if (m_sorted) {
+        if (newBegin > m_pruneBegin) {
+            // 컷오프 상승: 정렬된 키에서 빠지는 것만 걸러냄 (순서 유지, 재정렬 없음)
+            m_sortedKeys.erase(std::remove_if(m_sortedKeys.begin(), m_sortedKeys.end(),
+                                              [this](quint64 key) {
+                                                  return m_opacityByIndex[key & 0xFFFFFFFFu] < m_pruneThreshold;
+                                              }),
+                               m_sortedKeys.end());
+        } else {
+            // 컷오프 하강: 새로 들어오는 구간만 같은 깊이 행으로 정렬해 병합
+            const float rx = m_sortedDepthRow.x(), ry = m_sortedDepthRow.y();
+            const float rz = m_sortedDepthRow.z(), rw = m_sortedDepthRow.w();
+            size_t oldSize = m_sortedKeys.size();
+            for (size_t k = newBegin; k < m_pruneBegin; ++k) {
+                quint32 i = m_opacityOrder[k];
+                if (isClusterCulled(i)) continue;
+                const RenderSplat &s = m_splats[i];
+                float z = rx * s.x + ry * s.y + rz * s.z + rw;
+                m_sortedKeys.push_back((quint64(depthToKey(z)) << 32) | quint64(i));
+            }
+            std::sort(m_sortedKeys.begin() + oldSize, m_sortedKeys.end());
+            std::inplace_merge(m_sortedKeys.begin(), m_sortedKeys.begin() + oldSize, m_sortedKeys.end());
+        }
+    }
+
+    m_pruneBegin = newBegin;
+    m_limitedCount = m_opacityOrder.size() - m_pruneBegin;
+    return true;
+}
+
+bool SplatScene::setCulledClusters(const std::vector<quint8> &culled)
+{
+    const bool usable = !m_hasActiveSet && !culled.empty() && culled.size() == m_clusters.size();
+    if (!usable) {
+        if (m_clusterCulled.empty()) return false;
+        m_clusterCulled.clear();
+        m_sorted = false;
+        return true;
+    }
+    if (culled == m_clusterCulled) return false;
+    m_clusterCulled.assign(culled.begin(), culled.end()); // 용량 재사용
+    m_sorted = false;
+    return true;
+}
+
+const std::vector<quint32> &SplatScene::clusterDrawCounts()
+{
+    if (!m_clusterDrawCountsDirty && m_clusterDrawCounts.size() == m_clusters.size()) return m_clusterDrawCounts;
+    m_clusterDrawCounts.resize(m_clusters.size());
+    parallelForRange(0, m_clusters.size(), 64, [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c) {
+            const SplatCluster &cluster = m_clusters[c];
+            quint32 count = 0;
+            for (quint32 i = cluster.begin; i < cluster.begin + cluster.count; ++i) {
+                if (m_hasActiveSet ? isDrawn(i) : isInDrawSet(i)) ++count;
+            }
+            m_clusterDrawCounts[c] = count;
+        }
+    });
+    m_clusterDrawCountsDirty = false;
+    return m_clusterDrawCounts;
+}
+
+int SplatScene::prunedCount() const
+{
+    if (m_hasActiveSet) return static_cast<int>(m_activeAll.size() - m_active.size());
+    return static_cast<int>(m_pruneBegin);
+}
+
+bool SplatScene::needsSort(const QMatrix4x4 &view) const
+{
+    if (!m_sorted) return true;
+    return (view * m_model).row(2) != m_sortedDepthRow;
+}
+
+quint32 SplatScene::depthToKey(float depth)
+{
+    quint32 bits;
+    std::memcpy(&bits, &depth, sizeof(bits));
+    // 음수는 모든 비트 반전, 양수는 부호 비트만 세움 -> 부호 없는 비교 = float 비교
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+void SplatScene::sortBackToFront(const QMatrix4x4 &view)
+{
+    // (View * Model)의 3행(Row 2)과 로컬 위치의 내적 = 뷰 공간 z
+    // OpenGL 카메라는 -Z를 바라보므로 z가 작을수록(더 음수일수록) 멀리 있습니다.
+    // -> z 오름차순 정렬 = 먼 것부터 (Back-to-Front)
+    QVector4D row = (view * m_model).row(2);
+    const float rx = row.x(), ry = row.y(), rz = row.z(), rw = row.w();
+
+    auto keyOf = [&](quint32 i) {
+        const RenderSplat &s = m_splats[i];
+        float z = rx * s.x + ry * s.y + rz * s.z + rw;
+        return (quint64(depthToKey(z)) << 32) | quint64(i);
+    };
+
+    // [begin, end) 구간의 그리기 집합 키 (컬링된 클러스터는 통째로 건너뜀)
+    auto collectKeys = [&](size_t begin, size_t end, std::vector<quint64> &keys) {
+        if (m_hasActiveSet) {
+            for (size_t k = begin; k < end; ++k) keys.push_back(keyOf(m_active[k]));
+            return;
+        }
+        size_t i = begin;
+        while (i < end) {
+            size_t stop = end;
+            if (!m_clusterCulled.empty()) {
+                const size_t c = i / CLUSTER_SIZE;
+                stop = std::min(end, (c + 1) * size_t(CLUSTER_SIZE));
+                if (m_clusterCulled[c]) {
+                    i = stop;
+                    continue;
+                }
+            }
+            for (; i < stop; ++i) {
+                if (m_opacityByIndex[i] >= m_pruneThreshold && m_importanceRank[i] < m_rankLimit) {
+                    keys.push_back(keyOf(quint32(i)));
+                }
+            }
+        }
+    };
+
+    // 키와 인덱스를 64비트 하나로 묶어 정렬하면 비교가 정수 비교 한 번으로 끝납니다.
+    const size_t domain = m_hasActiveSet ? m_active.size() : m_splats.size();
+    const size_t parts = std::max<size_t>(1, std::min<size_t>(parallelWorkerCount(), domain / SORT_PART_MIN));
+    if (parts == 1) {
+        m_sortedKeys.clear();
+        m_sortedKeys.reserve(drawCount());
+        collectKeys(0, domain, m_sortedKeys);
+        std::sort(m_sortedKeys.begin(), m_sortedKeys.end());
+    } else {
+        // 1. 구간마다 (그리기 집합 판정 + 키 생성 + 정렬)을 한 작업으로
+        m_partKeys.resize(parts);
+        parallelFor(0, int(parts), [&](int p) {
+            const size_t begin = domain * p / parts, end = domain * (p + 1) / parts;
+            std::vector<quint64> &keys = m_partKeys[p];
+            keys.clear();
+            collectKeys(begin, end, keys);
+            std::sort(keys.begin(), keys.end());
+        });
+
+        // 2. 이어 붙이고 정렬된 구간들을 병렬 병합
+        m_partBounds.assign(1, 0);
+        for (const std::vector<quint64> &keys : m_partKeys) m_partBounds.push_back(m_partBounds.back() + keys.size());
+        m_sortedKeys.resize(m_partBounds.back());
+        parallelFor(0, int(parts), [&](int p) {
+            std::copy(m_partKeys[p].begin(), m_partKeys[p].end(), m_sortedKeys.begin() + m_partBounds[p]);
+        });
+        parallelMergeRuns(m_sortedKeys, m_partBounds, m_sortTemp);
+    }
+
+    m_sortedDepthRow = row;
+    m_sorted = true;
+}
+
+void SplatScene::mergeBackToFront(const std::vector<const SplatScene *> &scenes,
+                                  const std::vector<int> &sceneSlots,
+                                  std::vector<quint32> &outRefs)
+{
+    size_t total = 0;
+    for (const SplatScene *scene : scenes) total += scene->m_sortedKeys.size();
+
+    outRefs.clear();
+    outRefs.reserve(total);
+
+    // 씬이 하나면 합칠 필요 없음
+    if (scenes.size() == 1) {
+        for (quint64 key : scenes[0]->m_sortedKeys) {
+            outRefs.push_back(SplatRef::make(sceneSlots[0], quint32(key & 0xFFFFFFFFu)));
+        }
+        return;
+    }
+
+    // k-way merge
+    // 동시에 보이는 씬은 최대 몇 개 수준이므로 힙 대신 k개 머리를 선형으로 비교합니다.
+    const size_t k = scenes.size();
+    std::array<size_t, SplatRef::MAX_SLOTS> cursor{}; // 슬롯 수 이하 (프레임마다 할당하지 않도록 고정 크기)
+
+    for (size_t n = 0; n < total; ++n) {
+        size_t best = k;
+        quint64 bestKey = 0;
+        for (size_t i = 0; i < k; ++i) {
+            const std::vector<quint64> &keys = scenes[i]->m_sortedKeys;
+            if (cursor[i] >= keys.size()) continue;
+
+            // 상위 32비트(깊이)만 비교
+            quint64 depthKey = keys[cursor[i]] >> 32;
+            if (best == k || depthKey < bestKey) {
+                best = i;
+                bestKey = depthKey;
+            }
+        }
+
+        quint64 key = scenes[best]->m_sortedKeys[cursor[best]++];
+        outRefs.push_back(SplatRef::make(sceneSlots[best], quint32(key & 0xFFFFFFFFu)));
+    }
+}
+
+SplatPick SplatScene::pick(const std::vector<const SplatScene *> &scenes, const std::vector<int> &sceneSlots,
+                           const QVector3D &origin, const QVector3D &dir, const QMatrix4x4 &view,
+                           float globalScale, float coverageTarget)
+{
+    SplatPick result;
+
+    // 씬 로컬 광선 (모델 행렬이 아핀이므로 t는 월드와 같음)과 빌보드 축
+    struct LocalRay {
+        QVector3D origin;
+        QVector3D dir;
+        QVector3D invDir;
+        SplatBvh::Billboard billboard;
+    };
+    std::vector<LocalRay> rays(scenes.size());
+
+    // 최소 힙: 방문할 노드 (진입 거리 순), 아직 합성하지 않은 교차 (거리 순)
+    struct NodeEntry {
+        float t;
+        int scene;
+        quint32 node;
+        bool operator>(const NodeEntry &o) const { return t > o.t; }
+    };
+    struct Hit {
+        float t;
+        float alpha;
+        int scene;
+        quint32 index;
+        bool operator>(const Hit &o) const { return t > o.t; }
+    };
+    std::priority_queue<NodeEntry, std::vector<NodeEntry>, std::greater<NodeEntry>> nodes;
+    std::priority_queue<Hit, std::vector<Hit>, std::greater<Hit>> hits;
+
+    for (size_t i = 0; i < scenes.size(); ++i) {
+        const SplatBvh &bvh = scenes[i]->bvh();
+        if (!scenes[i]->hasBvh() || bvh.isEmpty()) continue;
+
+        const QMatrix4x4 toLocal = scenes[i]->modelMatrix().inverted();
+        LocalRay &ray = rays[i];
+        ray.origin = toLocal.map(origin);
+        ray.dir = toLocal.mapVector(dir);
+        ray.invDir = QVector3D(1.0f / ray.dir.x(), 1.0f / ray.dir.y(), 1.0f / ray.dir.z());
+        ray.billboard = localBillboard(view, toLocal, globalScale);
+
+        float tEnter = 0.0f;
+        if (SplatBvh::intersectBox(bvh.nodes()[0], globalScale, ray.origin, ray.invDir, tEnter)) {
+            nodes.push({ tEnter, int(i), 0 });
+        }
+    }
+
+    // 발자국 위의 교점은 자신을 담은 모든 노드 AABB 안이므로,
+    // 다음 노드의 진입 거리보다 앞에 있는 교차는 더 앞의 교차가 나올 수 없어 바로 합성해도 됩니다.
+    float transmittance = 1.0f;
+    float bestWeight = 0.0f;
+    Hit best = { 0.0f, 0.0f, -1, 0 };
+    bool done = false;
+    auto composite = [&](const Hit &hit) {
+        const float weight = transmittance * hit.alpha;
+        if (weight > bestWeight) {
+            bestWeight = weight;
+            best = hit;
+        }
+        transmittance *= 1.0f - hit.alpha;
+        if (1.0f - transmittance >= coverageTarget) {
+            best = hit;
+            done = true;
+        }
+    };
+
+    while (!nodes.empty() && !done) {
+        const NodeEntry entry = nodes.top();
+        nodes.pop();
+        while (!hits.empty() && hits.top().t <= entry.t && !done) {
+            composite(hits.top());
+            hits.pop();
+        }
+        if (done) break;
+
+        ++result.visitedNodes;
+        const SplatScene *scene = scenes[entry.scene];
+        const SplatBvh::Node &node = scene->m_bvh.nodes()[entry.node];
+        const LocalRay &ray = rays[entry.scene];
+
+        if (node.count > 0) {
+            for (quint32 i = node.first; i < node.first + node.count; ++i) {
+                if (!scene->isDrawn(i)) continue;
+                ++result.testedSplats;
+                float t = 0.0f, alpha = 0.0f;
+                if (SplatBvh::intersectFootprint(scene->m_splats[i], ray.billboard, ray.origin, ray.dir, t, alpha)
+                    && t >= 0.0f) {
+                    hits.push({ t, alpha, entry.scene, i });
+                }
+            }
+        } else {
+            for (quint32 child = node.first; child < node.first + 2; ++child) {
+                float tEnter = 0.0f;
+                if (SplatBvh::intersectBox(scene->m_bvh.nodes()[child], globalScale, ray.origin, ray.invDir, tEnter)) {
+                    nodes.push({ tEnter, entry.scene, child });
+                }
+            }
+        }
+    }
+    while (!hits.empty() && !done) {
+        composite(hits.top());
+        hits.pop();
+    }
+
+    if (best.scene < 0) return result;
+    result.hit = true;
+    result.distance = best.t;
+    result.point = origin + dir * best.t;
+    result.ref = SplatRef::make(sceneSlots[best.scene], best.index);
+    result.coverage = 1.0f - transmittance;
+    return result;
+}
+
+void SplatScene::selectRegion(const std::vector<const SplatScene *> &scenes, const std::vector<int> &sceneSlots,
+                              const QMatrix4x4 &view, const QMatrix4x4 &projection, float globalScale,
+                              const QPolygonF &region, bool isRect, std::vector<quint32> &outRefs)
+{
+    outRefs.clear();
+    const QRectF bounds = region.boundingRect();
+    const QMatrix4x4 viewProj = projection * view;
+
+    for (size_t si = 0; si < scenes.size(); ++si) {
+        const SplatScene *scene = scenes[si];
+        const SplatBvh &bvh = scene->bvh();
+        if (!scene->hasBvh() || bvh.isEmpty()) continue;
+
+        const std::vector<SplatBvh::Node> &nodes = bvh.nodes();
+        const QMatrix4x4 mvp = viewProj * scene->modelMatrix();
+        const int slot = sceneSlots[si];
+
+        // 빌보드 축의 클립 공간 변화량 (로컬 단위 길이당). 빌보드는 화면과 평행하므로 w는 중심과 같음
+        const SplatBvh::Billboard billboard = localBillboard(view, scene->modelMatrix().inverted(), globalScale);
+        const QVector4D clipRight = mvp * QVector4D(billboard.right, 0.0f);
+        const QVector4D clipUp = mvp * QVector4D(billboard.up, 0.0f);
+
+        auto addRange = [&](quint32 begin, quint32 end) {
+            for (quint32 i = begin; i < end; ++i) {
+                if (scene->isDrawn(i)) outRefs.push_back(SplatRef::make(slot, i));
+            }
+        };
+        // 발자국(화면의 타원)이 영역과 겹치면 선택: 타원을 단위 원으로 펴는 좌표에서 중심이 안에 있거나 변까지 1 이하
+        auto addIfTouching = [&](quint32 i) {
+            if (!scene->isDrawn(i)) return;
+            const RenderSplat &s = scene->m_splats[i];
+            const QVector4D clip = mvp * QVector4D(s.x, s.y, s.z, 1.0f);
+            if (clip.w() <= 0.0f) return;
+            const QPointF ndc(clip.x() / clip.w(), clip.y() / clip.w());
+            const bool inside = isRect ? bounds.contains(ndc) : region.containsPoint(ndc, Qt::OddEvenFill);
+            if (inside) {
+                outRefs.push_back(SplatRef::make(slot, i));
+                return;
+            }
+
+            const float ex = s.scale[0] * globalScale / clip.w(), ey = s.scale[1] * globalScale / clip.w();
+            const double ax = clipRight.x() * ex, ay = clipRight.y() * ex; // 쿼드 u = 1의 NDC 변위
+            const double bx = clipUp.x() * ey, by = clipUp.y() * ey;       // 쿼드 v = 1의 NDC 변위
+            const double det = ax * by - bx * ay;
+            if (!std::isfinite(det) || std::abs(det) < 1e-20) return;
+            // NDC 변위 -> 쿼드 좌표 (2x2 역행렬)
+            auto quadU = [&](const QPointF &p) { return (by * (p.x() - ndc.x()) - bx * (p.y() - ndc.y())) / det; };
+            auto quadV = [&](const QPointF &p) { return (ax * (p.y() - ndc.y()) - ay * (p.x() - ndc.x())) / det; };
+            const int n = int(region.size());
+            for (int k = 0; k < n; ++k) {
+                const QPointF &p0 = region[k];
+                const QPointF &p1 = region[(k + 1) % n];
+                if (originSegmentDistanceSq(quadU(p0), quadV(p0), quadU(p1), quadV(p1)) <= 1.0) {
+                    outRefs.push_back(SplatRef::make(slot, i));
+                    return;
+                }
+            }
+        };
+
+        std::vector<quint32> stack(1, 0);
+        while (!stack.empty()) {
+            const SplatBvh::Node &node = nodes[stack.back()];
+            stack.pop_back();
+
+            // 발자국을 감싸는 AABB 꼭짓점 8개의 화면 범위 (카메라 뒤로 넘어가는 노드는 범위를 알 수 없으므로 내려감)
+            float bboxMin[3], bboxMax[3];
+            SplatBvh::nodeBounds(node, globalScale, bboxMin, bboxMax);
+            bool behind = false;
+            float minX = 0.0f, maxX = 0.0f, minY = 0.0f, maxY = 0.0f;
+            for (int c = 0; c < 8 && !behind; ++c) {
+                const QVector4D corner((c & 1) ? bboxMax[0] : bboxMin[0], (c & 2) ? bboxMax[1] : bboxMin[1],
+                                       (c & 4) ? bboxMax[2] : bboxMin[2], 1.0f);
+                const QVector4D clip = mvp * corner;
+                if (clip.w() <= 0.0f) {
+                    behind = true;
+                    break;
+                }
+                const float x = clip.x() / clip.w(), y = clip.y() / clip.w();
+                minX = c == 0 ? x : std::min(minX, x);
+                maxX = c == 0 ? x : std::max(maxX, x);
+                minY = c == 0 ? y : std::min(minY, y);
+                maxY = c == 0 ? y : std::max(maxY, y);
+            }
+            if (!behind) {
+                if (maxX < bounds.left() || minX > bounds.right() || maxY < bounds.top() || minY > bounds.bottom()) {
+                    continue;
+                }
+                // 사각형은 볼록하므로 꼭짓점이 모두 안이면 노드의 발자국 전체가 안 (구간은 연속이므로 양 끝 잎만 찾음)
+                if (isRect && minX >= bounds.left() && maxX <= bounds.right()
+                    && minY >= bounds.top() && maxY <= bounds.bottom()) {
+                    const SplatBvh::Node *first = &node;
+                    while (first->count == 0) first = &nodes[first->first];
+                    const SplatBvh::Node *last = &node;
+                    while (last->count == 0) last = &nodes[last->first + 1];
+                    addRange(first->first, last->first + last->count);
+                    continue;
+                }
+            }
+
+            if (node.count > 0) {
+                for (quint32 i = node.first; i < node.first + node.count; ++i) addIfTouching(i);
+            } else {
+                stack.push_back(node.first);
+                stack.push_back(node.first + 1);
+            }
+        }
+    }
+}
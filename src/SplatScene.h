@@ -0,0 +1,246 @@
+#ifndef SPLATSCENE_H
+#define SPLATSCENE_H
+
+#include <QString>
+#include <QMatrix4x4>
+#include <QVector3D>
+#include <QVector4D>
+#include <QPolygonF>
+#include <vector>
+#include "GaussianData.h"
+#include "SpatialOrder.h"
+#include "ShCodebook.h"
+#include "SplatBvh.h"
+
+// 씬 배치용 변환 (UI에서 다루기 쉬운 형태)
+struct SceneTransform {
+    QVector3D translation;
+    float yawDegrees = 0.0f; // Y축 회전
+    float scale = 1.0f;      // 균등 스케일
+
+    QMatrix4x4 matrix() const;
+};
+
+// 그리기 목록의 인스턴스 하나 = (씬 슬롯, 씬 내부 인덱스)를 32비트에 묶은 값
+// 상위 4비트: 씬 슬롯, 하위 28비트: 인덱스 (씬당 최대 2억 6천만 개)
+namespace SplatRef
+{
+    const int SLOT_SHIFT = 28;
+    const quint32 INDEX_MASK = (1u << SLOT_SHIFT) - 1u;
+    const int MAX_SLOTS = 1 << (32 - SLOT_SHIFT);
+
+    inline quint32 make(int slot, quint32 index) { return (quint32(slot) << SLOT_SHIFT) | index; }
+    inline int slot(quint32 ref) { return int(ref >> SLOT_SHIFT); }
+    inline quint32 index(quint32 ref) { return ref & INDEX_MASK; }
+}
+
+// 광선 피킹 결과 (SplatScene::pick)
+struct SplatPick {
+    bool hit = false;
+    QVector3D point;       // 월드 좌표
+    float distance = 0.0f; // 광선 원점에서의 거리
+    quint32 ref = 0;       // 그 지점의 스플랫 (SplatRef)
+    float coverage = 0.0f; // 그 지점까지 누적된 불투명도
+    int visitedNodes = 0;
+    int testedSplats = 0;
+};
+
+// 독립적으로 불러온 캡처 하나
+// 스플랫은 로컬 좌표로 보관하고, 씬별 모델 행렬로 배치합니다.
+class SplatScene
+{
+public:
+    SplatScene(const QString &name, std::vector<RenderSplat> splats);
+
+    const QString &name() const { return m_name; }
+    const std::vector<RenderSplat> &splats() const { return m_splats; }
+    int splatCount() const { return static_cast<int>(m_splats.size()); }
+
+    const SceneTransform &transform() const { return m_transform; }
+    const QMatrix4x4 &modelMatrix() const { return m_model; }
+    void setTransform(const SceneTransform &transform);
+
+    bool isVisible() const { return m_visible; }
+    void setVisible(bool visible) { m_visible = visible; }
+
+    // SH 코드북 (.s2vq로 불러온 씬만, 인덱스는 스플랫 순서와 같음)
+    void setShPalette(ShPalette palette) { m_sh = std::move(palette); }
+    const ShPalette &shPalette() const { return m_sh; }
+    bool hasShPalette() const { return !m_sh.isEmpty(); }
+
+    // Morton 순서로 재배치 (로드 직후 한 번). 인덱스가 바뀌므로 정렬/가지치기 캐시도 다시 만들고 활성 집합은 버립니다.
+    // 부산물로 공간적으로 연속된 클러스터의 AABB를 보관합니다 (클러스터 c = 인덱스 [c * CLUSTER_SIZE, ...)).
+    // 재배치 뒤 SH 인덱스/가지치기 인덱스/BVH는 TaskGraph로 병렬로 만듦. withBvh가 false면 BVH는 건너뜀 (헤드리스 렌더러)
+    static const quint32 CLUSTER_SIZE = 1024;
+    void reorderSpatially(bool withBvh = true);
+    const QString &prepareTiming() const { return m_prepareTiming; } // 마지막 재배치의 단계별 시간
+    const std::vector<SplatCluster> &clusters() const { return m_clusters; }
+
+    // 클러스터 컬링 (시야 밖/가려짐): culled[c]가 0이 아니면 클러스터 c는 정렬(= 그리기 목록)에서 빠짐
+    // 빈 목록 = 컬링 없음. 활성 집합(스트리밍)을 쓰거나 클러스터가 없으면 무시합니다.
+    // 컬링 집합이 바뀌었으면 다음 정렬이 다시 돌아야 하므로 true
+    bool setCulledClusters(const std::vector<quint8> &culled);
+    bool hasCulledClusters() const { return !m_clusterCulled.empty(); }
+    // 클러스터마다 그리기 집합(가지치기 + 중요도 한도)에 드는 스플랫 수 (컬링 통계용, 집합이 바뀌면 다시 셈)
+    const std::vector<quint32> &clusterDrawCounts();
+
+    // 그릴 스플랫 부분 집합 (청크 스트리밍 시 GPU에 상주하는 슬롯 범위만)
+    // 설정하지 않으면 전체를 그립니다. 정렬과 그리기 목록은 이 집합만 다룹니다.
+    void setActiveIndices(std::vector<quint32> indices);
+    // 활성 집합 끝에 덧붙임 (새로 온 것만 거름, 점진적으로 도착하는 씬용)
+    void appendActiveIndices(const std::vector<quint32> &indices);
+    void clearActiveIndices();
+    bool hasActiveSet() const { return m_hasActiveSet; }
+
+    // 알파 컷오프 가지치기
+    // 셰이더의 알파는 중심에서 opacity가 최대이므로 opacity < cutoff인 스플랫은 모든 프래그먼트가 discard됩니다.
+    // 이런 스플랫과 스케일/회전이 비정상(0, NaN, Inf)인 스플랫을 정렬/그리기 집합에서 뺍니다.
+    // 불투명도 오름차순 인덱스를 미리 만들어 두므로 컷오프가 바뀌면 경계만 이분 탐색하고,
+    // 정렬 결과도 빠지는 것만 걸러내거나 새로 들어오는 것만 정렬해 병합합니다 (전체 재정렬 없음).
+    bool setPruneCutoff(float cutoff); // 그리기 집합이 바뀌었으면 true
+    int prunedCount() const;
+    static bool isDegenerate(const RenderSplat &s);
+
+    int drawCount() const
+    {
+        return m_hasActiveSet ? static_cast<int>(m_active.size()) : static_cast<int>(m_limitedCount);
+    }
+    // 중요도 한도를 적용하기 전의 그리기 집합 크기
+    int fullDrawCount() const
+    {
+        return m_hasActiveSet ? static_cast<int>(m_active.size())
+                              : static_cast<int>(m_opacityOrder.size() - m_pruneBegin);
+    }
+
+    // 중요도 접두부 (점진적 정제용)
+    // 중요도 = opacity x 가장 큰 두 축 스케일의 곱 (타원의 최대 투영 면적에 비례, 뷰 거리 항은 빼서 뷰와 무관하게).
+    // 인덱스를 만들 때 한 번 정렬해 두고, 한도를 주면 그리기 집합 중 중요도 상위 maxSplats개만 정렬/그리기 대상입니다.
+    // 활성 집합(스트리밍)은 자체 메모리 예산으로 크기가 정해지므로 한도를 적용하지 않습니다.
+    static const size_t NO_LIMIT = size_t(-1);
+    bool setImportanceLimit(size_t maxSplats); // 그리기 집합이 바뀌었으면 true
+    size_t importanceLimit() const { return m_importanceLimit; }
+
+    // 그리기 집합을 메모리 순서대로 순회 (Morton 재배치 후의 지역성을 살리기 위해 불투명도 순서로 돌지 않음)
+    template <typename Fn>
+    void forEachDrawn(Fn fn) const
+    {
+        if (m_hasActiveSet) {
+            for (quint32 i : m_active) fn(i);
+            return;
+        }
+        const size_t count = m_splats.size();
+        for (size_t i = 0; i < count; ++i) {
+            if (m_opacityByIndex[i] >= m_pruneThreshold && m_importanceRank[i] < m_rankLimit) fn(quint32(i));
+        }
+    }
+
+    // 그리기 집합에 드는가 (가지치기 기준, 활성 집합을 쓰는 중이면 항상 true)
+    bool isDrawn(quint32 index) const { return m_hasActiveSet || m_opacityByIndex[index] >= m_pruneThreshold; }
+    // 중요도 한도까지 반영한 판정 (forEachDrawn과 같음, 활성 집합이 없을 때만)
+    bool isInDrawSet(quint32 index) const
+    {
+        return m_opacityByIndex[index] >= m_pruneThreshold && m_importanceRank[index] < m_rankLimit;
+    }
+
+    // 피킹/선택용 BVH (reorderSpatially에서 빌드, 스플랫을 덮어쓰면 버림 -> 없는 씬은 피킹/선택에서 빠짐)
+    bool hasBvh() const { return m_hasBvh; }
+    const SplatBvh &bvh() const { return m_bvh; }
+    double bvhBuildMs() const { return m_bvhBuildMs; } // 마지막 빌드에 걸린 시간
+
+    // 여러 씬에 걸친 광선 피킹
+    // BVH 노드를 진입 거리 순으로 방문하며 발자국 교차를 앞 -> 뒤로 누적하고,
+    // 누적 불투명도가 coverageTarget을 넘는 지점에서 멈춥니다 (끝까지 못 넘으면 기여가 가장 큰 스플랫).
+    // dir은 정규화된 월드 방향. 발자국은 셰이더와 같이 view의 빌보드 축과 전역 스케일(UI 슬라이더)로 정합니다.
+    static SplatPick pick(const std::vector<const SplatScene *> &scenes, const std::vector<int> &sceneSlots,
+                          const QVector3D &origin, const QVector3D &dir, const QMatrix4x4 &view,
+                          float globalScale, float coverageTarget = 0.5f);
+
+    // 화면 영역 선택: 그린 발자국이 region(NDC 다각형)과 겹치는 그리기 집합 스플랫 (가려진 것도 포함)
+    // isRect면 region을 축 정렬 사각형으로 보고, 통째로 안에 든 노드는 스플랫 검사 없이 받아들임
+    static void selectRegion(const std::vector<const SplatScene *> &scenes, const std::vector<int> &sceneSlots,
+                             const QMatrix4x4 &view, const QMatrix4x4 &projection, float globalScale,
+                             const QPolygonF &region, bool isRect, std::vector<quint32> &outRefs);
+
+    // 스플랫 일부 덮어쓰기 (스트리밍 슬롯 교체용, 정렬 캐시 무효화)
+    void writeSplats(size_t offset, const std::vector<RenderSplat> &splats);
+
+    // 이 뷰로 볼 때 다시 정렬해야 하는가?
+    // 정렬 결과는 (View * Model)의 깊이 행에만 의존하므로,
+    // 카메라가 움직이면 모든 씬이, 씬 하나를 옮기면 그 씬만 다시 정렬됩니다.
+    bool needsSort(const QMatrix4x4 &view) const;
+
+    // 뒤 -> 앞 순서로 정렬 (씬마다 독립적이므로 여러 씬을 병렬로 호출해도 안전)
+    // 큰 씬은 구간별로 키를 만들고 정렬한 뒤 병렬 병합합니다 (스케줄러 작업이므로 씬별 병렬 호출 안에서도 나뉨).
+    void sortBackToFront(const QMatrix4x4 &view);
+    void invalidateSort() { m_sorted = false; }
+
+    // 정렬 결과: 상위 32비트 = 깊이 키(오름차순 = 먼 것부터), 하위 32비트 = 스플랫 인덱스
+    const std::vector<quint64> &sortedKeys() const { return m_sortedKeys; }
+
+    // 여러 씬의 정렬 결과를 k-way merge로 하나의 뒤 -> 앞 그리기 목록으로 합침
+    // scenes[i]는 슬롯 sceneSlots[i]로 참조됩니다.
+    static void mergeBackToFront(const std::vector<const SplatScene *> &scenes,
+                                 const std::vector<int> &sceneSlots,
+                                 std::vector<quint32> &outRefs);
+
+    // 깊이 키 <-> float 변환 (부호 있는 float를 정렬 가능한 uint로)
+    static quint32 depthToKey(float depth);
+
+private:
+    QString m_name;
+    std::vector<RenderSplat> m_splats;
+
+    SceneTransform m_transform;
+    QMatrix4x4 m_model;
+    bool m_visible = true;
+
+    std::vector<SplatCluster> m_clusters;
+    std::vector<quint8> m_clusterCulled;     // 비어 있으면 컬링 없음
+    std::vector<quint32> m_clusterDrawCounts;
+    bool m_clusterDrawCountsDirty = true;
+    bool isClusterCulled(size_t index) const
+    {
+        return !m_clusterCulled.empty() && m_clusterCulled[index / CLUSTER_SIZE];
+    }
+    ShPalette m_sh;
+
+    SplatBvh m_bvh;
+    bool m_hasBvh = false;
+    double m_bvhBuildMs = 0.0;
+    QString m_prepareTiming;
+
+    bool m_hasActiveSet = false;
+    std::vector<quint32> m_activeAll; // 지정된 활성 집합 전체
+    std::vector<quint32> m_active;    // 그중 컷오프를 통과한 것
+
+    // 가지치기 인덱스: 비정상 스플랫이 맨 앞, 나머지는 불투명도 오름차순
+    void buildPruneIndex();
+    size_t pruneBoundary(float cutoff) const;
+    static float thresholdFor(float cutoff);
+    void filterActive();
+    std::vector<quint32> m_opacityOrder;
+    std::vector<float> m_pruneKeys;   // m_opacityOrder 순서의 불투명도 (비정상 = -1)
+    std::vector<float> m_opacityByIndex; // 같은 값을 인덱스 순서로 (순차 순회용)
+    float m_pruneThreshold = 0.0f;    // 이 값 이상이면 그리기 집합
+    size_t m_pruneBegin = 0;          // 이 위치부터 그리기 집합
+    float m_pruneCutoff = 0.0f;
+    bool m_pruneIndexDirty = false;
+
+    // 중요도 인덱스: 내림차순 순서와 인덱스별 순위. 순위 < m_rankLimit인 것만 그리기 집합
+    void updateRankLimit();
+    std::vector<quint32> m_importanceOrder;
+    std::vector<quint32> m_importanceRank;
+    size_t m_importanceLimit = NO_LIMIT;
+    quint32 m_rankLimit = 0xFFFFFFFFu;
+    size_t m_limitedCount = 0; // 한도 적용 후 그리기 집합 크기
+
+    // 정렬 캐시
+    bool m_sorted = false;
+    QVector4D m_sortedDepthRow; // 마지막 정렬에 쓴 (View * Model)의 3행
+    std::vector<quint64> m_sortedKeys;
+    std::vector<std::vector<quint64>> m_partKeys; // 병렬 정렬의 구간별 키 (용량을 재사용)
+    std::vector<size_t> m_partBounds;             // 구간 경계 (같은 이유로 멤버)
+    std::vector<quint64> m_sortTemp;              // 병합 버퍼
+};
+
+#endif // SPLATSCENE_H
@@ -0,0 +1,227 @@
+#include "SplatShaders.h"
+#include "Parallel.h"
+
+std::vector<float> SplatShaders::packSplats(const RenderSplat *splats, size_t count, const quint16 *shIndices)
+{
+    std::vector<float> packed(count * FLOATS_PER_SPLAT);
+    parallelForRange(0, count, 65536, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const RenderSplat &s = splats[i];
+            float *p = &packed[i * FLOATS_PER_SPLAT];
+            p[0] = s.x;        p[1] = s.y;        p[2] = s.z;        p[3] = s.opacity;
+            p[4] = s.r;        p[5] = s.g;        p[6] = s.b;        p[7] = shIndices ? float(shIndices[i]) : -1.0f;
+            p[8] = s.scale[0]; p[9] = s.scale[1]; p[10] = s.scale[2]; p[11] = 0.0f;
+            p[12] = s.rot[0];  p[13] = s.rot[1];  p[14] = s.rot[2];  p[15] = s.rot[3];
+        }
+    });
+    return packed;
+}
+
+int SplatShaders::appendShCodebook(const ShPalette &palette, std::vector<float> &packed)
+{
+    const int base = static_cast<int>(packed.size() / (SH_TEXELS_PER_ENTRY * 4));
+    for (int e = 0; e < palette.entryCount(); ++e) {
+        const float *coeffs = palette.entry(e);
+        packed.insert(packed.end(), coeffs, coeffs + ShPalette::COEFFS);
+        packed.resize(packed.size() + SH_TEXELS_PER_ENTRY * 4 - ShPalette::COEFFS, 0.0f);
+    }
+    return base;
+}
+
+const char *SplatShaders::splatVertexSource()
+{
+    return R"(
+        #version 330 core
+        layout(location = 0) in vec2 aQuadPos;
+        layout(location = 1) in uint aSplatRef; // (씬 슬롯 << 28) | 씬 내부 인덱스
+
+        // 씬별 스플랫 데이터 (스플랫당 texel 4개, packSplats 참고)
+        // GLSL 3.30에서는 샘플러 배열을 상수로만 인덱싱할 수 있어 개별 샘플러로 둡니다.
+        uniform samplerBuffer uScene0;
+        uniform samplerBuffer uScene1;
+        uniform samplerBuffer uScene2;
+        uniform samplerBuffer uScene3;
+        uniform samplerBuffer uScene4;
+        uniform samplerBuffer uScene5;
+        uniform samplerBuffer uScene6;
+        uniform samplerBuffer uScene7;
+
+        uniform mat4 uModel[8];
+        uniform float uModelScale[8];
+
+        // SH 코드북 (항목당 texel 12개, 계수 배치는 [R 15][G 15][B 15], ShCodebook.h 참고)
+#ifdef SPLAT_SH
+        uniform samplerBuffer uShCodebook;
+        uniform int uShBase[8];
+        uniform vec3 uCameraLocal[8];
+#endif
+
+        uniform mat4 vp_matrix;
+        uniform vec3 cameraRight;
+        uniform vec3 cameraUp;
+        uniform float uGlobalScale;
+#ifdef SPLAT_DEPTH_CORE
+        uniform float uCoreAlpha;
+        uniform vec3 uCameraForward; // 월드 공간 시선 방향 (카메라에서 멀어지는 쪽)
+#endif
+
+        out vec3 vColor;
+        out vec2 vQuadPos;
+        out float vOpacity;
+        out float vViewDepth; // 시간적 업스케일 재투영용 (카메라 공간 거리)
+
+        vec4 fetchSplat(uint slot, int texel) {
+            switch (slot) {
+            case 0u: return texelFetch(uScene0, texel);
+            case 1u: return texelFetch(uScene1, texel);
+            case 2u: return texelFetch(uScene2, texel);
+            case 3u: return texelFetch(uScene3, texel);
+            case 4u: return texelFetch(uScene4, texel);
+            case 5u: return texelFetch(uScene5, texel);
+            case 6u: return texelFetch(uScene6, texel);
+            default: return texelFetch(uScene7, texel);
+            }
+        }
+
+#ifdef SPLAT_SH
+        // 1~3차 SH 항 (ShCodebook::evaluate와 같은 기저)
+        vec3 evalSh(int entry, vec3 d) {
+            float xx = d.x * d.x, yy = d.y * d.y, zz = d.z * d.z;
+            float basis[15] = float[15](
+                -0.48860251 * d.y, 0.48860251 * d.z, -0.48860251 * d.x,
+                1.09254843 * d.x * d.y, -1.09254843 * d.y * d.z, 0.31539157 * (2.0 * zz - xx - yy),
+                -1.09254843 * d.x * d.z, 0.54627422 * (xx - yy),
+                -0.59004359 * d.y * (3.0 * xx - yy), 2.89061144 * d.x * d.y * d.z,
+                -0.45704580 * d.y * (4.0 * zz - xx - yy), 0.37317633 * d.z * (2.0 * zz - 3.0 * xx - 3.0 * yy),
+                -0.45704580 * d.x * (4.0 * zz - xx - yy), 1.44530572 * d.z * (xx - yy),
+                -0.59004359 * d.x * (xx - 3.0 * yy));
+
+            vec3 rgb = vec3(0.0);
+            int base = entry * 12;
+            for (int t = 0; t < 12; ++t) {
+                vec4 v = texelFetch(uShCodebook, base + t);
+                for (int c = 0; c < 4; ++c) {
+                    int k = t * 4 + c;
+                    if (k < 45) rgb[k / 15] += basis[k % 15] * v[c];
+                }
+            }
+            return rgb;
+        }
+#endif
+
+        void main() {
+            uint slot = aSplatRef >> 28;
+            int base = int(aSplatRef & 0x0FFFFFFFu) * 4;
+
+            vec4 posOpacity = fetchSplat(slot, base + 0);
+            vec4 color = fetchSplat(slot, base + 1);
+            vec4 scale = fetchSplat(slot, base + 2);
+
+            // UI에서 받은 스케일 + 씬 스케일 적용
+            float scaleFactor = uGlobalScale * uModelScale[slot];
+            vec2 quad = aQuadPos;
+
+#ifdef SPLAT_DEPTH_CORE
+            // 불투명 코어: opacity * exp(-3 r^2) >= uCoreAlpha인 반지름 안쪽만 래스터화
+            float coreSq = log(posOpacity.w / uCoreAlpha) / 3.0;
+            if (coreSq <= 0.0) {
+                gl_Position = vec4(2.0, 2.0, 2.0, 1.0); // 클립 공간 밖 = 그리지 않음
+                return;
+            }
+            quad *= sqrt(min(coreSq, 1.0));
+#endif
+
+            vec3 center = (uModel[slot] * vec4(posOpacity.xyz, 1.0)).xyz;
+            vec3 worldPos = center
+                          + (cameraRight * quad.x * scale.x * scaleFactor)
+                          + (cameraUp * quad.y * scale.y * scaleFactor);
+
+#ifdef SPLAT_DEPTH_CORE
+            // 코어를 스플랫의 가장 긴 축만큼 뒤로 밀어 씀 (보수적)
+            // -> 가리는 스플랫 자신과 같은 표면의 이웃은 블렌딩 패스의 깊이 테스트를 통과
+            // (cameraRight/cameraUp은 빌보드용 뷰 행렬 열이라 카메라 기저가 아님 -> 시선 방향은 따로 받음)
+            worldPos += uCameraForward * max(scale.x, max(scale.y, scale.z)) * scaleFactor;
+#endif
+
+            gl_Position = vp_matrix * vec4(worldPos, 1.0);
+            vColor = color.rgb;
+#ifdef SPLAT_SH
+            if (color.w >= 0.0) {
+                vec3 dir = normalize(posOpacity.xyz - uCameraLocal[slot]);
+                vColor = clamp(color.rgb + evalSh(uShBase[slot] + int(color.w), dir), 0.0, 1.0);
+            }
+#endif
+            vQuadPos = quad;
+            vOpacity = posOpacity.w;
+            vViewDepth = gl_Position.w;
+        }
+    )";
+}
+
+// 가우시안 효과의 핵심
+const char *SplatShaders::splatFragmentSource()
+{
+    return R"(
+        #version 330 core
+        in vec3 vColor;
+        in vec2 vQuadPos;
+        in float vOpacity;
+        in float vViewDepth;
+
+#ifdef SPLAT_ALPHA_CUTOFF
+        uniform float uAlphaCutoff;
+#endif
+#ifdef SPLAT_DEPTH_CORE
+        uniform float uCoreAlpha;
+#endif
+
+        layout(location = 0) out vec4 FragColor;
+#ifdef SPLAT_DEPTH_OUTPUT
+        // 두 번째 타겟에 같은 블렌딩으로 (깊이 x 가중치, 커버리지)를 누적 -> 평균 깊이 = r / g
+        layout(location = 1) out vec4 DepthOut;
+#endif
+
+        void main() {
+            // 중심에서의 거리 제곱 (x^2 + y^2)
+            float distSq = dot(vQuadPos, vQuadPos);
+
+            // 1. 원형 클리핑: 반지름 1을 넘으면 그리지 않고 버림 (사각형을 원으로 만듦)
+            if (distSq > 1.0) discard;
+
+            // 2. 가우시안 감쇠 (Gaussian Falloff)
+            // 중심(0)일 때 1, 가장자리(1)로 갈수록 0에 가깝게 줄어듦
+            // exp(-x) 그래프 형태를 사용
+            float alpha = vOpacity * exp(-distSq * 3.0);
+
+#ifdef SPLAT_ALPHA_CUTOFF
+            // UI에서 받은 컷오프 적용
+            if (alpha < uAlphaCutoff) discard;
+#endif
+#ifdef SPLAT_DEPTH_CORE
+            // 깊이 프리패스: 거의 불투명한 부분만 깊이를 씀 (색은 쓰지 않음)
+            if (alpha < uCoreAlpha) discard;
+#endif
+
+#ifdef SPLAT_PREMULTIPLY
+            // Front-to-Back(Under 연산자)용 premultiplied 출력
+            FragColor = vec4(vColor * alpha, alpha);
+#else
+            FragColor = vec4(vColor, alpha);
+#endif
+#ifdef SPLAT_DEPTH_OUTPUT
+            DepthOut = vec4(vViewDepth, 1.0, 0.0, alpha);
+#endif
+        }
+    )";
+}
+
+QByteArrayList SplatShaders::featureDefines(quint32 features)
+{
+    QByteArrayList defines;
+    if (features & Feature_Sh) defines << "SPLAT_SH";
+    if (features & Feature_AlphaCutoff) defines << "SPLAT_ALPHA_CUTOFF";
+    if (features & Feature_Premultiply) defines << "SPLAT_PREMULTIPLY";
+    if (features & Feature_DepthOutput) defines << "SPLAT_DEPTH_OUTPUT";
+    if (features & Feature_DepthCore) defines << "SPLAT_DEPTH_CORE";
+    return defines;
+}
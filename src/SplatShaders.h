@@ -0,0 +1,41 @@
+#ifndef SPLATSHADERS_H
+#define SPLATSHADERS_H
+
+#include <QByteArrayList>
+#include <vector>
+#include "GaussianData.h"
+#include "ShCodebook.h"
+
+// 스플랫 셰이더 소스와 셰이더가 읽는 GPU 데이터 레이아웃
+// 뷰어(SplattingWidget)와 헤드리스 배치 렌더러(BatchRenderer)가 같은 것을 씁니다.
+namespace SplatShaders
+{
+    // 셰이더에서 texelFetch로 읽기 좋게 스플랫 하나를 vec4 4개(16 float)로 패킹
+    // [0] x, y, z, opacity  [1] r, g, b, SH 코드북 인덱스(-1 = 없음)  [2] scale xyz, -  [3] rot (r, x, y, z)
+    const int FLOATS_PER_SPLAT = 16;
+    std::vector<float> packSplats(const RenderSplat *splats, size_t count, const quint16 *shIndices = nullptr);
+
+    // SH 코드북 항목 하나 = texel 12개 (48 float 중 45개 사용)
+    // packed 끝에 palette를 이어 붙이고, 첫 항목의 위치(항목 단위)를 반환 (셰이더의 uShBase)
+    const int SH_TEXELS_PER_ENTRY = 12;
+    int appendShCodebook(const ShPalette &palette, std::vector<float> &packed);
+
+    // 인스턴스마다 SplatRef 하나를 받아 씬 TBO에서 스플랫을 읽는 정점 셰이더와 가우시안 프래그먼트 셰이더
+    // 유니폼: uScene0..7, uModel[8], uModelScale[8], vp_matrix, cameraRight, cameraUp, uGlobalScale,
+    //         uShCodebook, uShBase[8], uCameraLocal[8], uAlphaCutoff, uCoreAlpha, uCameraForward
+    // SH/컷오프/코어 유니폼은 해당 기능이 켜진 변형에만 있습니다.
+    const char *splatVertexSource();
+    const char *splatFragmentSource();
+
+    // 셰이더 변형: 유니폼 분기 대신 #define으로 기능별 프로그램을 따로 빌드 (ShaderCache)
+    enum Feature : quint32 {
+        Feature_Sh = 1u << 0,          // SPLAT_SH: SH 코드북으로 시점 의존 색
+        Feature_AlphaCutoff = 1u << 1, // SPLAT_ALPHA_CUTOFF: uAlphaCutoff 미만 discard (0이면 끔)
+        Feature_Premultiply = 1u << 2, // SPLAT_PREMULTIPLY: Front-to-Back(Under)용 premultiplied 출력
+        Feature_DepthOutput = 1u << 3, // SPLAT_DEPTH_OUTPUT: location 1에 깊이 누적 (시간적 업스케일)
+        Feature_DepthCore = 1u << 4,   // SPLAT_DEPTH_CORE: 깊이 프리패스 (alpha >= uCoreAlpha인 코어만, 스플랫 뒤쪽 깊이)
+    };
+    QByteArrayList featureDefines(quint32 features);
+}
+
+#endif // SPLATSHADERS_H
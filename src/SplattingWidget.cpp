@@ -1,6 +1,107 @@
 #include "SplattingWidget.h"
-#include <QPainter>
+#include "Parallel.h"
+#include "SplatShaders.h"
+#include "AllocCounter.h"
+#include <QCoreApplication>
 #include <QDebug>
+#include <QFileInfo>
+#include <QScreen>
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// GL_ARB_pipeline_statistics_query (GL 4.6 코어). 3.3 헤더에는 없을 수 있음
+#ifndef GL_FRAGMENT_SHADER_INVOCATIONS_ARB
+#define GL_FRAGMENT_SHADER_INVOCATIONS_ARB 0x82F4
+#endif
+// GL 3.3 코어 (ES 기반 QOpenGLExtraFunctions 헤더에는 없을 수 있음)
+#ifndef GL_TIME_ELAPSED
+#define GL_TIME_ELAPSED 0x88BF
+#endif
+
+namespace {
+
+// Halton 저불일치 수열 (시간적 업스케일 지터). index >= 1
+float halton(int index, int base)
+{
+    float f = 1.0f, result = 0.0f;
+    while (index > 0) {
+        f /= base;
+        result += f * (index % base);
+        index /= base;
+    }
+    return result;
+}
+
+// 시점 스윕 (sweepPoses): 현재 시점 기준 (yaw, pitch) 오프셋, 도. 첫 항목 = 현재 시점
+// 시선 방향에 의존하는 경로(깊이 코어를 미는 방향 등)가 기본 시점에서만 맞는 경우를 잡도록 축에서 벗어난 시점을 섞음
+const float SWEEP_POSES[][2] = {
+    { 0.0f, 0.0f }, { 90.0f, 0.0f }, { -135.0f, 30.0f }, { 45.0f, -35.0f }, { 180.0f, -60.0f }
+};
+
+// Weighted Blended OIT 누적 셰이더 (McGuire & Bavoil 2013)
+// 정점 셰이더는 정렬 모드와 공유하고, 결과를 두 타겟에 나눠 씁니다.
+const char *const OIT_FRAGMENT_SOURCE = R"(
+    #version 330 core
+    in vec3 vColor;
+    in vec2 vQuadPos;
+    in float vOpacity;
+
+#ifdef SPLAT_ALPHA_CUTOFF
+    uniform float uAlphaCutoff;
+#endif
+
+    layout(location = 0) out vec4 outAccum;   // sum(w * a * rgb), sum(w * a)
+    layout(location = 1) out vec4 outReveal;  // sum(log(1 - a))
+
+    void main() {
+        float distSq = dot(vQuadPos, vQuadPos);
+        if (distSq > 1.0) discard;
+
+        float alpha = vOpacity * exp(-distSq * 3.0);
+#ifdef SPLAT_ALPHA_CUTOFF
+        if (alpha < uAlphaCutoff) discard;
+#endif
+
+        // log(0) 방지
+        alpha = min(alpha, 0.99);
+
+        // 깊이 가중치: 가까운 조각이 더 큰 비중을 갖도록 (논문 식 (9))
+        // gl_FragCoord.w = 1 / clip.w 이고, 원근 투영에서 clip.w는 카메라와의 거리입니다.
+        float viewZ = 1.0 / gl_FragCoord.w;
+        float w = alpha * clamp(10.0 / (1e-5 + pow(viewZ / 5.0, 2.0) + pow(viewZ / 200.0, 6.0)), 1e-2, 3e3);
+
+        outAccum = vec4(vColor * alpha, alpha) * w;
+        outReveal = vec4(log(1.0 - alpha), 0.0, 0.0, 0.0);
+    }
+)";
+
+// 오버드로 카운트: discard 대신 판정 결과를 G에 기록해
+// 래스터화된 수(R)와 실제로 합성되는 수(G)를 한 번에 셈
+const char *const OVERDRAW_FRAGMENT_SOURCE = R"(
+    #version 330 core
+    in vec2 vQuadPos;
+    in float vOpacity;
+
+#ifdef SPLAT_ALPHA_CUTOFF
+    uniform float uAlphaCutoff;
+#endif
+
+    out vec4 outCount;
+
+    void main() {
+        float distSq = dot(vQuadPos, vQuadPos);
+        float alpha = vOpacity * exp(-distSq * 3.0);
+        bool kept = distSq <= 1.0;
+#ifdef SPLAT_ALPHA_CUTOFF
+        kept = kept && alpha >= uAlphaCutoff;
+#endif
+        outCount = vec4(1.0, kept ? 1.0 : 0.0, 0.0, 0.0);
+    }
+)";
+
+} // namespace
 
 SplattingWidget::SplattingWidget(QWidget *parent)
     : QOpenGLWidget(parent)
@@ -8,6 +109,43 @@ SplattingWidget::SplattingWidget(QWidget *parent)
     // [추가] 이 위젯이 마우스 클릭/휠 이벤트를 받을 수 있도록 설정
     setFocusPolicy(Qt::StrongFocus);
 
+    // 렌더 패스와 각 패스가 읽는 입력 선언
+    // Post 패스는 Splat 패스 결과(m_fbo)를 읽으므로 Splat이 다시 그려지면 같이 더티가 됩니다.
+    m_sortPass = m_renderGraph.addPass("Sort",
+                                       Input_Camera | Input_SplatData | Input_RenderMode | Input_SceneLayout
+                                       | Input_DrawBudget | Input_OcclusionCulling);
+    m_splatPass = m_renderGraph.addPass("Splat",
+                                        Input_Camera | Input_SplatData | Input_GlobalScale | Input_AlphaCutoff
+                                        | Input_RenderMode | Input_SceneLayout | Input_Jitter | Input_DrawBudget
+                                        | Input_DepthPrepass,
+                                        m_sortPass);
+    m_postPass = m_renderGraph.addPass("Post",
+                                       Input_Sharpness | Input_FilterMode | Input_WindowSize,
+                                       m_splatPass);
+
+    // 스트리밍 갱신은 그리기와 별개로 주기적으로 (카메라가 멈춰 있어도 로드 완료분을 반영)
+    m_streamTimer.setInterval(33);
+    connect(&m_streamTimer, &QTimer::timeout, this, &SplattingWidget::updateStreaming);
+
+    connect(&m_remote, &HttpPlyStream::headerReady, this, &SplattingWidget::onRemoteHeader);
+    connect(&m_remote, &HttpPlyStream::chunkReady, this, &SplattingWidget::onRemoteChunk);
+    connect(&m_remote, &HttpPlyStream::finished, this, &SplattingWidget::onRemoteFinished);
+    m_remoteActiveTimer.setSingleShot(true);
+    m_remoteActiveTimer.setInterval(REMOTE_ACTIVE_INTERVAL_MS);
+    connect(&m_remoteActiveTimer, &QTimer::timeout, this, &SplattingWidget::applyRemoteActive);
+
+    // 스왑 완료 시각 (지연 측정 + 늦은 프레임 시작의 vblank 추정)
+    connect(this, &QOpenGLWidget::frameSwapped, this, [this]() { m_latency.framePresented(); });
+    m_frameStartTimer.setSingleShot(true);
+    m_frameStartTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_frameStartTimer, &QTimer::timeout, this, [this]() { update(); });
+    connect(this, &QOpenGLWidget::frameSwapped, this, &SplattingWidget::advanceAllocationCheck);
+
+    // 점진적 정제: 마지막 입력 후 PROGRESSIVE_IDLE_MS가 지나면 전체 집합으로
+    m_idleTimer.setSingleShot(true);
+    m_idleTimer.setInterval(PROGRESSIVE_IDLE_MS);
+    connect(&m_idleTimer, &QTimer::timeout, this, &SplattingWidget::onInteractionIdle);
+
     m_fpsTimer.start(); // 타이머 시작
 }
 
@@ -15,212 +153,2329 @@ SplattingWidget::~SplattingWidget()
 {
     makeCurrent();
     delete m_fbo;
-    delete m_program;
-    m_instanceVbo.destroy();
+    delete m_oitFbo;
+    delete m_overdrawFbo;
+    m_overlay.destroy();
+    m_splatPrograms.clear();
+    m_shaderCache.clear();
+    if (m_saturationFbo) glDeleteFramebuffers(1, &m_saturationFbo);
+    if (!m_passedQueries.empty()) glDeleteQueries(GLsizei(m_passedQueries.size()), m_passedQueries.data());
+    if (!m_shadedQueries.empty()) glDeleteQueries(GLsizei(m_shadedQueries.size()), m_shadedQueries.data());
+    if (m_splatTimeQuery) glDeleteQueries(1, &m_splatTimeQuery);
+    delete m_history[0];
+    delete m_history[1];
+    for (SceneGpu &gpu : m_sceneGpu) releaseSceneGpu(gpu);
+    releaseShCodebooks();
+    m_orderVbo.destroy();
+    m_prepassVbo.destroy();
+    m_occluderVbo.destroy();
+    m_hiz.destroy();
     m_quadVbo.destroy();
     m_vao.destroy();
     doneCurrent();
 }
 
 // [핵심] 데이터 로드 및 GPU 업로드
-void SplattingWidget::loadData(const std::vector<RenderSplat>& splats)
+void SplattingWidget::loadData(const std::vector<RenderSplat>& splats, const ShPalette *sh)
 {
     if (splats.empty()) return;
 
-    // 멤버 변수에 복사본 저장
-    m_splats = splats;
-    m_splatCount = static_cast<int>(m_splats.size());
-    m_needsSort = true;
+    removeAllScenes();
+    addScene("Scene 0", splats, true, sh);
+}
+
+int SplattingWidget::addScene(const QString &name, const std::vector<RenderSplat>& splats, bool spatialReorder,
+                              const ShPalette *sh)
+{
+    if (splats.empty()) return -1;
+    if (sceneCount() >= MAX_SCENES) {
+        qWarning() << "Cannot add scene" << name << "- at most" << MAX_SCENES << "scenes are supported.";
+        return -1;
+    }
+    if (splats.size() > SplatRef::INDEX_MASK) {
+        qWarning() << "Scene" << name << "has too many splats for a single scene:" << splats.size();
+        return -1;
+    }
+
+    m_scenes.push_back(std::make_unique<SplatScene>(name, splats));
+    m_sceneGpu.push_back(SceneGpu());
+
+    // 공간 순서로 재배치해 깊이 키 계산/정점 fetch의 캐시 지역성을 높임
+    // (SH 인덱스도 같이 옮겨야 하므로 코드북을 먼저 넘김)
+    SplatScene *scene = m_scenes.back().get();
+    if (sh && !sh->isEmpty()) {
+        if (sh->indices.size() == splats.size()) scene->setShPalette(*sh);
+        else qWarning() << "Scene" << name << "- SH index count does not match splat count, ignoring codebook";
+    }
+    if (spatialReorder) scene->reorderSpatially();
+
+    // 현재 컷오프를 절대 통과하지 못하는 스플랫은 정렬/그리기 집합에서 제외
+    scene->setPruneCutoff(m_alphaCutoff);
+    if (!scene->hasActiveSet()) {
+        qDebug() << "Scene" << name << "- drawing" << scene->drawCount() << "of" << scene->splatCount()
+                 << "splats (" << scene->prunedCount() << "pruned at alpha cutoff" << m_alphaCutoff << ")";
+    }
+
+    int index = sceneCount() - 1;
+    uploadScene(index);
+    if (scene->hasShPalette()) uploadShCodebooks();
+
+    m_sceneSetChanged = true;
+    invalidate(Input_SplatData); // 정렬부터 다시
+    return index;
+}
+
+void SplattingWidget::removeAllScenes()
+{
+    stopStreaming();
+    stopRemoteLoad();
+    if (!m_scenes.empty()) {
+        makeCurrent();
+        for (SceneGpu &gpu : m_sceneGpu) releaseSceneGpu(gpu);
+        releaseShCodebooks();
+        doneCurrent();
+    }
+
+    m_scenes.clear();
+    m_sceneGpu.clear();
+    m_drawList.clear();
+    m_splatCount = 0;
+
+    // 씬 슬롯/인덱스를 가리키는 파생 상태는 다음 씬에서 엉뚱한 스플랫을 가리키므로 씬이 없었어도 모두 버림
+    m_selection.clear();
+    m_lastSelectMs = -1.0;
+    m_lastPick = SplatPick();
+    m_lastPickMs = -1.0;
+    m_prepassList.clear();
+    m_prepassCount = 0;
+    m_prepassDirty = true;
+    m_occluderList.clear();
+    m_cullCandidates.clear();
+    m_cullMasks.clear();
+    m_occlusionStats = OcclusionStats();
+
+    m_sceneSetChanged = true;
+    invalidate(Input_SplatData | Input_DepthPrepass | Input_OcclusionCulling);
+}
+
+bool SplattingWidget::openStreamedScene(const QString &chunkFilePath)
+{
+    removeAllScenes();
+
+    m_streamer.setBudgets(m_streamCpuBudget, m_streamGpuBudget);
+    if (!m_streamer.open(chunkFilePath)) return false;
+
+    // GPU 버퍼 = 청크 슬롯 배열 (슬롯 s는 [s * capacity, (s + 1) * capacity) 범위)
+    // 빈 슬롯은 불투명도 0이라 그려도 보이지 않지만, 애초에 활성 집합에 넣지 않습니다.
+    const size_t capacity = size_t(m_streamer.gpuSlotCount()) * m_streamer.slotCapacity();
+    m_streamSceneIndex = addScene(QFileInfo(chunkFilePath).fileName(), std::vector<RenderSplat>(capacity), false);
+    if (m_streamSceneIndex < 0) {
+        m_streamer.close();
+        return false;
+    }
+    m_scenes[m_streamSceneIndex]->setActiveIndices({});
+
+    qDebug() << "Streaming" << m_streamer.scene().totalSplats() << "splats in"
+             << m_streamer.scene().chunkCount() << "chunks";
+
+    updateStreaming();
+    m_streamTimer.start();
+    return true;
+}
+
+void SplattingWidget::setStreamingBudgets(qint64 cpuBytes, qint64 gpuBytes)
+{
+    m_streamCpuBudget = cpuBytes;
+    m_streamGpuBudget = gpuBytes;
+}
+
+void SplattingWidget::stopStreaming()
+{
+    if (!m_streamer.isOpen()) return;
+    m_streamTimer.stop();
+    m_streamer.close();
+    m_streamSceneIndex = -1;
+    m_streamStats = StreamingStats();
+}
+
+void SplattingWidget::updateStreaming()
+{
+    if (!m_streamer.isOpen() || m_streamSceneIndex < 0) return;
+
+    QMatrix4x4 view = m_camera.getViewMatrix();
+    QMatrix4x4 proj = m_camera.getProjectionMatrix((float)INTERNAL_WIDTH / INTERNAL_HEIGHT);
+    bool changed = m_streamer.update(view, proj);
+
+    SplatScene *scene = m_scenes[m_streamSceneIndex].get();
+    const size_t capacity = m_streamer.slotCapacity();
+
+    // 바뀐 슬롯만 CPU 사본(정렬용)과 GPU 버퍼에 덮어쓰기
+    for (const ChunkStreamer::SlotUpload &upload : m_streamer.takeSlotUploads()) {
+        scene->writeSplats(upload.slot * capacity, *upload.splats);
+        uploadSceneRange(m_streamSceneIndex, upload.slot * capacity, upload.splats->size());
+    }
+
+    if (changed) {
+        // 상주 슬롯의 유효 범위만 활성 집합으로 -> 정렬과 그리기 모두 이 집합만 다룸
+        std::vector<quint32> active;
+        const std::vector<int> &slotChunks = m_streamer.slotChunks();
+        for (size_t slot = 0; slot < slotChunks.size(); ++slot) {
+            if (slotChunks[slot] < 0) continue;
+            quint32 begin = quint32(slot * capacity);
+            quint32 count = m_streamer.scene().chunks()[slotChunks[slot]].splatCount;
+            for (quint32 i = 0; i < count; ++i) active.push_back(begin + i);
+        }
+        scene->setActiveIndices(std::move(active));
+
+        m_sceneSetChanged = true;
+        invalidate(Input_SplatData);
+    }
+
+    // 로드 진행 상황이 바뀌면 오버레이만이라도 갱신
+    StreamingStats stats = m_streamer.stats();
+    bool statsChanged = stats.cpuResidentChunks != m_streamStats.cpuResidentChunks
+                        || stats.gpuResidentChunks != m_streamStats.gpuResidentChunks
+                        || stats.pendingLoads != m_streamStats.pendingLoads
+                        || stats.ioMBps != m_streamStats.ioMBps;
+    m_streamStats = stats;
+    if (statsChanged) update();
+}
+
+bool SplattingWidget::openRemoteScene(const QUrl &url)
+{
+    removeAllScenes();
+    return m_remote.start(url);
+}
+
+void SplattingWidget::stopRemoteLoad()
+{
+    m_remote.abort();
+    m_remoteActiveTimer.stop();
+    m_remoteArrived.clear();
+    m_remoteReceived = 0;
+    m_remoteSceneIndex = -1;
+}
+
+void SplattingWidget::onRemoteHeader(qint64 vertexCount)
+{
+    // 인덱스가 도착 위치에 고정돼야 하므로 재배치 없이 빈 씬으로 시작
+    m_remoteSceneIndex = addScene(m_remote.url().fileName(), std::vector<RenderSplat>(size_t(vertexCount)), false);
+    if (m_remoteSceneIndex < 0) {
+        m_remote.abort();
+        return;
+    }
+    m_scenes[m_remoteSceneIndex]->setActiveIndices({});
+}
+
+void SplattingWidget::onRemoteChunk(qint64 firstSplat, const std::vector<RenderSplat> &splats)
+{
+    if (m_remoteSceneIndex < 0) return;
+
+    m_scenes[m_remoteSceneIndex]->writeSplats(size_t(firstSplat), splats);
+    uploadSceneRange(m_remoteSceneIndex, size_t(firstSplat), splats.size());
+    for (size_t i = 0; i < splats.size(); ++i) m_remoteArrived.push_back(quint32(firstSplat + qint64(i)));
+    m_remoteReceived += qint64(splats.size());
+
+    if (!m_remoteActiveTimer.isActive()) m_remoteActiveTimer.start();
+}
+
+void SplattingWidget::applyRemoteActive()
+{
+    if (m_remoteSceneIndex < 0 || m_remoteArrived.empty()) return;
+    // 지난 반영 이후 온 것만 덧붙임 (전체를 다시 거르면 다운로드 전체로는 제곱 비용)
+    m_scenes[m_remoteSceneIndex]->appendActiveIndices(m_remoteArrived);
+    m_remoteArrived.clear();
+    m_sceneSetChanged = true;
+    invalidate(Input_SplatData);
+}
+
+void SplattingWidget::onRemoteFinished(bool ok, const QString &error)
+{
+    if (m_remoteSceneIndex < 0) return;
+    m_remoteActiveTimer.stop();
+
+    if (!ok) {
+        qWarning().noquote() << "Remote scene incomplete:" << error << "- keeping" << m_remoteReceived
+                             << "received splats";
+        applyRemoteActive();
+        return;
+    }
+
+    // 전부 도착: 일반 로드와 같은 상태로 (Morton 재배치 + 가지치기 + 전체 업로드)
+    // 재배치가 활성 집합을 버리고 가지치기 인덱스를 한 번만 만듦 (clearActiveIndices를 먼저 부르면 두 번)
+    SplatScene *scene = m_scenes[m_remoteSceneIndex].get();
+    scene->reorderSpatially();
+    scene->setPruneCutoff(m_alphaCutoff);
+    uploadScene(m_remoteSceneIndex);
+    m_remoteArrived.clear();
+    m_remoteArrived.shrink_to_fit();
+
+    m_sceneSetChanged = true;
+    invalidate(Input_SplatData);
+}
+
+void SplattingWidget::setSceneTransform(int index, const SceneTransform &transform)
+{
+    if (index < 0 || index >= sceneCount()) return;
+
+    // 이 씬만 정렬 캐시가 무효가 되고 (needsSort), 나머지 씬은 기존 정렬을 재사용합니다.
+    m_scenes[index]->setTransform(transform);
+    invalidate(Input_SceneLayout);
+}
+
+void SplattingWidget::setSceneVisible(int index, bool visible)
+{
+    if (index < 0 || index >= sceneCount()) return;
+    if (m_scenes[index]->isVisible() == visible) return;
+
+    m_scenes[index]->setVisible(visible);
+    m_sceneSetChanged = true;
+    invalidate(Input_SceneLayout);
+}
+
+void SplattingWidget::uploadScene(int index)
+{
+    const SplatScene *scene = m_scenes[index].get();
+    const std::vector<RenderSplat> &splats = scene->splats();
+
+    std::vector<float> packed = SplatShaders::packSplats(splats.data(), splats.size(),
+                                           scene->hasShPalette() ? scene->shPalette().indices.data() : nullptr);
 
     makeCurrent(); // OpenGL 컨텍스트 활성화
 
-    m_splatCount = static_cast<int>(splats.size());
+    GLint maxTexels = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTexels);
+    if (GLint64(splats.size()) * 4 > maxTexels) {
+        qWarning() << "Scene exceeds GL_MAX_TEXTURE_BUFFER_SIZE (" << maxTexels << "texels)";
+    }
+
+    SceneGpu &gpu = m_sceneGpu[index];
+    releaseSceneGpu(gpu);
 
-    m_vao.bind();
-    m_instanceVbo.bind();
+    glGenBuffers(1, &gpu.buffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, gpu.buffer);
+    glBufferData(GL_TEXTURE_BUFFER, packed.size() * sizeof(float), packed.data(), GL_STATIC_DRAW);
 
-    // 데이터 업로드
-    m_instanceVbo.allocate(splats.data(), m_splatCount * sizeof(RenderSplat));
+    glGenTextures(1, &gpu.texture);
+    glBindTexture(GL_TEXTURE_BUFFER, gpu.texture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, gpu.buffer);
+
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    doneCurrent();
+}
 
-    int stride = sizeof(RenderSplat);
+void SplattingWidget::uploadSceneRange(int index, size_t offset, size_t count)
+{
+    const std::vector<RenderSplat> &splats = m_scenes[index]->splats();
+    if (count == 0 || offset + count > splats.size()) return;
 
-    // RenderSplat 구조: {x,y,z, r,g,b, opacity, scale[3], rot[4]}
+    std::vector<float> packed = SplatShaders::packSplats(splats.data() + offset, count);
 
-    // [Layout 1] Instance Position (vec3) -> offset 0
-    m_program->enableAttributeArray(1);
-    m_program->setAttributeBuffer(1, GL_FLOAT, 0, 3, stride);
-    glVertexAttribDivisor(1, 1);
+    makeCurrent();
+    glBindBuffer(GL_TEXTURE_BUFFER, m_sceneGpu[index].buffer);
+    glBufferSubData(GL_TEXTURE_BUFFER, offset * SplatShaders::FLOATS_PER_SPLAT * sizeof(float),
+                    packed.size() * sizeof(float), packed.data());
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    doneCurrent();
+}
 
-    // [Layout 2] Instance Color (vec3) -> offset 12 (3 floats)
-    m_program->enableAttributeArray(2);
-    m_program->setAttributeBuffer(2, GL_FLOAT, 3 * sizeof(float), 3, stride);
-    glVertexAttribDivisor(2, 1);
+void SplattingWidget::releaseSceneGpu(SceneGpu &gpu)
+{
+    if (gpu.texture) glDeleteTextures(1, &gpu.texture);
+    if (gpu.buffer) glDeleteBuffers(1, &gpu.buffer);
+    gpu = SceneGpu();
+}
 
-    // [Layout 3] Instance Opacity (1 float) -> offset 24 (6 floats * 4 bytes)
-    m_program->enableAttributeArray(3);
-    m_program->setAttributeBuffer(3, GL_FLOAT, 6 * sizeof(float), 1, stride);
-    glVertexAttribDivisor(3, 1);
+void SplattingWidget::bindSceneTextures()
+{
+    // 씬 슬롯 i -> 텍스처 유닛 i (셰이더의 uScene{i})
+    for (int i = 0; i < sceneCount(); ++i) {
+        glActiveTexture(GL_TEXTURE0 + i);
+        glBindTexture(GL_TEXTURE_BUFFER, m_sceneGpu[i].texture);
+    }
+    glActiveTexture(GL_TEXTURE0 + SH_CODEBOOK_UNIT);
+    glBindTexture(GL_TEXTURE_BUFFER, m_shTexture);
+    glActiveTexture(GL_TEXTURE0);
+}
 
-    // [Layout 4] Instance Scale -> Layout 번호 3에서 4로 변경
-    // Opacity(1 float) 다음이므로 offset은 28 (7 floats * 4 bytes)
-    m_program->enableAttributeArray(4);
-    m_program->setAttributeBuffer(4, GL_FLOAT, 7 * sizeof(float), 3, stride);
-    glVertexAttribDivisor(4, 1);
+void SplattingWidget::uploadShCodebooks()
+{
+    // 씬마다 항목 수가 작으므로(수천 개) 씬이 추가될 때 전체를 다시 이어 붙임
+    std::vector<float> packed;
+    for (int i = 0; i < sceneCount(); ++i) {
+        m_shBase[i] = m_scenes[i]->hasShPalette()
+                          ? SplatShaders::appendShCodebook(m_scenes[i]->shPalette(), packed)
+                          : 0;
+    }
 
-    m_instanceVbo.release();
-    m_vao.release();
+    makeCurrent();
+    releaseShCodebooks();
+    if (!packed.empty()) {
+        glGenBuffers(1, &m_shBuffer);
+        glBindBuffer(GL_TEXTURE_BUFFER, m_shBuffer);
+        glBufferData(GL_TEXTURE_BUFFER, packed.size() * sizeof(float), packed.data(), GL_STATIC_DRAW);
+
+        glGenTextures(1, &m_shTexture);
+        glBindTexture(GL_TEXTURE_BUFFER, m_shTexture);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, m_shBuffer);
+
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    }
     doneCurrent();
-    update();  // 화면 갱신 요청
+
+    qDebug() << "SH codebooks:" << packed.size() / (SplatShaders::SH_TEXELS_PER_ENTRY * 4) << "entries,"
+             << packed.size() * sizeof(float) / 1024 << "KB";
+}
+
+void SplattingWidget::releaseShCodebooks()
+{
+    if (m_shTexture) glDeleteTextures(1, &m_shTexture);
+    if (m_shBuffer) glDeleteBuffers(1, &m_shBuffer);
+    m_shTexture = 0;
+    m_shBuffer = 0;
+}
+
+void SplattingWidget::invalidate(quint32 inputs)
+{
+    // 스플랫 이미지가 바뀌면 시간적 누적을 처음부터 (히스토리는 재투영해서 계속 씀)
+    const quint32 splatImageInputs = Input_Camera | Input_SplatData | Input_GlobalScale | Input_AlphaCutoff
+                                     | Input_RenderMode | Input_SceneLayout | Input_DrawBudget | Input_DepthPrepass
+                                     | Input_OcclusionCulling;
+    if (inputs & splatImageInputs) m_temporalFrame = 0;
+
+    // 클러스터 컬링은 스플랫 크기(AABB 여유)와 가리개 코어(컷오프/코어 임계값)에 따라 달라지므로 정렬부터 다시
+    if (m_occlusionCulling && (inputs & (Input_GlobalScale | Input_AlphaCutoff | Input_DepthPrepass))) {
+        inputs |= Input_OcclusionCulling;
+    }
+
+    // 값이 실제로 바뀌어 다시 실행할 패스가 생겼을 때만 화면 갱신 요청
+    if (m_renderGraph.invalidate(inputs)) {
+        requestFrame();
+    }
+}
+
+double SplattingWidget::refreshPeriodMs() const
+{
+    const qreal hz = screen() ? screen()->refreshRate() : 60.0;
+    return 1000.0 / (hz > 1.0 ? hz : 60.0);
+}
+
+void SplattingWidget::requestFrame()
+{
+    // 이미 예약된 프레임이 있으면 그때 최신 입력을 읽으므로 아무것도 하지 않음
+    if (m_frameStartTimer.isActive()) return;
+
+    const qint64 lastPresent = m_latency.lastPresentNs();
+    if (!m_lateFrameStart || lastPresent < 0 || format().swapInterval() <= 0) {
+        update();
+        return;
+    }
+
+    // 마지막 스왑 완료 = vblank로 보고 다음 vblank를 추정, 렌더에 필요한 만큼만 남기고 시작
+    const double periodMs = refreshPeriodMs();
+    const double sinceMs = (m_latency.nowNs() - lastPresent) / 1.0e6;
+    const double budgetMs = m_latency.renderMs() + m_lateFrameMarginMs;
+    double deadlineMs = std::ceil(sinceMs / periodMs) * periodMs;
+    if (deadlineMs - sinceMs < budgetMs) deadlineMs += periodMs; // 이번 주기는 이미 늦음 -> 다음 주기 마감에 맞춤
+    const double delayMs = deadlineMs - budgetMs - sinceMs;
+
+    if (delayMs < 1.0 || budgetMs >= periodMs) {
+        update();
+    } else {
+        m_frameStartTimer.start(int(delayMs));
+    }
+}
+
+void SplattingWidget::setLatencyMeasurement(bool enabled)
+{
+    // 켤 때마다 새로 모으고, 끌 때 요약을 출력
+    if (enabled && !m_latency.isEnabled()) m_latency.reset();
+    if (!enabled && m_latency.isEnabled()) {
+        qInfo().noquote() << "Input-to-display latency:\n" + m_latency.summary();
+    }
+    m_latency.setEnabled(enabled);
+    update();
+}
+
+void SplattingWidget::resetLatencyStats()
+{
+    m_latency.reset();
+    update();
+}
+
+void SplattingWidget::setLateFrameStart(bool enabled)
+{
+    m_lateFrameStart = enabled;
+    if (!enabled && m_frameStartTimer.isActive()) {
+        m_frameStartTimer.stop();
+        update();
+    }
+}
+
+void SplattingWidget::setLateFrameMargin(float ms)
+{
+    m_lateFrameMarginMs = std::max(ms, 0.0f);
 }
 
 // 설정값 변경 함수
+// 같은 값이 다시 들어오면 아무 패스도 더티로 만들지 않습니다.
 void SplattingWidget::setGlobalScale(float scale) {
+    if (m_globalScale == scale) return;
     m_globalScale = scale;
-    update(); // 화면 갱신
+    invalidate(Input_GlobalScale);
 }
 void SplattingWidget::setAlphaCutoff(float cutoff) {
+    if (m_alphaCutoff == cutoff) return;
     m_alphaCutoff = cutoff;
-    update();
+
+    // 가지치기 경계만 옮기고, 그리기 집합이 실제로 바뀐 경우에만 정렬 패스까지 더티로
+    bool drawSetChanged = false;
+    for (auto &scene : m_scenes) {
+        drawSetChanged |= scene->setPruneCutoff(cutoff);
+    }
+    if (drawSetChanged) {
+        m_sceneSetChanged = true;
+        invalidate(Input_AlphaCutoff | Input_SplatData);
+    } else {
+        invalidate(Input_AlphaCutoff);
+    }
 }
 
+// 아래 세 값은 후처리(Post) 패스만 사용하므로 스플랫 패스는 캐시된 FBO를 재사용합니다.
 void SplattingWidget::setShapness(float value) {
+    if (m_sharpness == value) return;
     m_sharpness = value;
-    update();
+    invalidate(Input_Sharpness);
 }
 
 void SplattingWidget::setUpscaleFilter(bool isLinear) {
+    if (m_useLinearFilter == isLinear) return;
     m_useLinearFilter = isLinear;
-    update(); // 즉시 다시 그리기
+    invalidate(Input_FilterMode);
 }
 
 void SplattingWidget::setUseFSR(bool use) {
+    if (m_useFSR == use) return;
     m_useFSR = use;
-    update();
+    invalidate(Input_FilterMode);
 }
 
-void SplattingWidget::initializeGL()
+void SplattingWidget::setTemporalUpscale(bool enabled) {
+    if (m_useTemporal == enabled) return;
+    if (enabled && m_viewLayout != ViewLayout::Single) {
+        qWarning() << "Temporal upscale is not supported with multiple views.";
+        return;
+    }
+    m_useTemporal = enabled;
+    resetTemporal();
+    // 지터가 켜지거나 꺼지므로 스플랫 패스부터 다시
+    invalidate(Input_Jitter | Input_FilterMode);
+}
+
+void SplattingWidget::setViewLayout(ViewLayout layout)
 {
-    initializeOpenGLFunctions();
+    if (m_viewLayout == layout) return;
+    m_viewLayout = layout;
+    // 시간적 업스케일은 화면 전체가 한 시점이라고 가정하므로 다중 뷰에서는 끔
+    if (layout != ViewLayout::Single && m_useTemporal) {
+        qWarning() << "Temporal upscale is not supported with multiple views, disabling it.";
+        setTemporalUpscale(false);
+    }
+    m_sceneSetChanged = true; // 뷰별 목록을 이어 붙였을 수 있으므로 다시 구성
+    invalidate(Input_RenderMode);
+}
 
-    // 1. 셰이더 초기화 (간단한 패스스루 + 빨간색 출력)
-    initShaders();
+void SplattingWidget::setStereoSeparation(float fractionOfDistance)
+{
+    m_stereoSeparation = fractionOfDistance;
+    if (m_viewLayout == ViewLayout::Stereo) invalidate(Input_Camera);
+}
 
-#if 0
-    // 2. 지오메트리(삼각형) 초기화
-    initGeometry();
-#else
-    // VAO, VBO 생성
-    m_vao.create();
-    m_vao.bind();
+void SplattingWidget::setOrbitSpread(float degrees)
+{
+    m_orbitSpread = degrees;
+    if (m_viewLayout == ViewLayout::QuadOrbit) invalidate(Input_Camera);
+}
 
-    // 1. 사각형(Quad) 지오메트리 생성 (Triangle Strip 사용)
-    // (-1, -1) ~ (1, 1) 크기의 정사각형
-    float quadVertices[] = {
-        -1.0f, -1.0f, // 좌하단
-        1.0f, -1.0f, // 우하단
-        -1.0f,  1.0f, // 좌상단
-        1.0f,  1.0f  // 우상단
+void SplattingWidget::setSharedSortTolerance(float degrees)
+{
+    m_sharedSortTolerance = std::max(0.0f, degrees);
+    if (m_viewLayout != ViewLayout::Single) invalidate(Input_Camera);
+}
+
+void SplattingWidget::setRenderMode(RenderMode mode) {
+    if (m_renderMode == mode) return;
+    m_renderMode = mode;
+    invalidate(Input_RenderMode);
+}
+
+void SplattingWidget::setDepthPrepass(bool enabled)
+{
+    if (m_depthPrepass == enabled) return;
+    m_depthPrepass = enabled;
+    invalidate(Input_DepthPrepass);
+}
+
+void SplattingWidget::setDepthPrepassThreshold(float coreAlpha)
+{
+    coreAlpha = std::clamp(coreAlpha, 0.01f, 0.999f);
+    if (m_coreAlpha == coreAlpha) return;
+    m_coreAlpha = coreAlpha;
+    m_prepassDirty = true;
+    if (m_depthPrepass || m_occlusionCulling) invalidate(Input_DepthPrepass);
+}
+
+void SplattingWidget::setOcclusionCulling(bool enabled)
+{
+    if (m_occlusionCulling == enabled) return;
+    m_occlusionCulling = enabled;
+    invalidate(Input_OcclusionCulling);
+}
+
+void SplattingWidget::setFragmentStats(bool enabled)
+{
+    if (m_fragmentStatsEnabled == enabled) return;
+    m_fragmentStatsEnabled = enabled;
+    m_fragmentStats = FragmentStats();
+    // 지금 화면의 수를 세려면 스플랫 패스를 한 번 다시 그려야 함
+    if (enabled) invalidate(Input_RenderMode);
+    else update();
+}
+
+void SplattingWidget::setHeatmapRange(int maxFragments)
+{
+    m_heatmapMax = std::max(1, maxFragments);
+    if (m_renderMode == RenderMode::OverdrawHeatmap) invalidate(Input_RenderMode);
+}
+
+ImageDiff SplattingWidget::compareOitWithSorted(const QString &sideBySidePath)
+{
+    ImageDiff diff;
+    if (!m_fbo || !m_oitFbo || m_splatCount == 0) return diff;
+
+    makeCurrent();
+    QMatrix4x4 view = m_camera.getViewMatrix();
+
+    // 기준: 정렬 모드 (OIT 모드에서는 정렬이 생략돼 있으므로 여기서 직접 수행)
+    runSortPass(view, true);
+    renderSortedSplats(view);
+    QImage sorted = m_fbo->toImage();
+
+    renderOitSplats(view);
+    QImage oit = m_fbo->toImage();
+
+    diff = ImageMetrics::compare(sorted, oit);
+    qInfo().noquote() << "OIT vs Sorted:" << diff.toString();
+
+    if (!sideBySidePath.isEmpty()) {
+        ImageMetrics::sideBySide(sorted, oit).save(sideBySidePath);
+    }
+
+    doneCurrent();
+
+    // m_fbo를 덮어썼으므로 현재 모드로 다시 그림
+    m_lastOitDiff = diff;
+    m_renderGraph.invalidate(Input_RenderMode);
+    update();
+    return diff;
+}
+
+QString SplattingWidget::compareRenders(const QString &title, int frames, const std::vector<CompareSide> &sides,
+                                        const QString &sideBySidePath, std::vector<ImageDiff> *diffs)
+{
+    // 화면용 쿼리가 남아 있으면 먼저 비움 (같은 쿼리 객체를 다시 씀)
+    if (m_queryPending) {
+        m_fragmentStats = sumFragmentQueries();
+        m_queryPending = false;
+    }
+
+    struct Result {
+        FragmentStats fragments;
+        double avgMs = 0.0;
+        QImage image;
     };
+    std::vector<Result> results;
+    for (const CompareSide &side : sides) {
+        Result result;
+        if (side.prepare) side.prepare();
+        std::vector<double> frameMs;
+        for (int f = 0; f < frames; ++f) {
+            m_countThisPass = f == 0; // 쿼리는 첫 프레임만 (시간 측정에 섞이지 않도록)
+            m_queriesUsed = 0;
+            QElapsedTimer timer;
+            timer.start();
+            side.render(f);
+            glFinish();
+            if (f > 0 || frames == 1) frameMs.push_back(timer.nsecsElapsed() / 1.0e6);
+            if (f == 0) result.fragments = sumFragmentQueries();
+            m_countThisPass = false;
+            if (side.afterFrame) side.afterFrame(f);
+        }
+        m_queriesUsed = 0;
+        result.avgMs = frameMs.empty() ? 0.0 : FrameTimeSummary::fromSamples(frameMs).avgMs;
+        result.image = (side.capture ? side.capture() : m_fbo->toImage()).convertToFormat(QImage::Format_RGB32);
+        results.push_back(result);
+    }
 
-    m_quadVbo.create();
-    m_quadVbo.bind();
-    m_quadVbo.allocate(quadVertices, sizeof(quadVertices));
+    auto saving = [](double before, double after) {
+        return before > 0.0 ? 100.0 * (before - after) / before : 0.0;
+    };
+    int labelWidth = 0;
+    for (const CompareSide &side : sides) labelWidth = std::max(labelWidth, int(side.label.size()));
+
+    QStringList lines;
+    lines << title;
+    for (size_t i = 0; i < sides.size(); ++i) {
+        const FragmentStats &f = results[i].fragments;
+        const QString shaded = f.hasShaded ? QString("%1").arg(f.shaded) : QString("n/a");
+        QString line = QString("  %1: %2 ms, shaded %3, blended %4")
+                           .arg(sides[i].label, -labelWidth).arg(results[i].avgMs, 0, 'f', 2).arg(shaded).arg(f.passed);
+        if (!sides[i].note.isEmpty()) line += " (" + sides[i].note + ")";
+        lines << line;
+    }
+    // 첫 번째를 기준으로 절감률과 화질 차이
+    const Result &base = results.front();
+    for (size_t i = 1; i < sides.size(); ++i) {
+        const Result &r = results[i];
+        QString saved = QString("  %1 vs %2: saved %3% frame time, ")
+                            .arg(sides[i].label, sides.front().label)
+                            .arg(saving(base.avgMs, r.avgMs), 0, 'f', 1);
+        if (base.fragments.hasShaded) {
+            saved += QString("%1% shaded, ")
+                         .arg(saving(double(base.fragments.shaded), double(r.fragments.shaded)), 0, 'f', 1);
+        }
+        saved += QString("%1% blended fragments")
+                     .arg(saving(double(base.fragments.passed), double(r.fragments.passed)), 0, 'f', 1);
+        lines << saved;
+        const ImageDiff diff = ImageMetrics::compare(base.image, r.image);
+        lines << "    difference: " + diff.toString();
+        if (diffs) diffs->push_back(diff);
+    }
+
+    // 마지막 두 결과를 나란히 (둘뿐이면 기준 | 비교 대상)
+    if (!sideBySidePath.isEmpty() && results.size() >= 2) {
+        ImageMetrics::sideBySide(results[results.size() - 2].image, results.back().image).save(sideBySidePath);
+    }
+    return lines.join("\n");
+}
+
+QString SplattingWidget::compareFrontToBack(int frames, const QString &sideBySidePath)
+{
+    if (!m_fbo || m_splatCount == 0 || frames <= 0) return QString();
+
+    makeCurrent();
+    const QMatrix4x4 view = m_camera.getViewMatrix();
+
+    std::vector<CompareSide> sides(2);
+    sides[0].label = "Back-to-front";
+    sides[0].prepare = [&] { runSortPass(view, true, false); };
+    sides[0].render = [&](int) { renderSortedSplats(view); };
+    sides[1].label = "Front-to-back";
+    sides[1].prepare = [&] { runSortPass(view, true, true); };
+    sides[1].render = [&](int) { renderFrontToBackSplats(view); };
+
+    const QString title = QString("Front-to-back vs back-to-front (%1 splats, alpha >= %2):")
+                              .arg(m_splatCount).arg(SATURATION_ALPHA, 0, 'f', 3);
+    const QString report = compareRenders(title, frames, sides, sideBySidePath)
+                           + QString("\n  Saturation passes: %1").arg(m_saturationMarks);
+    qInfo().noquote() << report;
+
+    doneCurrent();
+
+    // 그리기 목록 순서와 m_fbo를 바꿨으므로 현재 모드로 다시 정렬/그림
+    m_renderGraph.invalidate(Input_RenderMode);
+    update();
+    return report;
+}
+
+QStringList SplattingWidget::sweepPoses(const PoseMeasure &measure)
+{
+    makeCurrent();
+    const CameraState savedCamera = m_camera.state();
+    QStringList reports;
+    for (const float *pose : SWEEP_POSES) {
+        CameraState state = savedCamera;
+        state.yaw += pose[0];
+        state.pitch = std::clamp(state.pitch + pose[1], -89.0f, 89.0f); // Camera의 마우스 범위와 같게
+        m_camera.setState(state);
+        const QString label = QString("yaw %1, pitch %2").arg(state.yaw, 0, 'f', 1).arg(state.pitch, 0, 'f', 1);
+        reports << measure(m_camera.getViewMatrix(), label, pose == SWEEP_POSES[0]);
+    }
+    m_camera.setState(savedCamera);
+    doneCurrent();
+    return reports;
+}
+
+QString SplattingWidget::compareDepthPrepass(int frames, const QString &sideBySidePath)
+{
+    if (!m_fbo || m_splatCount == 0 || frames <= 0) return QString();
+
+    const bool wasEnabled = m_depthPrepass;
+    QMatrix4x4 view;
+    std::vector<CompareSide> sides(2);
+    sides[0].label = "Without";
+    sides[0].prepare = [&] { m_depthPrepass = false; };
+    sides[0].render = [&](int) { renderSortedSplats(view); };
+    sides[1].label = "With";
+    sides[1].prepare = [&] { m_depthPrepass = true; };
+    sides[1].render = [&](int) { renderSortedSplats(view); };
+    sides[1].note = "time includes the pre-pass";
+
+    // 비교 이미지는 현재 시점만 저장
+    const QString report = sweepPoses([&](const QMatrix4x4 &poseView, const QString &pose, bool current) {
+        view = poseView;
+        runSortPass(view, true);
+        const QString title = QString("Depth pre-pass at %1 (%2 splats, core alpha >= %3):")
+                                  .arg(pose).arg(m_splatCount).arg(m_coreAlpha, 0, 'f', 2);
+        return compareRenders(title, frames, sides, current ? sideBySidePath : QString())
+               + QString("\n  Occluders: %1").arg(m_prepassCount);
+    }).join("\n");
+    m_depthPrepass = wasEnabled;
+    qInfo().noquote() << report;
+
+    // 그리기 목록과 m_fbo를 바꿨으므로 현재 모드로 다시 정렬/그림
+    m_renderGraph.invalidate(Input_RenderMode);
+    update();
+    return report;
+}
+
+QString SplattingWidget::checkOcclusionCulling(int frames, const QString &sideBySidePath)
+{
+    if (!m_fbo || !m_hiz.isValid() || m_splatCount == 0 || frames <= 0) return QString();
+    if (m_viewLayout != ViewLayout::Single) {
+        qWarning() << "Occlusion culling check needs the single view layout.";
+        return QString();
+    }
+
+    // 컬링은 완전히 가려진 클러스터만 빼야 하므로 끈 것과 켠 것의 이미지가 (코어 뒤로 새는 빛 정도만) 같아야 함
+    const double MAX_BAD_PIXEL_RATIO = 0.001;
+
+    const bool wasEnabled = m_occlusionCulling;
+    QMatrix4x4 view;
+    std::vector<CompareSide> sides(2);
+    sides[0].label = "Unculled";
+    sides[0].prepare = [&] {
+        m_occlusionCulling = false;
+        runSortPass(view, true);
+    };
+    sides[0].render = [&](int) { renderSortedSplats(view); };
+    sides[1].label = "Culled";
+    sides[1].prepare = [&] {
+        m_occlusionCulling = true;
+        runSortPass(view, true);
+    };
+    sides[1].render = [&](int) { renderSortedSplats(view); };
+
+    int failed = 0;
+    QStringList reports = sweepPoses([&](const QMatrix4x4 &poseView, const QString &pose, bool current) {
+        view = poseView;
+        std::vector<ImageDiff> diffs;
+        QString report = compareRenders(QString("Occlusion culling at %1:").arg(pose), frames, sides,
+                                        current ? sideBySidePath : QString(), &diffs);
+        const OcclusionStats &occ = m_occlusionStats;
+        report += QString("\n  Culled: %1 clusters / %2 splats occluded, %3 clusters / %4 splats outside the view")
+                      .arg(occ.occludedClusters).arg(occ.occludedSplats)
+                      .arg(occ.frustumClusters).arg(occ.frustumSplats);
+        if (diffs.empty() || diffs.front().badPixelRatio > MAX_BAD_PIXEL_RATIO) {
+            ++failed;
+            report += "\n  FAILED: culling changed visible pixels";
+        }
+        return report;
+    });
+    m_occlusionCulling = wasEnabled;
+    const int views = int(reports.size());
+    reports << QString("Occlusion culling check: %1 of %2 views passed (bad pixels <= %3%)")
+                   .arg(views - failed).arg(views).arg(MAX_BAD_PIXEL_RATIO * 100.0, 0, 'f', 1);
+    const QString report = reports.join("\n");
+    if (failed > 0) qWarning().noquote() << report;
+    else qInfo().noquote() << report;
+
+    // 컬링 집합, 그리기 목록과 m_fbo를 바꿨으므로 현재 상태로 다시 정렬/그림
+    m_renderGraph.invalidate(Input_RenderMode | Input_OcclusionCulling);
+    update();
+    return report;
+}
+
+QString SplattingWidget::compareTemporalWithRcas(int frames, const QString &sideBySidePath)
+{
+    if (!m_fbo || m_splatCount == 0 || frames <= 0) return QString();
+
+    const int outW = width();
+    const int outH = height();
+    const bool savedTemporal = m_useTemporal;
+
+    makeCurrent();
+    const QMatrix4x4 view = m_camera.getViewMatrix();
+    runSortPass(view, true);
+
+    QOpenGLFramebufferObject reference(outW, outH);
+    QOpenGLFramebufferObject rcasTarget(outW, outH);
+    QImage refImage;
+    QStringList convergence;
+
+    std::vector<CompareSide> sides(3);
+    // 기준: 출력 해상도로 직접 그림 (지터 없음)
+    sides[0].label = "Native";
+    sides[0].prepare = [&] { m_useTemporal = false; };
+    sides[0].render = [&](int) { renderSortedSplats(view, &reference); };
+    // 기준 이미지는 시간적 경로의 수렴 측정에도 씀 (쪽은 순서대로 재므로 그 전에 채워짐)
+    sides[0].capture = [&] {
+        refImage = reference.toImage().convertToFormat(QImage::Format_RGB32);
+        return refImage;
+    };
+    // RCAS: 720p + 단일 프레임 샤픈
+    sides[1].label = "RCAS";
+    sides[1].prepare = [&] { m_useTemporal = false; };
+    sides[1].render = [&](int) {
+        renderSortedSplats(view);
+        rcasTarget.bind();
+        renderRcas(m_fbo->texture(), outW, outH);
+        rcasTarget.release();
+    };
+    sides[1].capture = [&] { return rcasTarget.toImage(); };
+    // 시간적 업스케일: 정지 카메라에서 frames 프레임 누적
+    sides[2].label = "Temporal";
+    sides[2].note = "per frame, accumulating";
+    sides[2].prepare = [&] {
+        m_useTemporal = true;
+        resetTemporal();
+        m_prevViewProj = projectionMatrix(false) * view;
+    };
+    sides[2].render = [&](int f) {
+        m_jitterIndex = f % TEMPORAL_SAMPLES;
+        m_jitter = QVector2D(halton(m_jitterIndex + 1, 2) - 0.5f, halton(m_jitterIndex + 1, 3) - 0.5f);
+        renderSortedSplats(view);
+        resolveTemporal(view);
+    };
+    sides[2].afterFrame = [&](int f) {
+        const int n = f + 1;
+        if (n == frames || (n & (n - 1)) == 0) { // 1, 2, 4, 8, ... 프레임째
+            const QImage image = m_history[m_historyIndex]->toImage().convertToFormat(QImage::Format_RGB32);
+            convergence << QString("%1f %2 dB").arg(n).arg(ImageMetrics::compare(refImage, image).psnr, 0, 'f', 2);
+        }
+    };
+    sides[2].capture = [&] { return m_history[m_historyIndex]->toImage(); };
+
+    const QString title = QString("Upscale comparison at %1x%2 (internal %3x%4):")
+                              .arg(outW).arg(outH).arg(INTERNAL_WIDTH).arg(INTERNAL_HEIGHT);
+    const QString report = compareRenders(title, frames, sides, sideBySidePath)
+                           + "\n  Convergence: " + convergence.join(", ");
+    qInfo().noquote() << report;
+
+    // 화면 상태 복구: 원래 모드로 처음부터 다시 그림
+    m_useTemporal = savedTemporal;
+    resetTemporal();
+    doneCurrent();
+    m_renderGraph.invalidate(Input_RenderMode);
+    update();
+    return report;
+}
+
+QString SplattingWidget::benchmarkSpatialOrder(const std::vector<RenderSplat>& fileOrder, int frames)
+{
+    if (!m_fbo || fileOrder.empty()) return QString();
+
+    const CameraState savedCamera = m_camera.state();
+    const char *labels[2] = { "File order", "Morton order" };
+    QStringList report;
+
+    for (int pass = 0; pass < 2; ++pass) {
+        removeAllScenes();
+        if (addScene("Benchmark", fileOrder, pass == 1) < 0) break;
+
+        std::vector<double> sortMs, drawMs;
+        makeCurrent();
+        for (int f = 0; f < frames; ++f) {
+            // 매 프레임 시점이 바뀌어 전체 재정렬이 일어나도록 씬 주위를 돔
+            CameraState state = savedCamera;
+            state.yaw += 360.0f * f / frames;
+            m_camera.setState(state);
+            QMatrix4x4 view = m_camera.getViewMatrix();
+
+            QElapsedTimer timer;
+            timer.start();
+            runSortPass(view, true);
+            sortMs.push_back(timer.nsecsElapsed() / 1.0e6);
+
+            timer.restart();
+            renderSortedSplats(view);
+            glFinish(); // GPU 완료까지
+            drawMs.push_back(timer.nsecsElapsed() / 1.0e6);
+        }
+        doneCurrent();
+
+        FrameTimeSummary sortSummary = FrameTimeSummary::fromSamples(sortMs);
+        FrameTimeSummary drawSummary = FrameTimeSummary::fromSamples(drawMs);
+        report << QString("%1: sort %2 ms, draw %3 ms (avg over %4 frames)")
+                      .arg(labels[pass])
+                      .arg(sortSummary.avgMs, 0, 'f', 2)
+                      .arg(drawSummary.avgMs, 0, 'f', 2)
+                      .arg(frames);
+        qInfo().noquote() << labels[pass] << "sort:" << sortSummary.toString();
+        qInfo().noquote() << labels[pass] << "draw:" << drawSummary.toString();
+    }
+
+    m_camera.setState(savedCamera);
+    m_renderGraph.invalidateAll();
+    update();
+
+    QString result = report.join("\n");
+    qInfo().noquote() << result;
+    return result;
+}
+
+void SplattingWidget::initializeGL()
+{
+    initializeOpenGLFunctions();
+
+    // 1. 셰이더 초기화 (간단한 패스스루 + 빨간색 출력)
+    initShaders();
+    if (!m_overlay.initialize(m_shaderCache, QFont("Arial", 14, QFont::Bold), devicePixelRatioF())) {
+        qWarning() << "Overlay initialization failed; statistics text will not be drawn.";
+    }
+    if (!m_hiz.initialize(m_shaderCache, INTERNAL_WIDTH, INTERNAL_HEIGHT)) {
+        qWarning() << "Hi-Z pyramid unavailable; occlusion culling will only remove clusters outside the view.";
+    }
+
+#if 0
+    // 2. 지오메트리(삼각형) 초기화
+    initGeometry();
+#else
+    // VAO, VBO 생성
+    m_vao.create();
+    m_vao.bind();
+
+    // 1. 사각형(Quad) 지오메트리 생성 (Triangle Strip 사용)
+    // (-1, -1) ~ (1, 1) 크기의 정사각형
+    float quadVertices[] = {
+        -1.0f, -1.0f, // 좌하단
+        1.0f, -1.0f, // 우하단
+        -1.0f,  1.0f, // 좌상단
+        1.0f,  1.0f  // 우상단
+    };
+
+    m_quadVbo.create();
+    m_quadVbo.bind();
+    m_quadVbo.allocate(quadVertices, sizeof(quadVertices));
+
+    // [Layout 0] Quad Vertex Position (vec2)
+    // 이 속성은 인스턴스마다 변하지 않고, 사각형 그릴 때마다 재사용됨
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), nullptr);
+
+    // 2. 그리기 순서 VBO 생성 (아직 데이터는 없음)
+    // [Layout 1] 인스턴스마다 SplatRef(uint) 하나. 실제 스플랫 데이터는 씬별 TBO에서 읽습니다.
+    m_orderVbo.create();
+    m_orderVbo.setUsagePattern(QOpenGLBuffer::DynamicDraw);
+    m_orderVbo.bind();
+    glEnableVertexAttribArray(1);
+    glVertexAttribIPointer(1, 1, GL_UNSIGNED_INT, sizeof(quint32), nullptr);
+    glVertexAttribDivisor(1, 1);
+
+    m_vao.release();
+    m_orderVbo.release(); // quadVbo는 release 안 해도 됨 (다음 바인딩 때 풀림)
+
+    // 깊이 프리패스 순서 VBO (그릴 때만 attribute 1을 잠시 이쪽으로 돌림)
+    m_prepassVbo.create();
+    m_prepassVbo.setUsagePattern(QOpenGLBuffer::DynamicDraw);
+    m_prepassDirty = true;
+
+    // 클러스터 가림 컬링의 가리개 순서 VBO (프리패스와 같은 방식으로 attribute 1을 잠시 돌림)
+    m_occluderVbo.create();
+    m_occluderVbo.setUsagePattern(QOpenGLBuffer::DynamicDraw);
+#endif
+
+    initFSRQuad();
+    initOIT();
+    initOverdraw();
+
+    // 3. FBO 생성 (1280x720 고정 해상도, Depth/Stencil 포함)
+    QOpenGLFramebufferObjectFormat format;
+    format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
+    m_fbo = new QOpenGLFramebufferObject(INTERNAL_WIDTH, INTERNAL_HEIGHT, format);
+    // attachment 1: 시간적 업스케일 재투영용 (깊이 x 가중치, 커버리지)
+    m_fbo->addColorAttachment(INTERNAL_WIDTH, INTERNAL_HEIGHT, GL_RG16F);
+    const QList<GLuint> fboTextures = m_fbo->textures(); // textures()는 호출마다 새 목록이므로 한 번만
+    m_fboAuxTexture = fboTextures.size() > 1 ? fboTextures[1] : 0;
+    resetTemporal();
+
+    if (m_fbo->isValid()) {
+        qDebug() << "FBO Created Successfully: 1280x720";
+        initFrontToBack();
+    } else {
+        qCritical() << "FBO Creation Failed!";
+    }
+
+    // 새 컨텍스트에서는 캐시된 결과가 없으므로 모든 패스를 다시 실행
+    m_renderGraph.invalidateAll();
+}
+
+void SplattingWidget::resizeGL(int w, int h)
+{
+    // 윈도우 크기가 변해도 FBO 크기는 고정(1280x720)이므로
+    // 여기서 FBO를 재생성하지 않습니다.
+    // 출력(Post) 패스만 다시 하면 되고, 스플랫 패스 결과는 재사용합니다.
+    // (시간적 업스케일 히스토리는 출력 해상도이므로 새 크기로 다시 누적)
+    Q_UNUSED(w);
+    Q_UNUSED(h);
+    invalidate(m_useTemporal ? (Input_WindowSize | Input_Jitter) : Input_WindowSize);
+}
+
+// [추가] 마우스 이벤트 구현
+void SplattingWidget::mousePressEvent(QMouseEvent *event)
+{
+    // 경로 재생 중에는 마우스 입력을 무시 (재현성 유지)
+    if (m_pathPlayer.isPlaying()) return;
+
+    // Shift/Ctrl + 좌클릭: 영역 선택 시작 (카메라는 그대로)
+    const bool canSelect = event->button() == Qt::LeftButton && m_viewLayout == ViewLayout::Single;
+    if (canSelect && (event->modifiers() & (Qt::ShiftModifier | Qt::ControlModifier))) {
+        m_selectDrag = (event->modifiers() & Qt::ShiftModifier) ? SelectDrag::Box : SelectDrag::Lasso;
+        m_selectPath.clear();
+        m_selectPath << event->position();
+        return;
+    }
+
+    // 클릭 위치만 기억하고 카메라는 움직이지 않으므로 다시 그릴 필요 없음
+    m_camera.handleMousePress(event);
+}
+
+void SplattingWidget::mouseMoveEvent(QMouseEvent *event)
+{
+    if (m_pathPlayer.isPlaying()) return;
+
+    if (m_selectDrag != SelectDrag::None) {
+        // 사각형은 시작점 + 현재점, 올가미는 지나간 점을 모두 기록
+        if (m_selectDrag == SelectDrag::Box && m_selectPath.size() > 1) m_selectPath.back() = event->position();
+        else m_selectPath << event->position();
+        update(); // 오버레이만 다시 (스플랫 패스는 캐시)
+        return;
+    }
+
+    // 버튼 없이 움직이면 (마우스 추적) 카메라가 그대로이므로 정제 모드로 들어가지 않음
+    if (event->buttons() & (Qt::LeftButton | Qt::RightButton)) {
+        m_latency.markInput();
+        beginInteraction();
+    }
+    m_camera.handleMouseMove(event);
+    m_pathRecorder.record(m_camera.state());
+    invalidate(Input_Camera); // 정렬 + 스플랫 패스 다시
+}
+
+void SplattingWidget::mouseReleaseEvent(QMouseEvent *event)
+{
+    if (m_selectDrag == SelectDrag::None) return;
+
+    const bool isRect = m_selectDrag == SelectDrag::Box;
+    m_selectDrag = SelectDrag::None;
+    if (isRect) {
+        const QRectF rect = QRectF(m_selectPath.front(), event->position()).normalized();
+        m_selectPath.clear();
+        m_selectPath << rect.topLeft() << rect.topRight() << rect.bottomRight() << rect.bottomLeft();
+    }
+    if (m_selectPath.size() >= 3) selectRegion(m_selectPath, isRect);
+    m_selectPath.clear();
+    update();
+}
+
+void SplattingWidget::mouseDoubleClickEvent(QMouseEvent *event)
+{
+    if (m_pathPlayer.isPlaying() || event->button() != Qt::LeftButton) return;
+
+    // 찍은 표면 점을 새 궤도 중심으로 (시점 방향은 그대로, 거리만 맞춤)
+    const SplatPick hit = pickAt(event->position());
+    if (!hit.hit) return;
+
+    CameraState state = m_camera.state();
+    state.target = hit.point;
+    state.distance = std::max(hit.distance, 0.1f);
+    m_latency.markInput();
+    m_camera.setState(state);
+    m_pathRecorder.record(m_camera.state());
+    invalidate(Input_Camera);
+}
+
+QPointF SplattingWidget::widgetToNdc(const QPointF &widgetPos) const
+{
+    // 출력 패스가 720p 결과를 위젯 전체로 늘리므로 위젯 좌표를 그대로 NDC로 옮기면 됨
+    return QPointF(2.0 * widgetPos.x() / std::max(width(), 1) - 1.0,
+                   1.0 - 2.0 * widgetPos.y() / std::max(height(), 1));
+}
+
+bool SplattingWidget::pickableScenes(std::vector<const SplatScene *> &scenes, std::vector<int> &sceneSlots) const
+{
+    scenes.clear();
+    sceneSlots.clear();
+    if (m_viewLayout != ViewLayout::Single) return false;
+
+    // 스트리밍 씬(청크/HTTP 수신 중)은 내용이 계속 바뀌므로 BVH를 두지 않음 (BVH는 로드 시 재배치하면서 만듦)
+    for (int i = 0; i < sceneCount(); ++i) {
+        if (!m_scenes[i]->isVisible() || i == m_streamSceneIndex || !m_scenes[i]->hasBvh()) continue;
+        if (i == m_remoteSceneIndex && m_remote.isActive()) continue;
+        scenes.push_back(m_scenes[i].get());
+        sceneSlots.push_back(i);
+    }
+    return !scenes.empty();
+}
+
+SplatPick SplattingWidget::pickAt(const QPointF &widgetPos)
+{
+    std::vector<const SplatScene *> scenes;
+    std::vector<int> sceneSlots;
+    if (!pickableScenes(scenes, sceneSlots)) return SplatPick();
+
+    // NDC 점을 근평면/원평면으로 되돌려 월드 광선을 만듦
+    const QPointF ndc = widgetToNdc(widgetPos);
+    const QMatrix4x4 view = m_camera.getViewMatrix();
+    const QMatrix4x4 invViewProj = (projectionMatrix(false) * view).inverted();
+    const QVector3D nearPoint = invViewProj.map(QVector3D(ndc.x(), ndc.y(), -1.0f));
+    const QVector3D farPoint = invViewProj.map(QVector3D(ndc.x(), ndc.y(), 1.0f));
+
+    QElapsedTimer timer;
+    timer.start();
+    const SplatPick hit = SplatScene::pick(scenes, sceneSlots, nearPoint, (farPoint - nearPoint).normalized(), view,
+                                           m_globalScale);
+
+    // 오버레이 표시용
+    m_lastPick = hit;
+    m_lastPickMs = timer.nsecsElapsed() / 1.0e6;
+    return hit;
+}
+
+QString SplattingWidget::measurePickLatency(int grid)
+{
+    std::vector<const SplatScene *> scenes;
+    std::vector<int> sceneSlots;
+    if (grid <= 0 || !pickableScenes(scenes, sceneSlots)) {
+        qWarning() << "Pick latency: no pickable scene (single view layout with a fully loaded scene required).";
+        return QString();
+    }
+
+    qint64 splats = 0;
+    size_t bvhNodes = 0, bvhBytes = 0;
+    double buildMs = 0.0;
+    for (const SplatScene *scene : scenes) {
+        splats += scene->splatCount();
+        bvhNodes += scene->bvh().nodes().size();
+        bvhBytes += scene->bvh().memoryBytes();
+        buildMs += scene->bvhBuildMs();
+    }
+
+    // 화면 전체에 고르게 퍼진 grid x grid 픽셀 (더블클릭과 같은 경로)
+    std::vector<double> pickMs;
+    pickMs.reserve(size_t(grid) * grid);
+    int hits = 0;
+    qint64 visitedNodes = 0, testedSplats = 0;
+    for (int y = 0; y < grid; ++y) {
+        for (int x = 0; x < grid; ++x) {
+            const QPointF pos((x + 0.5) * width() / grid, (y + 0.5) * height() / grid);
+            const SplatPick hit = pickAt(pos);
+            pickMs.push_back(m_lastPickMs);
+            if (hit.hit) ++hits;
+            visitedNodes += hit.visitedNodes;
+            testedSplats += hit.testedSplats;
+        }
+    }
+
+    // 목표: 1000만 스플랫 씬에서도 한 번의 피킹이 1 ms 미만
+    const double targetMs = 1.0;
+    const FrameTimeSummary summary = FrameTimeSummary::fromSamples(pickMs);
+    const int rays = int(pickMs.size());
+    QStringList report;
+    report << QString("Pick latency over %1 rays (%2x%2 grid), %3 splats in %4 scene(s):")
+                  .arg(rays).arg(grid).arg(splats).arg(scenes.size());
+    report << QString("  BVH: %1 nodes, %2 MB, built at load in %3 ms")
+                  .arg(bvhNodes).arg(bvhBytes / (1024.0 * 1024.0), 0, 'f', 1).arg(buildMs, 0, 'f', 1);
+    report << QString("  Per pick: avg %1 ms, p50 %2 ms, p99 %3 ms, max %4 ms -> %5 the %6 ms target at p99")
+                  .arg(summary.avgMs, 0, 'f', 3).arg(summary.p50Ms, 0, 'f', 3).arg(summary.p99Ms, 0, 'f', 3)
+                  .arg(summary.maxMs, 0, 'f', 3).arg(summary.p99Ms < targetMs ? "meets" : "MISSES")
+                  .arg(targetMs, 0, 'f', 1);
+    report << QString("  Hits: %1 of %2, avg %3 nodes visited, %4 splats tested")
+                  .arg(hits).arg(rays).arg(double(visitedNodes) / rays, 0, 'f', 1)
+                  .arg(double(testedSplats) / rays, 0, 'f', 1);
+
+    const QString result = report.join("\n");
+    qInfo().noquote() << result;
+    update();
+    return result;
+}
+
+void SplattingWidget::selectRegion(const QPolygonF &widgetPolygon, bool isRect)
+{
+    std::vector<const SplatScene *> scenes;
+    std::vector<int> sceneSlots;
+    if (!pickableScenes(scenes, sceneSlots)) return;
+
+    QPolygonF ndcPolygon;
+    for (const QPointF &p : widgetPolygon) ndcPolygon << widgetToNdc(p);
+
+    QElapsedTimer timer;
+    timer.start();
+    SplatScene::selectRegion(scenes, sceneSlots, m_camera.getViewMatrix(), projectionMatrix(false), m_globalScale,
+                             ndcPolygon, isRect, m_selection);
+    m_lastSelectMs = timer.nsecsElapsed() / 1.0e6;
+    update();
+}
+
+void SplattingWidget::clearSelection()
+{
+    m_selection.clear();
+    m_lastSelectMs = -1.0;
+    update();
+}
+
+void SplattingWidget::wheelEvent(QWheelEvent *event)
+{
+    if (m_pathPlayer.isPlaying()) return;
+
+    m_latency.markInput();
+    beginInteraction();
+    m_camera.handleWheel(event);
+    m_pathRecorder.record(m_camera.state());
+    invalidate(Input_Camera);
+}
+
+void SplattingWidget::setProgressiveRefinement(bool enabled)
+{
+    if (m_progressive == enabled) return;
+    m_progressive = enabled;
+    if (!enabled) {
+        m_idleTimer.stop();
+        m_interacting = false;
+        m_refineStep = 0;
+        applyDrawBudget(-1);
+    }
+}
+
+void SplattingWidget::setInteractiveFrameTarget(float ms)
+{
+    m_interactiveTargetMs = std::max(ms, 1.0f);
+    if (m_interacting) applyDrawBudget(interactiveBudget());
+}
+
+void SplattingWidget::beginInteraction()
+{
+    if (!m_progressive) return;
+    m_idleTimer.start(); // 입력이 이어지는 동안 계속 미뤄짐
+    if (m_interacting) return;
+
+    m_interacting = true;
+    m_refineStep = 0;
+    applyDrawBudget(interactiveBudget());
+}
+
+void SplattingWidget::onInteractionIdle()
+{
+    if (!m_interacting) return;
+    m_interacting = false;
+    m_refineStep = REFINE_STEPS;
+    advanceRefinement();
+}
+
+void SplattingWidget::advanceRefinement()
+{
+    if (m_refineStep <= 0 || m_drawBudget < 0) {
+        m_refineStep = 0;
+        return;
+    }
+
+    // 현재 예산에서 전체까지 남은 단계 수만큼 기하급수적으로 늘림 (마지막 단계는 전체)
+    --m_refineStep;
+    if (m_refineStep == 0) {
+        applyDrawBudget(-1);
+        return;
+    }
+    qint64 total = 0;
+    for (const auto &scene : m_scenes) {
+        if (scene->isVisible()) total += scene->fullDrawCount();
+    }
+    const double ratio = double(total) / std::max<qint64>(m_drawBudget, 1);
+    applyDrawBudget(qint64(m_drawBudget * std::pow(ratio, 1.0 / (m_refineStep + 1))));
+}
+
+qint64 SplattingWidget::interactiveBudget() const
+{
+    qint64 total = 0;
+    for (const auto &scene : m_scenes) {
+        if (scene->isVisible()) total += scene->fullDrawCount();
+    }
+    // 아직 측정값이 없으면 1/4에서 시작
+    qint64 budget = m_nsPerSplat > 0.0 ? qint64(m_interactiveTargetMs * 1.0e6 / m_nsPerSplat) : total / 4;
+    budget = std::max<qint64>(budget, MIN_INTERACTIVE_SPLATS);
+    return budget >= total ? -1 : budget;
+}
+
+void SplattingWidget::applyDrawBudget(qint64 budget)
+{
+    m_drawBudget = budget;
+
+    // 씬마다 자기 그리기 집합 크기에 비례해 나눔 (스트리밍 씬은 scene 쪽에서 무시)
+    qint64 total = 0;
+    for (const auto &scene : m_scenes) {
+        if (scene->isVisible()) total += scene->fullDrawCount();
+    }
+    bool changed = false;
+    for (auto &scene : m_scenes) {
+        size_t limit = SplatScene::NO_LIMIT;
+        if (budget >= 0 && total > 0) {
+            limit = size_t((budget * scene->fullDrawCount() + total - 1) / total);
+        }
+        changed |= scene->setImportanceLimit(limit);
+    }
+    if (changed) {
+        m_sceneSetChanged = true;
+        invalidate(Input_DrawBudget);
+    }
+}
+
+void SplattingWidget::collectSplatTime()
+{
+    if (!m_splatTimePending) return;
+    GLuint available = 0;
+    glGetQueryObjectuiv(m_splatTimeQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) return;
+
+    // 32비트 ns = 최대 4초이므로 프레임 시간에는 충분
+    GLuint gpuNs = 0;
+    glGetQueryObjectuiv(m_splatTimeQuery, GL_QUERY_RESULT, &gpuNs);
+    m_splatTimePending = false;
+    if (m_timedSplats <= 0) return;
+
+    const double sample = (m_timedSortMs * 1.0e6 + double(gpuNs)) / m_timedSplats;
+    m_nsPerSplat = m_nsPerSplat > 0.0 ? 0.7 * m_nsPerSplat + 0.3 * sample : sample;
+
+    // 조작 중이면 새 추정으로 예산 조정 (10% 이내 변화는 무시해 접두부가 매 프레임 흔들리지 않게)
+    if (m_interacting) {
+        const qint64 budget = interactiveBudget();
+        const qint64 current = m_drawBudget < 0 ? std::numeric_limits<qint64>::max() : m_drawBudget;
+        if (budget < 0 || std::abs(double(budget - current)) > 0.1 * double(current)) applyDrawBudget(budget);
+    }
+}
+
+void SplattingWidget::startCameraRecording()
+{
+    m_pathRecorder.start(m_camera.state());
+    qDebug() << "Camera path recording started";
+}
+
+CameraPath SplattingWidget::stopCameraRecording()
+{
+    m_pathRecorder.stop();
+    qDebug() << "Camera path recording stopped:" << m_pathRecorder.path().size() << "keyframes";
+    return m_pathRecorder.path();
+}
+
+void SplattingWidget::playCameraPath(const CameraPath &path, int stepMs)
+{
+    m_pathPlayer.start(path, stepMs);
+    if (!m_pathPlayer.isPlaying()) {
+        qWarning() << "Camera path is empty, nothing to play.";
+        return;
+    }
+
+    qDebug() << "Playing camera path:" << m_pathPlayer.frameCount() << "frames @" << stepMs << "ms step";
+    update();
+}
+
+void SplattingWidget::paintGL()
+{
+    // 이 프레임의 힙 할당 수 (S2S_ALLOC_COUNTER 빌드에서만 셈)
+    const quint64 allocStart = AllocCounter::threadCount();
+    const quint64 allocStartAll = AllocCounter::totalCount();
+
+    // 1. FPS 계산
+    m_frameCount++;
+    if (m_fpsTimer.elapsed() >= 1000) {
+        m_currentFps = m_frameCount / (m_fpsTimer.elapsed() / 1000.0f);
+        m_frameCount = 0;
+        m_fpsTimer.restart();
+    }
+
+    if (!m_fbo || !m_fbo->isValid()) return;
+
+    // 지금까지 도착한 입력을 이 프레임이 반영
+    m_latency.beginFrame();
+
+    // 0. 카메라 경로 재생: 마우스 대신 경로에서 다음 상태를 가져옴
+    bool playbackFrame = false;
+    if (m_pathPlayer.isPlaying()) {
+        CameraState state;
+        if (m_pathPlayer.nextFrame(state)) {
+            m_camera.setState(state);
+            m_renderGraph.invalidate(Input_Camera);
+            m_temporalFrame = 0;
+            m_playbackFrameTimer.start();
+            playbackFrame = true;
+        } else {
+            qInfo().noquote() << "Camera path playback finished:" << m_pathPlayer.summary().toString();
+        }
+    }
+
+    // 1. 카메라 행렬 가져오기 (프레임마다 한 번, 다중 뷰 슬롯도 여기서 갱신)
+    const QMatrix4x4 view = m_camera.getViewMatrix();
+    if (m_viewLayout != ViewLayout::Single) updateViewSlots(view);
+
+    // 지난 스플랫 패스의 프래그먼트 쿼리 결과 (준비된 것만)
+    collectFragmentQueries();
+    collectSplatTime();
+
+    // 2. [최적화] 정렬은 "필요할 때(카메라/데이터 변경)"만 수행
+    // OIT/히트맵 모드는 순서와 무관하게 합성하므로 정렬과 재업로드를 통째로 건너뜁니다.
+    // 다중 뷰는 가능하면 정렬 한 번을 모든 뷰가 공유합니다.
+    m_lastSortMs = 0.0;
+    if (m_renderGraph.isDirty(m_sortPass)) {
+        QElapsedTimer sortTimer;
+        sortTimer.start();
+        const bool frontToBack = m_renderMode == RenderMode::FrontToBack;
+        const bool executed = m_viewLayout != ViewLayout::Single
+                                  ? runMultiViewSortPass()
+                                  : runSortPass(view, m_renderMode == RenderMode::Sorted || frontToBack, frontToBack);
+        if (executed) {
+            m_lastSortMs = sortTimer.nsecsElapsed() / 1.0e6;
+            m_renderGraph.markExecuted(m_sortPass);
+        } else {
+            m_renderGraph.markBypassed(m_sortPass);
+        }
+    }
+    m_latency.markSortDone();
+
+    // 3. 스플랫 패스: 입력이 그대로면 m_fbo에 남아있는 이전 결과를 재사용
+    // 시간적 업스케일 중에는 매번 다른 지터로 그려 히스토리에 누적
+    if (m_renderGraph.isDirty(m_splatPass)) {
+        if (m_useTemporal) {
+            m_jitterIndex = (m_jitterIndex + 1) % TEMPORAL_SAMPLES;
+            m_jitter = QVector2D(halton(m_jitterIndex + 1, 2) - 0.5f, halton(m_jitterIndex + 1, 3) - 0.5f);
+        }
+        renderSplatPass(view);
+        if (m_useTemporal) resolveTemporal(view);
+        m_renderGraph.markExecuted(m_splatPass);
+    } else {
+        m_renderGraph.markSkipped(m_splatPass);
+    }
+
+    // 4. 후처리 패스
+    // QOpenGLWidget의 기본 프레임버퍼는 프레임 사이에 보존되지 않으므로 (NoPartialUpdate)
+    // paintGL이 불리면 출력 패스는 항상 다시 그립니다. 비용은 전체 화면 쿼드 1장입니다.
+    renderPostPass();
+    m_renderGraph.markExecuted(m_postPass);
+    m_latency.markDrawDone();
+
+    // 5. 오버레이 (FPS 등): 미리 그려 둔 글리프 아틀라스로 GL에서 직접 그림
+    // QPainter/QFont/QString을 프레임마다 만들지 않으므로 힙 할당이 없습니다.
+    glBindFramebuffer(GL_FRAMEBUFFER, defaultFramebufferObject());
+    drawOverlay();
+    m_overlay.draw(width(), height(), devicePixelRatioF());
+    m_latency.endFrame();
+
+    // 쿼리 결과가 아직 안 왔으면 한 번 더 그려서 가져옴 (스플랫 패스는 캐시 사용)
+    if (m_queryPending) update();
+
+    // 입력이 멈춘 뒤: 이번 프레임을 그렸으면 다음 단계로 접두부를 늘림
+    if (m_refineStep > 0 && !m_interacting) advanceRefinement();
+
+    // 수렴할 때까지 다음 지터 샘플을 계속 그림
+    if (m_useTemporal && m_temporalFrame < TEMPORAL_SAMPLES) {
+        invalidate(Input_Jitter);
+    }
+
+    if (playbackFrame) {
+        // GPU 작업까지 끝난 시간을 재야 정렬/그리기 비용이 모두 포함됩니다.
+        glFinish();
+        m_pathPlayer.recordFrameTime(m_playbackFrameTimer.nsecsElapsed() / 1.0e6);
+        update(); // 다음 재생 프레임
+    }
+
+    m_frameAllocs = AllocCounter::threadCount() - allocStart;
+    m_frameAllocsAll = AllocCounter::totalCount() - allocStartAll;
+    if (m_allocCheckRemaining > 0) recordAllocationCheckFrame();
+}
+
+void SplattingWidget::drawOverlay()
+{
+    if (m_selectDrag != SelectDrag::None && m_selectPath.size() > 1) {
+        // 드래그 중인 선택 영역 (점선)
+        m_overlay.setColor(Qt::cyan);
+        if (m_selectDrag == SelectDrag::Box) {
+            const QRectF r = QRectF(m_selectPath.front(), m_selectPath.back()).normalized();
+            const float x0 = float(r.left()), y0 = float(r.top()), x1 = float(r.right()), y1 = float(r.bottom());
+            m_overlay.line(x0, y0, x1, y0, 1.5f, 6.0f);
+            m_overlay.line(x1, y0, x1, y1, 1.5f, 6.0f);
+            m_overlay.line(x1, y1, x0, y1, 1.5f, 6.0f);
+            m_overlay.line(x0, y1, x0, y0, 1.5f, 6.0f);
+        } else {
+            for (qsizetype i = 0; i < m_selectPath.size(); ++i) {
+                const QPointF &a = m_selectPath[i];
+                const QPointF &b = m_selectPath[(i + 1) % m_selectPath.size()];
+                m_overlay.line(float(a.x()), float(a.y()), float(b.x()), float(b.y()), 1.5f, 6.0f);
+            }
+        }
+    }
+
+    m_overlay.setColor(Qt::yellow);
+    m_overlay.printf(20, 30, "FPS: %.1f", m_currentFps);
+    int prunedCount = 0;
+    for (const auto &scene : m_scenes) {
+        if (scene->isVisible()) prunedCount += scene->prunedCount();
+    }
+    m_overlay.printf(20, 50, "Points: %d (pruned %d, %d scenes)", m_splatCount, prunedCount, sceneCount());
+    m_overlay.printf(20, 70, "Splat Pass: %d / cached %d",
+                     int(m_renderGraph.executedCount(m_splatPass)), int(m_renderGraph.skippedCount(m_splatPass)));
+    int overlayY = 90;
+    if (AllocCounter::isEnabled()) {
+        // 지난 프레임 값 (이 프레임은 아직 끝나지 않음)
+        m_overlay.printf(20, overlayY, "Allocations: %llu last frame (GUI thread), %llu all threads",
+                         (unsigned long long)m_frameAllocs, (unsigned long long)m_frameAllocsAll);
+        overlayY += 20;
+    }
+    if (m_lastOitDiff.valid) {
+        m_overlay.printf(20, overlayY, "OIT vs Sorted: %.2f dB", m_lastOitDiff.psnr);
+        overlayY += 20;
+    }
+    if (m_streamer.isOpen()) {
+        m_overlay.printf(20, overlayY, "Chunks: GPU %d / CPU %d / total %d (loading %d)",
+                         m_streamStats.gpuResidentChunks, m_streamStats.cpuResidentChunks,
+                         m_streamStats.totalChunks, m_streamStats.pendingLoads);
+        overlayY += 20;
+        m_overlay.printf(20, overlayY, "Memory: CPU %lld MB / GPU %lld MB, I/O %.1f MB/s",
+                         (long long)(m_streamStats.cpuBytes / (1024 * 1024)),
+                         (long long)(m_streamStats.gpuBytes / (1024 * 1024)), m_streamStats.ioMBps);
+        overlayY += 20;
+    }
+    if (m_remote.isActive()) {
+        const HttpPlyStream::Stats remote = m_remote.stats();
+        m_overlay.printf(20, overlayY, "Remote: %lld / %lld MB (%.1f MB/s), chunks %d / %d, in flight %d, retries %d",
+                         (long long)(remote.bytesReceived / (1024 * 1024)), (long long)(remote.totalBytes / (1024 * 1024)),
+                         remote.mbps(), remote.chunksDone, remote.chunkCount, remote.inFlight, remote.retries);
+        overlayY += 20;
+    }
+    if (m_useTemporal) {
+        m_overlay.printf(20, overlayY, "Temporal: %d / %d samples",
+                         std::min(m_temporalFrame, int(TEMPORAL_SAMPLES)), int(TEMPORAL_SAMPLES));
+        overlayY += 20;
+    }
+    if (m_viewLayout != ViewLayout::Single) {
+        if (m_sharedSort) {
+            m_overlay.printf(20, overlayY, "Views: %d, shared sort (max %.1f deg from centroid, tolerance %.1f)",
+                             m_viewLayout == ViewLayout::Stereo ? 2 : 4, m_sharedSortAngle, m_sharedSortTolerance);
+        } else {
+            m_overlay.printf(20, overlayY, "Views: %d, %d per-view sorts (max %.1f deg from centroid, tolerance %.1f)",
+                             m_viewLayout == ViewLayout::Stereo ? 2 : 4, m_viewSortCount, m_sharedSortAngle,
+                             m_sharedSortTolerance);
+        }
+        overlayY += 20;
+    }
+    if (m_renderMode == RenderMode::FrontToBack) {
+        m_overlay.printf(20, overlayY, "Front-to-Back: %d saturation passes", m_saturationMarks);
+        overlayY += 20;
+    }
+    if (m_depthPrepass && m_viewLayout == ViewLayout::Single
+        && (m_renderMode == RenderMode::Sorted || m_renderMode == RenderMode::FrontToBack)) {
+        m_overlay.printf(20, overlayY, "Depth pre-pass: %d occluders (%.1f%%), core alpha >= %.2f", m_prepassCount,
+                         m_splatCount > 0 ? 100.0 * m_prepassCount / m_splatCount : 0.0, m_coreAlpha);
+        overlayY += 20;
+    }
+    if (m_occlusionCulling && m_viewLayout == ViewLayout::Single
+        && (m_renderMode == RenderMode::Sorted || m_renderMode == RenderMode::FrontToBack)) {
+        const OcclusionStats &occ = m_occlusionStats;
+        m_overlay.printf(20, overlayY, "Occlusion: %lld splats in %d of %d clusters hidden, %lld outside view (%.2f ms)",
+                         (long long)occ.occludedSplats, occ.occludedClusters, occ.clusters,
+                         (long long)occ.frustumSplats, occ.ms);
+        overlayY += 20;
+        m_overlay.printf(20, overlayY, "  occluders: %d nearest clusters, %d core splats", occ.occluderClusters,
+                         occ.occluderSplats);
+        overlayY += 20;
+    }
+    if (m_lastPickMs >= 0.0) {
+        m_overlay.printf(20, overlayY, "Pick: %s in %.3f ms (%d nodes, %d splats)", m_lastPick.hit ? "hit" : "miss",
+                         m_lastPickMs, int(m_lastPick.visitedNodes), int(m_lastPick.testedSplats));
+        overlayY += 20;
+    }
+    if (m_lastSelectMs >= 0.0) {
+        m_overlay.printf(20, overlayY, "Selection: %d splats in %.2f ms", int(m_selection.size()), m_lastSelectMs);
+        overlayY += 20;
+    }
+    if (m_renderMode == RenderMode::OverdrawHeatmap) {
+        m_overlay.printf(20, overlayY, "Overdraw: mean %.2f (covered %.2f), peak %.0f fragments/pixel",
+                         double(m_overdrawMean), double(m_overdrawCoveredMean), double(m_overdrawPeak));
+        overlayY += 20;
+        m_overlay.printf(20, overlayY, "Heatmap: rasterized %.2f M, kept %.2f M (discarded %.1f%%)",
+                         m_overdrawCounts.shaded / 1.0e6, m_overdrawCounts.passed / 1.0e6,
+                         m_overdrawCounts.discardedRatio() * 100.0);
+        overlayY += 20;
+    }
+    if (m_fragmentStats.valid) {
+        if (m_fragmentStats.hasShaded) {
+            m_overlay.printf(20, overlayY, "Fragments: shaded %.2f M, passed %.2f M (discarded %.1f%%)",
+                             m_fragmentStats.shaded / 1.0e6, m_fragmentStats.passed / 1.0e6,
+                             m_fragmentStats.discardedRatio() * 100.0);
+        } else {
+            m_overlay.printf(20, overlayY, "Fragments: passed %.2f M (no pipeline statistics)",
+                             m_fragmentStats.passed / 1.0e6);
+        }
+        overlayY += 20;
+    }
+    if (m_progressive) {
+        if (m_drawBudget < 0) {
+            m_overlay.printf(20, overlayY, "Progressive: full set (target %.1f ms, %.2f ns/splat)",
+                             double(m_interactiveTargetMs), double(m_nsPerSplat));
+        } else {
+            m_overlay.printf(20, overlayY, "Progressive: %d splats (target %.1f ms, %.2f ns/splat)", m_splatCount,
+                             double(m_interactiveTargetMs), double(m_nsPerSplat));
+        }
+        overlayY += 20;
+    }
+    if (m_latency.isEnabled()) {
+        const LatencyHistogram &total = m_latency.histogram(Latency_Total);
+        m_overlay.printf(20, overlayY, "Latency: p50 %.2f ms, p95 %.2f ms (%d events, swap interval %d%s)",
+                         total.percentileMs(0.50), total.percentileMs(0.95), total.count(),
+                         format().swapInterval(), m_lateFrameStart ? ", late start" : "");
+        overlayY += 20;
+        m_overlay.printf(20, overlayY, "  queue %.2f / sort %.2f / draw %.2f / present %.2f ms avg",
+                         m_latency.histogram(Latency_Queue).meanMs(), m_latency.histogram(Latency_Sort).meanMs(),
+                         m_latency.histogram(Latency_Draw).meanMs(), m_latency.histogram(Latency_Present).meanMs());
+        overlayY += 20;
+
+        // 전체 지연 히스토그램 (칸 하나 = 가로 2px, 가장 많은 칸 = 높이 60px)
+        const std::vector<int> &bins = total.bins();
+        const int peak = *std::max_element(bins.begin(), bins.end());
+        if (peak > 0) {
+            const int baseY = overlayY + 60;
+            for (int i = 0; i < LatencyHistogram::BIN_COUNT; ++i) {
+                const int h = bins[i] * 60 / peak;
+                if (h > 0) m_overlay.rect(20 + 2 * i, baseY - h, 1, h);
+            }
+            m_overlay.text(20, baseY + 16, "0 ms");
+            m_overlay.printf(20 + LatencyHistogram::BIN_COUNT * 2 - 40, baseY + 16, "%.0f ms",
+                             double(LatencyHistogram::BIN_COUNT * LatencyHistogram::BIN_MS));
+            overlayY += 80;
+        }
+    }
+}
+
+bool SplattingWidget::startAllocationCheck(int frames, bool exitWhenDone)
+{
+    if (!AllocCounter::isEnabled()) {
+        qCritical() << "Allocation check needs a build with S2S_ALLOC_COUNTER (Debug builds enable it).";
+        return false;
+    }
+    // 처음 몇 프레임은 캐시/셰이더 변형/목록 용량이 자리를 잡는 구간이므로 세지 않음
+    m_allocCheckWarmup = std::min(60, std::max(1, frames / 4));
+    m_allocCheckRemaining = std::max(1, frames) + m_allocCheckWarmup;
+    m_allocCheckFrames = 0;
+    m_allocCheckFailedFrames = 0;
+    m_allocCheckMax = 0;
+    m_allocCheckExit = exitWhenDone;
+    qInfo().noquote() << QString("Allocation check: %1 frames after %2 warm-up frames")
+                             .arg(m_allocCheckRemaining - m_allocCheckWarmup)
+                             .arg(m_allocCheckWarmup);
+    update();
+    return true;
+}
+
+void SplattingWidget::recordAllocationCheckFrame()
+{
+    --m_allocCheckRemaining;
+    if (m_allocCheckWarmup > 0) {
+        --m_allocCheckWarmup;
+    } else {
+        ++m_allocCheckFrames;
+        if (m_frameAllocs > 0) ++m_allocCheckFailedFrames;
+        m_allocCheckMax = std::max(m_allocCheckMax, m_frameAllocs);
+    }
+    if (m_allocCheckRemaining > 0) return;
+
+    const bool passed = m_allocCheckFailedFrames == 0;
+    qInfo().noquote() << QString("Allocation check %1: %2 of %3 frames allocated on the GUI thread (max %4 per frame)")
+                             .arg(passed ? "passed" : "FAILED")
+                             .arg(m_allocCheckFailedFrames)
+                             .arg(m_allocCheckFrames)
+                             .arg(m_allocCheckMax);
+    if (m_allocCheckExit) QCoreApplication::exit(passed ? 0 : 3);
+}
+
+void SplattingWidget::advanceAllocationCheck()
+{
+    if (m_allocCheckRemaining <= 0) return;
+    // 매 프레임 정렬 + 스플랫 패스가 돌도록 카메라를 조금씩 돌림 (정지 화면은 캐시만 씀)
+    CameraState state = m_camera.state();
+    state.yaw += 0.5f;
+    m_camera.setState(state);
+    invalidate(Input_Camera);
+}
+
+bool SplattingWidget::runSortPass(const QMatrix4x4& view, bool sorted, bool frontToBack)
+{
+    if (!sorted) {
+        // OIT: 순서와 무관하므로 씬 구성이 바뀌었을 때만 목록을 다시 만듭니다.
+        // (정렬 모드에서 쓰던 목록도 그대로 쓸 수 있음)
+        // 카메라 이동으로는 정렬도, 재업로드도 일어나지 않습니다.
+        if (!m_sceneSetChanged) return false;
+
+        m_drawList.clear();
+        for (int i = 0; i < sceneCount(); ++i) {
+            if (!m_scenes[i]->isVisible()) continue;
+            m_scenes[i]->forEachDrawn([&](quint32 index) {
+                m_drawList.push_back(SplatRef::make(i, index));
+            });
+        }
+    } else {
+        // 시야 밖/가려진 클러스터를 정렬 전에 뺌 (씬별 컬링 집합이 바뀌면 그 씬은 다시 정렬됨)
+        if (m_occlusionCulling && m_viewLayout == ViewLayout::Single) cullClusters(view);
+        else clearClusterCulling();
+        mergeSortedScenes(view, m_drawList);
+
+        // Under 연산자는 앞에서부터 합성 (씬별 정렬 캐시는 그대로 두고 병합 결과만 뒤집음)
+        if (frontToBack) std::reverse(m_drawList.begin(), m_drawList.end());
+    }
+    m_drawListFrontToBack = sorted && frontToBack;
+    m_sceneSetChanged = false;
+    m_splatCount = static_cast<int>(m_drawList.size());
+    uploadDrawList();
+    return true;
+}
+
+void SplattingWidget::mergeSortedScenes(const QMatrix4x4& view, std::vector<quint32> &outList)
+{
+    // 프레임마다 쓰는 임시 목록은 멤버로 두어 용량을 재사용
+    std::vector<const SplatScene *> &visible = m_mergeVisible;
+    std::vector<SplatScene *> &needSort = m_mergeNeedSort;
+    std::vector<int> &sceneSlots = m_mergeSlots;
+    visible.clear();
+    needSort.clear();
+    sceneSlots.clear();
+    for (int i = 0; i < sceneCount(); ++i) {
+        if (!m_scenes[i]->isVisible()) continue;
+        visible.push_back(m_scenes[i].get());
+        sceneSlots.push_back(i);
+        if (m_scenes[i]->needsSort(view)) needSort.push_back(m_scenes[i].get());
+    }
+
+    // 뷰(또는 자기 변환)가 바뀐 씬만 병렬로 다시 정렬
+    parallelFor(0, static_cast<int>(needSort.size()), [&](int i) {
+        needSort[i]->sortBackToFront(view);
+    });
+
+    // 씬별 정렬 결과를 하나의 전역 뒤 -> 앞 순서로 병합
+    SplatScene::mergeBackToFront(visible, sceneSlots, outList);
+}
+
+void SplattingWidget::uploadDrawList()
+{
+    // 그리기 순서만 재전송 (스플랫당 4바이트, 스플랫 데이터 자체는 그대로)
+    m_orderVbo.bind();
+    m_orderVbo.allocate(m_drawList.data(), static_cast<int>(m_drawList.size() * sizeof(quint32)));
+    m_orderVbo.release();
+    m_prepassDirty = true; // 프리패스 목록은 쓸 때 다시 만듦
+}
+
+void SplattingWidget::buildPrepassList()
+{
+    // 가리는 스플랫 = 중심 알파(opacity)가 코어 임계값 이상 (그보다 낮으면 코어가 없음)
+    // 앞 -> 뒤 순서로 그려야 가까운 코어가 먼저 깊이를 채워 뒤쪽 코어의 깊이 쓰기가 줄어듦
+    m_prepassList.clear();
+    const int count = std::min(m_splatCount, static_cast<int>(m_drawList.size()));
+    auto consider = [&](quint32 ref) {
+        const std::vector<RenderSplat> &splats = m_scenes[SplatRef::slot(ref)]->splats();
+        const quint32 index = SplatRef::index(ref);
+        if (index < splats.size() && splats[index].opacity >= m_coreAlpha) m_prepassList.push_back(ref);
+    };
+    if (m_drawListFrontToBack) {
+        for (int i = 0; i < count; ++i) consider(m_drawList[i]);
+    } else {
+        for (int i = count - 1; i >= 0; --i) consider(m_drawList[i]);
+    }
+
+    m_prepassCount = static_cast<int>(m_prepassList.size());
+    m_prepassVbo.bind();
+    m_prepassVbo.allocate(m_prepassList.data(), static_cast<int>(m_prepassList.size() * sizeof(quint32)));
+    m_prepassVbo.release();
+    m_prepassDirty = false;
+}
+
+void SplattingWidget::renderDepthPrepass(const QMatrix4x4& view)
+{
+    // 호출 전 상태: 대상 FBO 바인딩, 깊이 버퍼 지움
+    if (m_prepassDirty) buildPrepassList();
+
+    drawDepthCores(view, m_prepassVbo, m_prepassCount);
+
+    // 블렌딩 패스: 코어와 같은 깊이까지 통과, 깊이는 쓰지 않음
+    glDepthFunc(GL_LEQUAL);
+    glDepthMask(GL_FALSE);
+}
+
+void SplattingWidget::drawDepthCores(const QMatrix4x4& view, QOpenGLBuffer &refs, int count)
+{
+    glEnable(GL_DEPTH_TEST);
+    glDepthFunc(GL_LESS);
+    glDepthMask(GL_TRUE);
+    if (count <= 0) return;
+
+    QOpenGLShaderProgram *program = splatProgram(SplatProgram_Blend, SplatShaders::Feature_DepthCore);
+    if (!program || !program->bind()) return;
+    setSplatUniforms(program, view);
+    program->setUniformValue("uCoreAlpha", m_coreAlpha);
+
+    glDisable(GL_BLEND);
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+
+    // 프래그먼트 쿼리 밖에서 그림 (통계는 블렌딩 패스만)
+    m_vao.bind();
+    refs.bind();
+    glVertexAttribIPointer(1, 1, GL_UNSIGNED_INT, sizeof(quint32), nullptr);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, count);
+    m_orderVbo.bind();
+    glVertexAttribIPointer(1, 1, GL_UNSIGNED_INT, sizeof(quint32), nullptr);
+    m_orderVbo.release();
+    m_vao.release();
+    program->release();
+
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+}
+
+void SplattingWidget::clearClusterCulling()
+{
+    static const std::vector<quint8> none;
+    for (const auto &scene : m_scenes) scene->setCulledClusters(none);
+    m_occlusionStats = OcclusionStats();
+}
+
+void SplattingWidget::cullClusters(const QMatrix4x4& view)
+{
+    // 가까운 클러스터가 그리기 집합의 이 비율(최소 OCCLUDER_MIN_SPLATS)이 될 때까지 가리개로 씀
+    // 많을수록 피라미드가 촘촘해지지만 리드백 전에 GPU가 끝내야 할 일이 늘어남
+    const double OCCLUDER_FRACTION = 0.1;
+    const qint64 OCCLUDER_MIN_SPLATS = 32768;
+    // 사각형 꼭짓점까지의 여유 (셰이더의 사각형 = 스케일 x 전역 스케일, 대각선은 sqrt(2)배)
+    const float EXTENT_PADDING = 1.5f;
+
+    QElapsedTimer timer;
+    timer.start();
+    OcclusionStats stats;
+    m_cullCandidates.clear();
+    if (m_cullMasks.size() < m_scenes.size()) m_cullMasks.resize(m_scenes.size());
+
+    // 1. 클러스터마다 넓힌 AABB를 그릴 때와 같은 (지터된) 투영으로 사영
+    //    한 평면 밖에 꼭짓점이 모두 있으면 시야 밖, 아니면 후보 (근평면에 걸치면 사각형을 믿을 수 없어 항상 그림)
+    const QMatrix4x4 viewProj = projectionMatrix(true) * view;
+    qint64 candidateSplats = 0;
+    for (int s = 0; s < sceneCount(); ++s) {
+        SplatScene *scene = m_scenes[s].get();
+        std::vector<quint8> &mask = m_cullMasks[s];
+        mask.clear();
+        if (!scene->isVisible() || scene->hasActiveSet() || scene->clusters().empty()) continue;
+
+        const std::vector<SplatCluster> &clusters = scene->clusters();
+        const std::vector<quint32> &drawCounts = scene->clusterDrawCounts();
+        const QMatrix4x4 mvp = viewProj * scene->modelMatrix();
+        mask.assign(clusters.size(), 0);
+        for (size_t c = 0; c < clusters.size(); ++c) {
+            const SplatCluster &cluster = clusters[c];
+            const quint32 splats = drawCounts[c];
+            if (splats == 0) continue;
+            ++stats.clusters;
+
+            const float pad = cluster.maxScale * m_globalScale * EXTENT_PADDING;
+            const QVector3D lo = cluster.bboxMin - QVector3D(pad, pad, pad);
+            const QVector3D hi = cluster.bboxMax + QVector3D(pad, pad, pad);
+            quint32 outsideAll = 0x3Fu;
+            bool straddles = false;
+            ClusterCandidate candidate = { 0.0f, 1.0f, 1.0f, -1.0f, -1.0f, 1.0f, true, s, quint32(c), splats };
+            float distance = std::numeric_limits<float>::max();
+            for (int k = 0; k < 8; ++k) {
+                const QVector4D clip = mvp * QVector4D((k & 1) ? hi.x() : lo.x(), (k & 2) ? hi.y() : lo.y(),
+                                                       (k & 4) ? hi.z() : lo.z(), 1.0f);
+                const float w = clip.w();
+                const quint32 outside = (clip.x() < -w ? 1u : 0u) | (clip.x() > w ? 2u : 0u)
+                                        | (clip.y() < -w ? 4u : 0u) | (clip.y() > w ? 8u : 0u)
+                                        | (clip.z() < -w ? 16u : 0u) | (clip.z() > w ? 32u : 0u);
+                outsideAll &= outside;
+                if (w <= 0.0f || clip.z() < -w) {
+                    straddles = true;
+                    continue;
+                }
+                const float x = clip.x() / w, y = clip.y() / w;
+                candidate.x0 = std::min(candidate.x0, x);
+                candidate.x1 = std::max(candidate.x1, x);
+                candidate.y0 = std::min(candidate.y0, y);
+                candidate.y1 = std::max(candidate.y1, y);
+                candidate.nearestDepth = std::min(candidate.nearestDepth, clip.z() / w * 0.5f + 0.5f);
+                distance = std::min(distance, w);
+            }
+            if (outsideAll) {
+                mask[c] = 1;
+                ++stats.frustumClusters;
+                stats.frustumSplats += splats;
+                continue;
+            }
+            candidate.testable = !straddles;
+            candidate.distance = straddles ? 0.0f : distance;
+            m_cullCandidates.push_back(candidate);
+            candidateSplats += splats;
+        }
+    }
+
+    // 2. 가까운 클러스터부터 가리개로: 코어(opacity >= 코어 임계값)만 깊이로 그려 Hi-Z를 만듦
+    std::sort(m_cullCandidates.begin(), m_cullCandidates.end(),
+              [](const ClusterCandidate &a, const ClusterCandidate &b) { return a.distance < b.distance; });
+    const qint64 occluderBudget = std::max<qint64>(OCCLUDER_MIN_SPLATS, qint64(candidateSplats * OCCLUDER_FRACTION));
+    size_t occluderCount = 0;
+    qint64 occluderSplats = 0;
+    m_occluderList.clear();
+    while (occluderCount < m_cullCandidates.size() && occluderSplats < occluderBudget) {
+        const ClusterCandidate &candidate = m_cullCandidates[occluderCount++];
+        const SplatScene *scene = m_scenes[candidate.scene].get();
+        const SplatCluster &cluster = scene->clusters()[candidate.cluster];
+        const std::vector<RenderSplat> &splats = scene->splats();
+        for (quint32 i = cluster.begin; i < cluster.begin + cluster.count; ++i) {
+            if (scene->isInDrawSet(i) && splats[i].opacity >= m_coreAlpha) {
+                m_occluderList.push_back(SplatRef::make(candidate.scene, i));
+            }
+        }
+        occluderSplats += candidate.splats;
+    }
+    stats.occluderClusters = int(occluderCount);
+    stats.occluderSplats = int(m_occluderList.size());
+
+    // 3. 나머지 클러스터를 피라미드로 검사 (가리개가 있고 피라미드를 쓸 수 있을 때만)
+    if (!m_occluderList.empty() && occluderCount < m_cullCandidates.size() && m_hiz.isValid()) {
+        m_occluderVbo.bind();
+        m_occluderVbo.allocate(m_occluderList.data(), int(m_occluderList.size() * sizeof(quint32)));
+        m_occluderVbo.release();
+
+        m_hiz.bindDepthTarget();
+        drawDepthCores(view, m_occluderVbo, int(m_occluderList.size()));
+        m_hiz.build(); // 깊이 테스트는 꺼진 상태로 끝남
+        glBindFramebuffer(GL_FRAMEBUFFER, defaultFramebufferObject());
+
+        for (size_t k = occluderCount; k < m_cullCandidates.size(); ++k) {
+            const ClusterCandidate &candidate = m_cullCandidates[k];
+            if (!candidate.testable) continue;
+            if (m_hiz.isOccluded(candidate.x0, candidate.y0, candidate.x1, candidate.y1, candidate.nearestDepth)) {
+                m_cullMasks[candidate.scene][candidate.cluster] = 1;
+                ++stats.occludedClusters;
+                stats.occludedSplats += candidate.splats;
+            }
+        }
+    }
+
+    // 4. 씬별 컬링 집합 반영 (바뀐 씬만 다시 정렬)
+    for (int s = 0; s < sceneCount(); ++s) m_scenes[s]->setCulledClusters(m_cullMasks[s]);
+    stats.ms = timer.nsecsElapsed() / 1.0e6;
+    m_occlusionStats = stats;
+}
+
+void SplattingWidget::updateViewSlots(const QMatrix4x4 &view)
+{
+    std::vector<ViewSlot> &views = m_viewSlots; // 용량은 첫 프레임 이후 그대로 (최대 4개)
+    views.clear();
+    const CameraState state = m_camera.state();
+    const int halfW = INTERNAL_WIDTH / 2, halfH = INTERNAL_HEIGHT / 2;
+
+    switch (m_viewLayout) {
+    case ViewLayout::Stereo: {
+        // 평행 축 스테레오: 눈 위치만 좌우로 옮기고 시선 방향은 같음 -> 공유 정렬이 정확
+        const float halfSeparation = 0.5f * m_stereoSeparation * state.distance;
+        for (int eye = 0; eye < 2; ++eye) {
+            QMatrix4x4 eyeShift;
+            eyeShift.translate(eye == 0 ? halfSeparation : -halfSeparation, 0.0f, 0.0f);
+            views.push_back({ eyeShift * view, QRect(eye * halfW, 0, halfW, INTERNAL_HEIGHT) });
+        }
+        break;
+    }
+    case ViewLayout::QuadOrbit:
+        // 2x2 (GL 뷰포트는 아래가 원점이므로 위 줄이 y = halfH)
+        for (int k = 0; k < 4; ++k) {
+            CameraState orbit = state;
+            orbit.yaw += (k - 1.5f) * m_orbitSpread;
+            Camera camera;
+            camera.setState(orbit);
+            views.push_back({ camera.getViewMatrix(), QRect((k % 2) * halfW, (k < 2) ? halfH : 0, halfW, halfH) });
+        }
+        break;
+    default:
+        views.push_back({ view, QRect(0, 0, INTERNAL_WIDTH, INTERNAL_HEIGHT) });
+        break;
+    }
+}
+
+bool SplattingWidget::runMultiViewSortPass()
+{
+    const std::vector<ViewSlot> &views = m_viewSlots;
+    clearClusterCulling(); // 컬링은 단일 뷰에서만 (뷰마다 가려지는 것이 다름)
+
+    // 정렬 키는 뷰 공간 z (뷰 행렬 3행과의 내적)이므로 순서는 시선 방향에만 의존합니다.
+    // 공유 정렬 시점 = 시선 방향의 평균. 두 스플랫의 순서가 뷰 v와 공유 시점에서 달라지려면
+    // 둘을 잇는 벡터가 두 시선에 수직인 평면 사이에 있어야 하므로, 뒤바뀐 쌍의 깊이 차는
+    // sin(각도) x 거리 이하로 묶입니다. 최대 각도가 허용치 안이면 정렬 한 번을 모든 뷰가 공유합니다.
+    QVector3D centroid;
+    for (const ViewSlot &v : views) centroid += QVector3D(v.view(2, 0), v.view(2, 1), v.view(2, 2));
+    centroid.normalize();
+
+    float maxAngle = 0.0f;
+    for (const ViewSlot &v : views) {
+        const QVector3D forward(v.view(2, 0), v.view(2, 1), v.view(2, 2));
+        const float cosAngle = std::clamp(QVector3D::dotProduct(forward.normalized(), centroid), -1.0f, 1.0f);
+        maxAngle = std::max(maxAngle, qRadiansToDegrees(std::acos(cosAngle)));
+    }
+    m_sharedSortAngle = maxAngle;
+    m_sharedSort = maxAngle <= m_sharedSortTolerance;
+
+    if (m_sharedSort) {
+        QMatrix4x4 centroidView = views[0].view;
+        centroidView.setRow(2, QVector4D(centroid, views[0].view(2, 3)));
+        m_viewSortCount = 1;
+        return runSortPass(centroidView, true);
+    }
+
+    // 뷰끼리 너무 다르면 뷰마다 정렬해 목록을 이어 붙임 (뷰 v = [v * 길이, (v + 1) * 길이))
+    // 씬의 정렬 캐시는 하나뿐이므로 이 경우에는 매번 뷰 수만큼 정렬합니다.
+    std::vector<quint32> &list = m_viewSortList;
+    m_drawList.clear();
+    for (const ViewSlot &v : views) {
+        mergeSortedScenes(v.view, list);
+        m_drawList.insert(m_drawList.end(), list.begin(), list.end());
+    }
+    m_viewSortCount = static_cast<int>(views.size());
+    m_sceneSetChanged = false;
+    m_splatCount = static_cast<int>(list.size());
+    uploadDrawList();
+    return true;
+}
 
-    // [Layout 0] Quad Vertex Position (vec2)
-    // 이 속성은 인스턴스마다 변하지 않고, 사각형 그릴 때마다 재사용됨
-    m_program->enableAttributeArray(0);
-    m_program->setAttributeBuffer(0, GL_FLOAT, 0, 2, 2 * sizeof(float));
+void SplattingWidget::renderMultiViewSplats()
+{
+    const std::vector<ViewSlot> &views = m_viewSlots;
 
-    // 2. 인스턴스 데이터용 VBO 생성 (아직 데이터는 없음)
-    m_instanceVbo.create();
-    m_instanceVbo.bind();
+    m_fbo->bind();
+    const GLenum drawBuffers[1] = { GL_COLOR_ATTACHMENT0 };
+    glDrawBuffers(1, drawBuffers);
+    glViewport(0, 0, INTERNAL_WIDTH, INTERNAL_HEIGHT);
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-    m_vao.release();
-    m_instanceVbo.release(); // quadVbo는 release 안 해도 됨 (다음 바인딩 때 풀림)
-#endif
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDepthMask(GL_FALSE);
 
-    initFSRQuad();
+    // 뷰마다 유니폼 + 뷰포트만 바꾸고 드로우 한 번 (프로그램/VAO/씬 텍스처는 한 번만 바인딩)
+    QOpenGLShaderProgram *program = splatProgram(SplatProgram_Blend);
+    if (program && program->bind()) {
+        m_vao.bind();
+        for (size_t v = 0; v < views.size(); ++v) {
+            const QRect &tile = views[v].tile;
+            glViewport(tile.x(), tile.y(), tile.width(), tile.height());
+            setSplatUniforms(program, views[v].view, float(tile.width()) / tile.height());
+            drawSplatInstances(m_sharedSort ? 0 : static_cast<int>(v) * m_splatCount, m_splatCount);
+        }
+        m_vao.release();
+        program->release();
+    }
 
-    // 3. FBO 생성 (1280x720 고정 해상도, Depth/Stencil 포함)
-    QOpenGLFramebufferObjectFormat format;
-    format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
-    m_fbo = new QOpenGLFramebufferObject(INTERNAL_WIDTH, INTERNAL_HEIGHT, format);
+    glDepthMask(GL_TRUE);
+    glDisable(GL_BLEND);
+    m_fbo->release();
+}
 
-    if (m_fbo->isValid()) {
-        qDebug() << "FBO Created Successfully: 1280x720";
-    } else {
-        qCritical() << "FBO Creation Failed!";
+void SplattingWidget::renderSplatPass(const QMatrix4x4& view)
+{
+    // 비교/벤치마크에서 부르는 그리기는 세지 않음
+    m_countThisPass = !m_queryPending
+                      && (m_fragmentStatsEnabled || m_renderMode == RenderMode::OverdrawHeatmap);
+    if (m_countThisPass) m_queriesUsed = 0;
+
+    // 점진적 정제의 비용 추정용 (한 번에 하나만 진행)
+    const bool timed = m_progressive && !m_splatTimePending;
+    if (timed) {
+        if (!m_splatTimeQuery) glGenQueries(1, &m_splatTimeQuery);
+        glBeginQuery(GL_TIME_ELAPSED, m_splatTimeQuery);
+    }
+
+    switch (m_viewLayout != ViewLayout::Single ? RenderMode::Sorted : m_renderMode) {
+    case RenderMode::WeightedOIT:
+        renderOitSplats(view);
+        break;
+    case RenderMode::FrontToBack:
+        renderFrontToBackSplats(view);
+        break;
+    case RenderMode::OverdrawHeatmap:
+        renderOverdrawHeatmap(view);
+        break;
+    default:
+        if (m_viewLayout != ViewLayout::Single) renderMultiViewSplats();
+        else renderSortedSplats(view);
+        break;
+    }
+    if (m_countThisPass) m_queryPending = m_queriesUsed > 0;
+    m_countThisPass = false;
+
+    if (timed) {
+        glEndQuery(GL_TIME_ELAPSED);
+        m_splatTimePending = true;
+        m_timedSortMs = m_lastSortMs;
+        m_timedSplats = m_splatCount;
     }
 }
 
-void SplattingWidget::resizeGL(int w, int h)
+void SplattingWidget::drawSplatInstances(int first, int count)
 {
-    // 윈도우 크기가 변해도 FBO 크기는 고정(1280x720)이므로
-    // 여기서 FBO를 재생성하지 않습니다.
-    // 대신 화면 갱신 요청만 합니다.
-    update();
+    if (count < 0) count = m_splatCount - first;
+    if (count <= 0) return;
+
+    // GL 3.3에는 base instance가 없으므로 순서 VBO의 시작 위치를 옮겨 구간을 그림
+    if (first > 0) {
+        m_orderVbo.bind();
+        glVertexAttribIPointer(1, 1, GL_UNSIGNED_INT, sizeof(quint32),
+                               reinterpret_cast<const void *>(size_t(first) * sizeof(quint32)));
+    }
+
+    // 인스턴스 드로우만 감싸므로 OIT Resolve/히트맵 변환 쿼드/포화 마킹은 포함되지 않습니다.
+    const bool counted = m_countThisPass;
+    if (counted) {
+        if (m_queriesUsed >= int(m_passedQueries.size())) {
+            m_passedQueries.push_back(0);
+            glGenQueries(1, &m_passedQueries.back());
+            if (m_hasPipelineStats) {
+                m_shadedQueries.push_back(0);
+                glGenQueries(1, &m_shadedQueries.back());
+            }
+        }
+        glBeginQuery(GL_SAMPLES_PASSED, m_passedQueries[m_queriesUsed]);
+        if (m_hasPipelineStats) glBeginQuery(GL_FRAGMENT_SHADER_INVOCATIONS_ARB, m_shadedQueries[m_queriesUsed]);
+    }
+
+    // 인스턴싱 드로우 콜
+    // 사각형(정점 4개)을 count 만큼 반복해서 그림
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, count);
+
+    if (counted) {
+        if (m_hasPipelineStats) glEndQuery(GL_FRAGMENT_SHADER_INVOCATIONS_ARB);
+        glEndQuery(GL_SAMPLES_PASSED);
+        ++m_queriesUsed;
+    }
+
+    if (first > 0) {
+        glVertexAttribIPointer(1, 1, GL_UNSIGNED_INT, sizeof(quint32), nullptr);
+        m_orderVbo.release();
+    }
 }
 
-// [추가] 마우스 이벤트 구현
-void SplattingWidget::mousePressEvent(QMouseEvent *event)
+void SplattingWidget::collectFragmentQueries()
 {
-    m_camera.handleMousePress(event);
-    m_needsSort = true;
-    update(); // 화면 갱신 요청
+    if (!m_queryPending) return;
+
+    // 쿼리는 순서대로 끝나므로 마지막 SAMPLES_PASSED가 준비되면 모두 준비됨
+    GLuint available = 0;
+    glGetQueryObjectuiv(m_passedQueries[m_queriesUsed - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) return;
+
+    m_fragmentStats = sumFragmentQueries();
+    m_queryPending = false;
 }
 
-void SplattingWidget::mouseMoveEvent(QMouseEvent *event)
+FragmentStats SplattingWidget::sumFragmentQueries()
 {
-    m_camera.handleMouseMove(event);
-    m_needsSort = true;
-    update(); // 화면 갱신 요청
+    FragmentStats stats;
+    stats.valid = m_queriesUsed > 0;
+    stats.hasShaded = m_hasPipelineStats;
+    for (int i = 0; i < m_queriesUsed; ++i) {
+        GLuint passed = 0;
+        glGetQueryObjectuiv(m_passedQueries[i], GL_QUERY_RESULT, &passed);
+        stats.passed += passed;
+        if (m_hasPipelineStats) {
+            GLuint shaded = 0;
+            glGetQueryObjectuiv(m_shadedQueries[i], GL_QUERY_RESULT, &shaded);
+            stats.shaded += shaded;
+        }
+    }
+    return stats;
 }
 
-void SplattingWidget::wheelEvent(QWheelEvent *event)
+QMatrix4x4 SplattingWidget::projectionMatrix(bool jittered) const
 {
-    m_camera.handleWheel(event);
-    m_needsSort = true;
-    update(); // 화면 갱신 요청
+    QMatrix4x4 proj = m_camera.getProjectionMatrix((float)INTERNAL_WIDTH / INTERNAL_HEIGHT);
+    if (!jittered || !m_useTemporal) return proj;
+
+    // 클립 공간에서 지터만큼 평행 이동 (NDC 1 = 픽셀 절반 x 해상도)
+    QMatrix4x4 jitter;
+    jitter.translate(2.0f * m_jitter.x() / INTERNAL_WIDTH, 2.0f * m_jitter.y() / INTERNAL_HEIGHT, 0.0f);
+    return jitter * proj;
 }
 
-void SplattingWidget::paintGL()
+void SplattingWidget::setSplatUniforms(QOpenGLShaderProgram *program, const QMatrix4x4& view, float aspect)
 {
-    // 1. FPS 계산
-    m_frameCount++;
-    if (m_fpsTimer.elapsed() >= 1000) {
-        m_currentFps = m_frameCount / (m_fpsTimer.elapsed() / 1000.0f);
-        m_frameCount = 0;
-        m_fpsTimer.restart();
+    // [핵심] 카메라 행렬 계산 (Projection * View)
+    // 다중 뷰 타일은 타일 비율의 (지터 없는) 투영
+    QMatrix4x4 proj = aspect > 0.0f ? m_camera.getProjectionMatrix(aspect) : projectionMatrix(true);
+    QMatrix4x4 vp = proj * view; // View-Projection Matrix
+
+    program->setUniformValue("vp_matrix", vp); // 이름 변경 mvp -> vp
+
+    // 카메라의 Right, Up 벡터를 추출하여 셰이더로 보냄 (빌보딩용)
+    // View Matrix의 1열(Right), 2열(Up)을 가져옴 (Qt는 Column-Major)
+    QVector3D cameraRight(view(0, 0), view(1, 0), view(2, 0));
+    QVector3D cameraUp(view(0, 1), view(1, 1), view(2, 1));
+
+    program->setUniformValue("cameraRight", cameraRight);
+    program->setUniformValue("cameraUp", cameraUp);
+    // 깊이 코어 변형용 시선 방향: 뷰 행렬의 3행이 카메라 뒤쪽(+z) 월드 축
+    program->setUniformValue("uCameraForward", -QVector3D(view(2, 0), view(2, 1), view(2, 2)));
+
+    // UI 제어 변수 전달 (셰이더에 uniform 추가 필요!)
+    program->setUniformValue("uGlobalScale", m_globalScale);
+    program->setUniformValue("uAlphaCutoff", m_alphaCutoff);
+
+    // 씬별 모델 행렬과 스케일
+    QMatrix4x4 models[MAX_SCENES];
+    GLfloat modelScales[MAX_SCENES];
+    for (int i = 0; i < MAX_SCENES; ++i) {
+        modelScales[i] = 1.0f;
+        if (i < sceneCount()) {
+            models[i] = m_scenes[i]->modelMatrix();
+            modelScales[i] = m_scenes[i]->transform().scale;
+        }
+    }
+    program->setUniformValueArray("uModel", models, MAX_SCENES);
+    program->setUniformValueArray("uModelScale", modelScales, MAX_SCENES, 1);
+
+    // SH 평가용: 씬 로컬 좌표의 카메라 위치와 코드북 시작 위치
+    // (SH는 학습된 좌표계 기준이므로 씬을 회전해도 로컬 공간에서 방향을 계산)
+    const QVector3D cameraWorld = view.inverted().column(3).toVector3D();
+    QVector3D cameraLocal[MAX_SCENES];
+    for (int i = 0; i < sceneCount(); ++i) {
+        cameraLocal[i] = m_scenes[i]->modelMatrix().inverted().map(cameraWorld);
     }
+    program->setUniformValueArray("uCameraLocal", cameraLocal, MAX_SCENES);
+    program->setUniformValueArray("uShBase", m_shBase, MAX_SCENES);
 
-    if (!m_fbo || !m_fbo->isValid()) return;
+    bindSceneTextures();
+}
 
-    // 1. 카메라 행렬 가져오기
-    QMatrix4x4 view = m_camera.getViewMatrix();
+void SplattingWidget::renderSortedSplats(const QMatrix4x4& view, QOpenGLFramebufferObject *target)
+{
+    if (!target) target = m_fbo;
 
-    // 2. [최적화] 정렬은 "필요할 때(마우스 움직임)"만 수행
-    if (m_needsSort) {
-        sortSplats(view);
+    // --- [Step 1: Off-screen Rendering] ---
+    target->bind(); // FBO에 그리기 시작
 
-        // 정렬된 데이터 재전송
-        if (m_splatCount > 0) {
-            m_instanceVbo.bind();
-            m_instanceVbo.write(0, m_splats.data(), m_splatCount * sizeof(RenderSplat));
-            m_instanceVbo.release();
-        }
-        m_needsSort = false; // 정렬 완료
-    }
+    // 시간적 업스케일 중에는 재투영용 깊이도 같이 누적
+    const bool writeDepth = m_useTemporal && target == m_fbo;
+    const GLenum drawBuffers[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+    glDrawBuffers(writeDepth ? 2 : 1, drawBuffers);
 
-    // --- [Step 1: Off-screen Rendering] ---
-    m_fbo->bind(); // FBO에 그리기 시작
-    
-    // 뷰포트를 FBO 크기(720p)로 설정
-    glViewport(0, 0, INTERNAL_WIDTH, INTERNAL_HEIGHT);
+    // 뷰포트를 FBO 크기(기본 720p)로 설정
+    glViewport(0, 0, target->width(), target->height());
     
     // 배경 지우기 (어두운 회색)
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+    // 불투명 코어의 깊이를 먼저 채움 (출력 해상도 기준 이미지 등 다른 타겟에는 쓰지 않음)
+    const bool prepass = m_depthPrepass && target == m_fbo;
+    if (prepass) renderDepthPrepass(view);
+
     // 블렌딩 설정
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); // 일반적인 투명도 합성
@@ -231,25 +2486,10 @@ void SplattingWidget::paintGL()
     glDepthMask(GL_FALSE);
 
     // 빨간 삼각형 그리기
-    if (m_program->bind()) {
-        // [핵심] 카메라 행렬 계산 (Projection * View)
-        QMatrix4x4 view = m_camera.getViewMatrix();
-        QMatrix4x4 proj = m_camera.getProjectionMatrix((float)INTERNAL_WIDTH / INTERNAL_HEIGHT);
-        QMatrix4x4 vp = proj * view; // View-Projection Matrix
-
-        m_program->setUniformValue("vp_matrix", vp); // 이름 변경 mvp -> vp
-
-        // 카메라의 Right, Up 벡터를 추출하여 셰이더로 보냄 (빌보딩용)
-        // View Matrix의 1열(Right), 2열(Up)을 가져옴 (Qt는 Column-Major)
-        QVector3D cameraRight(view(0, 0), view(1, 0), view(2, 0));
-        QVector3D cameraUp(view(0, 1), view(1, 1), view(2, 1));
-
-        m_program->setUniformValue("cameraRight", cameraRight);
-        m_program->setUniformValue("cameraUp", cameraUp);
-
-        // UI 제어 변수 전달 (셰이더에 uniform 추가 필요!)
-        m_program->setUniformValue("uGlobalScale", m_globalScale);
-        m_program->setUniformValue("uAlphaCutoff", m_alphaCutoff);
+    QOpenGLShaderProgram *program = splatProgram(SplatProgram_Blend,
+                                                 writeDepth ? SplatShaders::Feature_DepthOutput : 0);
+    if (program && program->bind()) {
+        setSplatUniforms(program, view);
 
         m_vao.bind();
 #if 0
@@ -257,51 +2497,347 @@ void SplattingWidget::paintGL()
 #else
         // [수정] 점 그리기
         // 데이터가 없으면(0개) 그리지 않음
-        if (m_splatCount > 0) {
-            // 인스턴싱 드로우 콜
-            // 사각형(정점 4개)을 m_splatCount 만큼 반복해서 그림
-            glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, m_splatCount);
-        }
+        drawSplatInstances();
 #endif
         m_vao.release();
-        m_program->release();
+        program->release();
     }
 
     // 상태 복구 (다음 프레임을 위해)
+    if (prepass) {
+        glDisable(GL_DEPTH_TEST);
+        glDepthFunc(GL_LESS);
+    }
     glDepthMask(GL_TRUE);
     glDisable(GL_BLEND);
+    glDrawBuffers(1, drawBuffers);
 
-    m_fbo->release(); // FBO 그리기 종료 (다시 기본 프레임버퍼로 돌아옴)
+    target->release(); // FBO 그리기 종료 (다시 기본 프레임버퍼로 돌아옴)
+}
 
+void SplattingWidget::renderFrontToBackSplats(const QMatrix4x4& view)
+{
+    // 그리기 목록이 앞 -> 뒤 순서일 때 Under 연산자로 합성
+    //   C += (1 - A) * a * c,  A += (1 - A) * a   (셰이더는 premultiplied 색을 출력)
+    // 배경(검정) 위에 그린 결과는 Back-to-Front Over 합성과 같습니다.
+    //
+    // 조기 종료: 목록을 점점 커지는 구간으로 나눠 그리고, 구간 사이에 누적 알파가 포화된 픽셀의
+    // 스텐실을 1로 표시합니다. 이후 구간의 프래그먼트는 셰이더 실행 전에 스텐실 테스트에서 버려집니다.
+    // (앞쪽 스플랫이 대부분을 덮으므로 첫 구간은 작게 시작)
+    m_fbo->bind();
+    const GLenum drawBuffers[1] = { GL_COLOR_ATTACHMENT0 };
+    glDrawBuffers(1, drawBuffers);
+    glViewport(0, 0, INTERNAL_WIDTH, INTERNAL_HEIGHT);
 
-    if(m_useFSR)
-    {
-        // 2. On-screen Rendering (화면 늘리기 + FSR 적용)
-        QSize windowSize = this->size(); // 현재 윈도우 크기 (예: 4K)
-        glViewport(0, 0, windowSize.width(), windowSize.height());
-        glClear(GL_COLOR_BUFFER_BIT);
+    // 누적 알파가 0에서 시작해야 함
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClearStencil(0);
+    glStencilMask(0xFF);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+    if (m_depthPrepass) renderDepthPrepass(view);
+
+    // 스플랫 드로우는 스텐실을 읽기만 함 (쓰지 않아야 early stencil이 유지됨)
+    QOpenGLShaderProgram *program = splatProgram(SplatProgram_Blend, SplatShaders::Feature_Premultiply);
+    auto beginSplats = [&]() {
+        m_fbo->bind();
+        glViewport(0, 0, INTERNAL_WIDTH, INTERNAL_HEIGHT);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_ONE_MINUS_DST_ALPHA, GL_ONE);
+        glDepthMask(GL_FALSE);
+        if (m_depthPrepass) glEnable(GL_DEPTH_TEST); // 마킹 패스에서 껐던 깊이 테스트 (GL_LEQUAL 유지)
+        glEnable(GL_STENCIL_TEST);
+        glStencilFunc(GL_EQUAL, 0, 0xFF);
+        glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+        glStencilMask(0x00);
+        program->bind();
+        m_vao.bind();
+    };
+
+    m_saturationMarks = 0;
+    if (program && program->bind()) {
+        setSplatUniforms(program, view);
+        beginSplats();
+
+        // 마킹 FBO를 못 만들었으면 한 번에 그림 (Under 합성만, 조기 종료 없음)
+        int first = 0;
+        int chunk = m_saturationFbo ? std::max(m_splatCount / 64, 4096) : m_splatCount;
+        while (first < m_splatCount) {
+            const int count = std::min(chunk, m_splatCount - first);
+            drawSplatInstances(first, count);
+            first += count;
+            chunk *= 2;
+
+            if (first < m_splatCount) {
+                m_vao.release();
+                markSaturatedPixels();
+                beginSplats();
+            }
+        }
+        m_vao.release();
+        program->release();
+    }
+
+    glDisable(GL_STENCIL_TEST);
+    glStencilMask(0xFF);
+    glDisable(GL_DEPTH_TEST);
+    glDepthFunc(GL_LESS);
+    glDepthMask(GL_TRUE);
+    glDisable(GL_BLEND);
+
+    // 출력 알파는 다른 모드처럼 불투명으로 (색만 쓰인 상태, 배경은 검정)
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_TRUE);
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+
+    m_fbo->release();
+}
+
+void SplattingWidget::markSaturatedPixels()
+{
+    // 색 타겟이 없는 FBO에서 m_fbo의 알파를 읽고, 통과한 픽셀의 스텐실만 1로 바꿈
+    glBindFramebuffer(GL_FRAMEBUFFER, m_saturationFbo);
+    glViewport(0, 0, INTERNAL_WIDTH, INTERNAL_HEIGHT);
+    glDisable(GL_BLEND);
+    glDisable(GL_DEPTH_TEST); // 깊이 프리패스의 깊이를 공유하므로 전체 화면 쿼드가 가려지지 않도록
+    glEnable(GL_STENCIL_TEST);
+    glStencilFunc(GL_NOTEQUAL, 1, 0xFF); // 이미 표시된 픽셀은 건너뜀
+    glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
+    glStencilMask(0xFF);
+
+    // 씬 TBO(유닛 0~7)와 SH 코드북(8) 바인딩은 건드리지 않도록 다음 유닛 사용
+    const int unit = SH_CODEBOOK_UNIT + 1;
+    m_saturationShader->bind();
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_2D, m_fbo->texture());
+    m_saturationShader->setUniformValue("colorTexture", unit);
+    m_saturationShader->setUniformValue("uThreshold", SATURATION_ALPHA);
+
+    renderFSRQuad();
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glActiveTexture(GL_TEXTURE0);
+    m_saturationShader->release();
+    ++m_saturationMarks;
+}
+
+void SplattingWidget::initFrontToBack()
+{
+    // m_fbo의 Depth/Stencil 렌더버퍼를 찾아 색 없는 FBO에 그대로 붙임
+    m_fbo->bind();
+    GLint objectType = GL_NONE;
+    GLint stencilBuffer = 0;
+    glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_STENCIL_ATTACHMENT,
+                                          GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE, &objectType);
+    glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_STENCIL_ATTACHMENT,
+                                          GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME, &stencilBuffer);
+    m_fbo->release();
+    if (objectType != GL_RENDERBUFFER || stencilBuffer == 0) {
+        qWarning() << "FBO has no stencil renderbuffer - front-to-back mode runs without early termination";
+        return;
+    }
+
+    glGenFramebuffers(1, &m_saturationFbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_saturationFbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, GLuint(stencilBuffer));
+    const GLenum none = GL_NONE;
+    glDrawBuffers(1, &none);
+    glReadBuffer(GL_NONE);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        qWarning() << "Saturation FBO incomplete - front-to-back mode runs without early termination";
+        glDeleteFramebuffers(1, &m_saturationFbo);
+        m_saturationFbo = 0;
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, context()->defaultFramebufferObject());
+}
+
+void SplattingWidget::renderOitSplats(const QMatrix4x4& view)
+{
+    if (!m_oitFbo || !m_oitFbo->isValid()) return;
+
+    // --- [OIT 1: Accumulation] ---
+    // 정렬 없이 모든 스플랫을 가산 블렌딩으로 누적합니다.
+    m_oitFbo->bind();
+    const GLenum drawBuffers[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+    glDrawBuffers(2, drawBuffers);
+    glViewport(0, 0, INTERNAL_WIDTH, INTERNAL_HEIGHT);
+
+    // Accumulation은 0, log(Revealage)도 0 (= Revealage 1, 아무것도 안 가림)
+    const GLfloat zero[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    glClearBufferfv(GL_COLOR, 0, zero);
+    glClearBufferfv(GL_COLOR, 1, zero);
+
+    // 두 타겟 모두 ONE, ONE 가산 블렌딩
+    // Revealage는 곱(Π(1-a)) 대신 log 합으로 누적하므로 GL 3.3의 단일 블렌드 함수로 충분합니다.
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE);
+    glDepthMask(GL_FALSE);
+
+    QOpenGLShaderProgram *program = splatProgram(SplatProgram_Oit);
+    if (program && program->bind()) {
+        setSplatUniforms(program, view);
+
+        m_vao.bind();
+        drawSplatInstances();
+        m_vao.release();
+        program->release();
+    }
+
+    glDepthMask(GL_TRUE);
+    glDisable(GL_BLEND);
+    m_oitFbo->release();
+
+    // --- [OIT 2: Resolve] ---
+    // 누적 결과를 일반 m_fbo(720p)로 합성 -> 이후 FSR/Blit 단계는 정렬 모드와 동일
+    m_fbo->bind();
+    glViewport(0, 0, INTERNAL_WIDTH, INTERNAL_HEIGHT);
+
+    m_oitResolveShader->bind();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, m_oitAccumTexture);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, m_oitRevealTexture);
+    m_oitResolveShader->setUniformValue("accumTexture", 0);
+    m_oitResolveShader->setUniformValue("revealTexture", 1);
+
+    renderFSRQuad(); // 전체 화면 쿼드 재사용
+
+    glActiveTexture(GL_TEXTURE0);
+    m_oitResolveShader->release();
+    m_fbo->release();
+}
+
+void SplattingWidget::initOIT()
+{
+    // 누적 값이 1을 넘으므로 부동소수점 타겟이 필요합니다.
+    m_oitFbo = new QOpenGLFramebufferObject(INTERNAL_WIDTH, INTERNAL_HEIGHT,
+                                            QOpenGLFramebufferObject::NoAttachment,
+                                            GL_TEXTURE_2D, GL_RGBA16F);
+    m_oitFbo->addColorAttachment(INTERNAL_WIDTH, INTERNAL_HEIGHT, GL_R16F);
+    const QList<GLuint> textures = m_oitFbo->textures();
+    m_oitAccumTexture = textures.value(0);
+    m_oitRevealTexture = textures.value(1);
+
+    if (!m_oitFbo->isValid()) {
+        qCritical() << "OIT FBO Creation Failed!";
+    }
+}
+
+void SplattingWidget::renderOverdrawHeatmap(const QMatrix4x4& view)
+{
+    if (!m_overdrawFbo || !m_overdrawFbo->isValid()) return;
+
+    // --- [Heatmap 1: Count] ---
+    // 사각형이 덮은 모든 프래그먼트를 1씩 가산 (R), 그중 discard를 통과했을 것만 따로 (G)
+    m_overdrawFbo->bind();
+    glViewport(0, 0, INTERNAL_WIDTH, INTERNAL_HEIGHT);
+    const GLfloat zero[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    glClearBufferfv(GL_COLOR, 0, zero);
 
-        m_fsrShader->bind();
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE);
+    glDepthMask(GL_FALSE);
+
+    QOpenGLShaderProgram *program = splatProgram(SplatProgram_Overdraw);
+    if (program && program->bind()) {
+        setSplatUniforms(program, view);
+
+        m_vao.bind();
+        drawSplatInstances();
+        m_vao.release();
+        program->release();
+    }
+
+    glDepthMask(GL_TRUE);
+    glDisable(GL_BLEND);
+
+    // 픽셀 통계: 카운트 타겟을 읽어 합산 (디버그 모드 전용, 프레임당 7MB 읽기)
+    // 쿼리 확장이 없는 드라이버에서도 래스터화/discard 수를 정확히 얻을 수 있습니다.
+    const size_t pixelCount = size_t(INTERNAL_WIDTH) * INTERNAL_HEIGHT;
+    m_overdrawReadback.resize(pixelCount * 2);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glReadPixels(0, 0, INTERNAL_WIDTH, INTERNAL_HEIGHT, GL_RG, GL_FLOAT, m_overdrawReadback.data());
+    m_overdrawFbo->release();
+
+    // 작업자별 부분합은 멤버에 두고 작업자 수가 바뀔 때만 크기를 바꿈 (히트맵 모드에서도 프레임 중 할당 없음)
+    const int parts = parallelWorkerCount();
+    if (m_overdrawPartials.size() != size_t(parts)) m_overdrawPartials.resize(size_t(parts));
+    std::fill(m_overdrawPartials.begin(), m_overdrawPartials.end(), OverdrawPartial());
+    parallelFor(0, parts, [&](int p) {
+        const size_t begin = pixelCount * p / parts, end = pixelCount * (p + 1) / parts;
+        OverdrawPartial &sum = m_overdrawPartials[p];
+        for (size_t i = begin; i < end; ++i) {
+            const float rasterized = m_overdrawReadback[i * 2];
+            sum.rasterized += rasterized;
+            sum.kept += m_overdrawReadback[i * 2 + 1];
+            if (rasterized > 0.0f) ++sum.covered;
+            sum.peak = std::max(sum.peak, rasterized);
+        }
+    });
+
+    OverdrawPartial total;
+    for (const OverdrawPartial &sum : m_overdrawPartials) {
+        total.rasterized += sum.rasterized;
+        total.kept += sum.kept;
+        total.covered += sum.covered;
+        total.peak = std::max(total.peak, sum.peak);
+    }
+    m_overdrawCounts.valid = true;
+    m_overdrawCounts.hasShaded = true;
+    m_overdrawCounts.shaded = quint64(total.rasterized);
+    m_overdrawCounts.passed = quint64(total.kept);
+    m_overdrawMean = total.rasterized / pixelCount;
+    m_overdrawCoveredMean = total.covered > 0 ? total.rasterized / total.covered : 0.0;
+    m_overdrawPeak = total.peak;
+
+    // --- [Heatmap 2: Colorize] ---
+    // 카운트를 색으로 바꿔 m_fbo에 씀 -> 이후 FSR/Blit 단계는 다른 모드와 동일
+    m_fbo->bind();
+    glViewport(0, 0, INTERNAL_WIDTH, INTERNAL_HEIGHT);
 
-        // 보통 Post-processing 단계에서는 덮어쓰기(Replace)가 정석이므로
-        // 블렌딩을 끄는 것이 깔끔할 수 있습니다.
-        glDisable(GL_BLEND);
+    m_heatmapShader->bind();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, m_overdrawFbo->texture());
+    m_heatmapShader->setUniformValue("countTexture", 0);
+    m_heatmapShader->setUniformValue("uMaxCount", float(m_heatmapMax));
 
-        // 만약 배경 투명도를 살려야 한다면 아래 코드 사용:
-        // glEnable(GL_BLEND);
-        // glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    renderFSRQuad();
 
-        // FBO 텍스처를 0번 슬롯에 바인딩
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, m_fbo->texture());
+    m_heatmapShader->release();
+    m_fbo->release();
+}
 
-        // Uniform 값 전달
-        m_fsrShader->setUniformValue("screenTexture", 0);
-        m_fsrShader->setUniformValue("sharpness", m_sharpness); // 0.0 ~ 1.0 값 조절
+void SplattingWidget::initOverdraw()
+{
+    // 겹침 수가 수백을 넘을 수 있으므로 정수 정밀도가 유지되는 32비트 float 타겟
+    m_overdrawFbo = new QOpenGLFramebufferObject(INTERNAL_WIDTH, INTERNAL_HEIGHT,
+                                                 QOpenGLFramebufferObject::NoAttachment,
+                                                 GL_TEXTURE_2D, GL_RG32F);
+    if (!m_overdrawFbo->isValid()) {
+        qCritical() << "Overdraw FBO Creation Failed!";
+    }
 
-        renderFSRQuad();
+    // 프래그먼트 쿼리: SAMPLES_PASSED는 3.3 코어, 셰이더 실행 수는 확장이 있을 때만 (쿼리 객체는 쓸 때 생성)
+    m_hasPipelineStats = context()->hasExtension(QByteArrayLiteral("GL_ARB_pipeline_statistics_query"));
+    qDebug() << "Fragment shader invocation query:" << (m_hasPipelineStats ? "available" : "not available");
+}
 
-        m_fsrShader->release();
+void SplattingWidget::renderPostPass()
+{
+    if (m_useTemporal && m_historyValid)
+    {
+        // 히스토리는 이미 출력 해상도이므로 그대로 복사
+        QOpenGLFramebufferObject *history = m_history[m_historyIndex];
+        QOpenGLFramebufferObject::blitFramebuffer(
+            nullptr, QRect(0, 0, width(), height()),
+            history, QRect(0, 0, history->width(), history->height()),
+            GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    }
+    else if(m_useFSR)
+    {
+        // 2. On-screen Rendering (화면 늘리기 + FSR 적용)
+        QSize windowSize = this->size(); // 현재 윈도우 크기 (예: 4K)
+        renderRcas(m_fbo->texture(), windowSize.width(), windowSize.height());
     }
     else
     {
@@ -320,86 +2856,120 @@ void SplattingWidget::paintGL()
             m_useLinearFilter ? GL_LINEAR : GL_NEAREST           // 필터링: GL_LINEAR(부드럽게), GL_NEAREST(픽셀화)
             );
     }
-
-    // 5. QPainter로 FPS 텍스트 오버레이
-    // OpenGL 렌더링 후 QPainter를 쓰면 위에 덧그려짐
-    QPainter painter(this);
-    painter.setPen(Qt::yellow);
-    painter.setFont(QFont("Arial", 14, QFont::Bold));
-    painter.drawText(20, 30, QString("FPS: %1").arg(QString::number(m_currentFps, 'f', 1)));
-    painter.drawText(20, 50, QString("Points: %1").arg(m_splatCount));
-    painter.end();
 }
 
-void SplattingWidget::initShaders()
+void SplattingWidget::renderRcas(GLuint texture, int width, int height)
 {
-    m_program = new QOpenGLShaderProgram();
+    glViewport(0, 0, width, height);
+    glClear(GL_COLOR_BUFFER_BIT);
 
-    // Vertex Shader
-    const char *vshader = R"(
-        #version 330 core
-        layout(location = 0) in vec2 aQuadPos;
-        layout(location = 1) in vec3 aInstPos;
-        layout(location = 2) in vec3 aInstColor;
-        layout(location = 3) in float aInstOpacity;
-        layout(location = 4) in vec3 aInstScale;
+    m_fsrShader->bind();
 
-        uniform mat4 vp_matrix;
-        uniform vec3 cameraRight;
-        uniform vec3 cameraUp;
-        uniform float uGlobalScale;
+    // 보통 Post-processing 단계에서는 덮어쓰기(Replace)가 정석이므로
+    // 블렌딩을 끄는 것이 깔끔할 수 있습니다.
+    glDisable(GL_BLEND);
 
-        out vec3 vColor;
-        out vec2 vQuadPos;
-        out float vOpacity;
+    // 만약 배경 투명도를 살려야 한다면 아래 코드 사용:
+    // glEnable(GL_BLEND);
+    // glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-        void main() {
-            // UI에서 받은 스케일 적용
-            float scaleFactor = uGlobalScale;
+    // FBO 텍스처를 0번 슬롯에 바인딩
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texture);
 
-            vec3 worldPos = aInstPos
-                          + (cameraRight * aQuadPos.x * aInstScale.x * scaleFactor)
-                          + (cameraUp * aQuadPos.y * aInstScale.y * scaleFactor);
+    // Uniform 값 전달
+    m_fsrShader->setUniformValue("screenTexture", 0);
+    m_fsrShader->setUniformValue("sharpness", m_sharpness); // 0.0 ~ 1.0 값 조절
 
-            gl_Position = vp_matrix * vec4(worldPos, 1.0);
-            vColor = aInstColor;
-            vQuadPos = aQuadPos;
-            vOpacity = aInstOpacity;
-        }
-    )";
+    renderFSRQuad();
 
-    // Fragment Shader (가우시안 효과의 핵심)
-    const char *fshader = R"(
-        #version 330 core
-        in vec3 vColor;
-        in vec2 vQuadPos;
-        in float vOpacity;
+    m_fsrShader->release();
+}
 
-        uniform float uAlphaCutoff;
+void SplattingWidget::resetTemporal()
+{
+    m_historyValid = false;
+    m_temporalFrame = 0;
+    m_jitterIndex = 0;
+    m_jitter = QVector2D(0.0f, 0.0f);
+}
 
-        out vec4 FragColor;
+void SplattingWidget::ensureHistory(int width, int height)
+{
+    if (m_history[0] && m_history[0]->width() == width && m_history[0]->height() == height) return;
+
+    for (QOpenGLFramebufferObject *&history : m_history) {
+        delete history;
+        QOpenGLFramebufferObjectFormat format;
+        format.setInternalTextureFormat(GL_RGBA16F);
+        history = new QOpenGLFramebufferObject(width, height, format);
+
+        // 재투영한 좌표는 픽셀 중심에 오지 않으므로 선형 필터로 읽음
+        glBindTexture(GL_TEXTURE_2D, history->texture());
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+    m_historyValid = false;
+    m_temporalFrame = 0;
+}
 
-        void main() {
-            // 중심에서의 거리 제곱 (x^2 + y^2)
-            float distSq = dot(vQuadPos, vQuadPos);
+void SplattingWidget::resolveTemporal(const QMatrix4x4& view)
+{
+    ensureHistory(width(), height());
 
-            // 1. 원형 클리핑: 반지름 1을 넘으면 그리지 않고 버림 (사각형을 원으로 만듦)
-            if (distSq > 1.0) discard;
+    QOpenGLFramebufferObject *previous = m_history[m_historyIndex];
+    QOpenGLFramebufferObject *next = m_history[1 - m_historyIndex];
 
-            // 2. 가우시안 감쇠 (Gaussian Falloff)
-            // 중심(0)일 때 1, 가장자리(1)로 갈수록 0에 가깝게 줄어듦
-            // exp(-x) 그래프 형태를 사용
-            float alpha = vOpacity * exp(-distSq * 3.0);
+    const QMatrix4x4 proj = projectionMatrix(false);
 
-            // UI에서 받은 컷오프 적용
-            if (alpha < uAlphaCutoff) discard;
+    next->bind();
+    glViewport(0, 0, next->width(), next->height());
+    glDisable(GL_BLEND);
 
-            FragColor = vec4(vColor, alpha);
-        }
-    )";
+    m_temporalShader->bind();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, m_fbo->texture());
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, m_fboAuxTexture);
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, previous->texture());
+    glActiveTexture(GL_TEXTURE0);
+
+    m_temporalShader->setUniformValue("uCurrent", 0);
+    m_temporalShader->setUniformValue("uDepth", 1);
+    m_temporalShader->setUniformValue("uHistory", 2);
+    m_temporalShader->setUniformValue("uJitter", m_jitter);
+    m_temporalShader->setUniformValue("uCurrToPrev", m_prevViewProj * view.inverted());
+    m_temporalShader->setUniformValue("uProjScale", QVector2D(proj(0, 0), proj(1, 1)));
+    m_temporalShader->setUniformValue("uFallbackDepth", m_camera.state().distance);
+    m_temporalShader->setUniformValue("uHasDepth", GLint(m_renderMode == RenderMode::Sorted));
+    m_temporalShader->setUniformValue("uHistoryValid", GLint(m_historyValid));
+    // 카메라가 바뀐 직후에는 새 샘플 1/8 (재투영한 히스토리 위주),
+    // 멈춘 뒤에는 누적 샘플 수의 역수로 섞어 지터 한 주기의 평균으로 수렴
+    const float blend = m_temporalFrame == 0 ? 0.125f
+                                              : std::max(1.0f / (m_temporalFrame + 1), 1.0f / TEMPORAL_SAMPLES);
+    m_temporalShader->setUniformValue("uBlend", blend);
+
+    renderFSRQuad();
+    m_temporalShader->release();
+    next->release();
+
+    m_historyIndex = 1 - m_historyIndex;
+    m_historyValid = true;
+    m_prevViewProj = proj * view;
+    ++m_temporalFrame;
+}
+
+void SplattingWidget::initShaders()
+{
+    // 링크된 바이너리를 디스크에 캐시 -> 두 번째 실행부터는 컴파일 없이 올림
+    m_shaderCache.initialize(ShaderCache::defaultCacheDir());
 
     const char *fsrvshader = R"(
-        #version 450 core
+        #version 330 core
 
         layout(location = 0) in vec2 aPos;      // Attribute 0: 위치
         layout(location = 1) in vec2 aTexCoord; // Attribute 1: UV
@@ -415,7 +2985,7 @@ void SplattingWidget::initShaders()
     )";
 
     const char *fsrfshader = R"(
-        #version 450 core
+        #version 330 core
 
         in vec2 vTexCoord;
         out vec4 outColor;
@@ -491,14 +3061,186 @@ void SplattingWidget::initShaders()
         }
     )";
 
-    m_program->addShaderFromSourceCode(QOpenGLShader::Vertex, vshader);
-    m_program->addShaderFromSourceCode(QOpenGLShader::Fragment, fshader);
-    m_program->link();
+    m_fsrShader = m_shaderCache.program(fsrvshader, fsrfshader);
+
+    // OIT Resolve: 가중 평균 색상을 (1 - Revealage)만큼 배경(검정) 위에 덮음
+    const char *oitresolvefshader = R"(
+        #version 330 core
+        out vec4 FragColor;
+
+        uniform sampler2D accumTexture;
+        uniform sampler2D revealTexture;
+
+        void main() {
+            ivec2 coord = ivec2(gl_FragCoord.xy);
+            vec4 accum = texelFetch(accumTexture, coord, 0);
+            float revealage = exp(texelFetch(revealTexture, coord, 0).r);
+
+            vec3 avgColor = accum.rgb / max(accum.a, 1e-5);
+            FragColor = vec4(avgColor * (1.0 - revealage), 1.0);
+        }
+    )";
+
+    m_oitResolveShader = m_shaderCache.program(fsrvshader, oitresolvefshader);
+
+    // 시간적 업스케일 누적 (출력 해상도에서 실행)
+    // 새 샘플: 지터된 720p 이미지에서 이 출력 픽셀에 가장 가까운 texel (중심 거리로 신뢰도 가중)
+    // 히스토리: 평균 깊이로 복원한 위치를 이전 뷰-투영에 재투영해 읽고, 새 샘플 3x3 이웃의 색 범위로 클램프
+    const char *temporalfshader = R"(
+        #version 330 core
+        in vec2 vTexCoord;
+        out vec4 outColor;
+
+        uniform sampler2D uCurrent;   // 지터된 새 샘플 (내부 해상도)
+        uniform sampler2D uDepth;     // (깊이 x 가중치, 커버리지)
+        uniform sampler2D uHistory;   // 이전 결과 (출력 해상도)
+        uniform vec2 uJitter;         // 내부 해상도 픽셀 단위
+        uniform mat4 uCurrToPrev;     // 이전 (지터 없는) 뷰-투영 * 현재 뷰의 역행렬
+        uniform vec2 uProjScale;      // 투영 행렬의 [0][0], [1][1]
+        uniform float uFallbackDepth; // 깊이가 없는 픽셀(배경, OIT 모드)에 쓸 거리
+        uniform bool uHasDepth;
+        uniform bool uHistoryValid;
+        uniform float uBlend;         // 새 샘플 비율 (누적 샘플 수의 역수, 하한 있음)
+
+        void main() {
+            vec2 curSize = vec2(textureSize(uCurrent, 0));
+            ivec2 maxCoord = ivec2(curSize) - 1;
+
+            // 지터로 화면 내용이 +uJitter 픽셀 밀려 그려졌으므로 같은 만큼 밀어서 읽음
+            vec2 curPos = vTexCoord * curSize + uJitter;
+            ivec2 c = clamp(ivec2(floor(curPos)), ivec2(0), maxCoord);
+            vec3 current = texelFetch(uCurrent, c, 0).rgb;
+
+            vec2 d = curPos - (vec2(c) + 0.5);
+            float sampleWeight = exp(-2.0 * dot(d, d));
+
+            vec3 nMin = current;
+            vec3 nMax = current;
+            for (int y = -1; y <= 1; ++y) {
+                for (int x = -1; x <= 1; ++x) {
+                    vec3 n = texelFetch(uCurrent, clamp(c + ivec2(x, y), ivec2(0), maxCoord), 0).rgb;
+                    nMin = min(nMin, n);
+                    nMax = max(nMax, n);
+                }
+            }
+
+            // 카메라 공간 위치 복원 -> 이전 프레임 화면 좌표
+            float depth = uFallbackDepth;
+            if (uHasDepth) {
+                vec2 dc = texelFetch(uDepth, c, 0).rg;
+                if (dc.g > 0.05) depth = dc.r / dc.g;
+            }
+            vec2 ndc = vTexCoord * 2.0 - 1.0;
+            vec4 viewPos = vec4(ndc.x * depth / uProjScale.x, ndc.y * depth / uProjScale.y, -depth, 1.0);
+            vec4 prevClip = uCurrToPrev * viewPos;
+            vec2 prevUv = prevClip.xy / prevClip.w * 0.5 + 0.5;
+
+            vec3 result = current;
+            bool onScreen = prevClip.w > 0.0 && all(greaterThanEqual(prevUv, vec2(0.0)))
+                            && all(lessThanEqual(prevUv, vec2(1.0)));
+            if (uHistoryValid && onScreen) {
+                vec3 history = clamp(texture(uHistory, prevUv).rgb, nMin, nMax);
+                result = mix(history, current, uBlend * sampleWeight);
+            }
+            outColor = vec4(result, 1.0);
+        }
+    )";
+
+    m_temporalShader = m_shaderCache.program(fsrvshader, temporalfshader);
+
+    // 카운트 -> 색: 로그 스케일 (검정 -> 파랑 -> 청록 -> 초록 -> 노랑 -> 빨강, uMaxCount 이상은 흰색)
+    // 사각형에는 덮였지만 모두 discard된 픽셀은 어두운 보라로 표시
+    const char *heatmapfshader = R"(
+        #version 330 core
+        out vec4 FragColor;
+
+        uniform sampler2D countTexture;
+        uniform float uMaxCount;
+
+        vec3 ramp(float t) {
+            const vec3 stops[6] = vec3[6](vec3(0.0, 0.0, 0.0), vec3(0.0, 0.0, 1.0), vec3(0.0, 1.0, 1.0),
+                                          vec3(0.0, 1.0, 0.0), vec3(1.0, 1.0, 0.0), vec3(1.0, 0.0, 0.0));
+            float x = clamp(t, 0.0, 1.0) * 5.0;
+            int i = min(int(x), 4);
+            return mix(stops[i], stops[i + 1], x - float(i));
+        }
+
+        void main() {
+            vec2 counts = texelFetch(countTexture, ivec2(gl_FragCoord.xy), 0).rg;
+            vec3 color;
+            if (counts.r > uMaxCount) {
+                color = vec3(1.0);
+            } else if (counts.r > 0.0 && counts.g == 0.0) {
+                color = vec3(0.25, 0.0, 0.3);
+            } else {
+                color = ramp(log2(1.0 + counts.r) / log2(1.0 + uMaxCount));
+            }
+            FragColor = vec4(color, 1.0);
+        }
+    )";
+
+    m_heatmapShader = m_shaderCache.program(fsrvshader, heatmapfshader);
+
+    // Front-to-Back 포화 마킹: 누적 알파가 임계값 미만이면 버리고, 남은 픽셀만 스텐실에 기록
+    const char *saturationfshader = R"(
+        #version 330 core
+        uniform sampler2D colorTexture;
+        uniform float uThreshold;
+
+        void main() {
+            if (texelFetch(colorTexture, ivec2(gl_FragCoord.xy), 0).a < uThreshold) discard;
+        }
+    )";
+
+    m_saturationShader = m_shaderCache.program(fsrvshader, saturationfshader);
+
+    // 현재 상태에서 바로 쓸 스플랫 변형은 미리 만들어 둠 (첫 프레임/모드 전환 때 멈춤 방지)
+    splatProgram(SplatProgram_Blend);
+    splatProgram(SplatProgram_Blend, SplatShaders::Feature_DepthOutput);
+    splatProgram(SplatProgram_Blend, SplatShaders::Feature_DepthCore);
+    splatProgram(SplatProgram_Oit);
+
+    qDebug() << "Shaders:" << m_shaderCache.statsString();
+}
+
+quint32 SplattingWidget::splatFeatures() const
+{
+    quint32 features = 0;
+    if (m_alphaCutoff > 0.0f) features |= SplatShaders::Feature_AlphaCutoff;
+    for (const auto &scene : m_scenes) {
+        if (scene->hasShPalette()) {
+            features |= SplatShaders::Feature_Sh;
+            break;
+        }
+    }
+    return features;
+}
+
+QOpenGLShaderProgram *SplattingWidget::splatProgram(SplatProgramKind kind, quint32 passFeatures)
+{
+    // 깊이 프리패스는 색을 쓰지 않으므로 SH/컷오프 변형이 필요 없음
+    const quint32 features = (passFeatures & SplatShaders::Feature_DepthCore) ? passFeatures
+                                                                               : splatFeatures() | passFeatures;
+    const quint32 key = (quint32(kind) << 8) | features;
+    if (QOpenGLShaderProgram *program = m_splatPrograms.value(key, nullptr)) return program;
+
+    const char *fragmentSource = kind == SplatProgram_Oit        ? OIT_FRAGMENT_SOURCE
+                                 : kind == SplatProgram_Overdraw ? OVERDRAW_FRAGMENT_SOURCE
+                                                                 : SplatShaders::splatFragmentSource();
+    QOpenGLShaderProgram *program = m_shaderCache.program(SplatShaders::splatVertexSource(), fragmentSource,
+                                                          SplatShaders::featureDefines(features));
+    if (!program) return nullptr;
+
+    // 씬 샘플러는 슬롯 번호와 같은 텍스처 유닛에 고정
+    program->bind();
+    for (int i = 0; i < MAX_SCENES; ++i) {
+        program->setUniformValue((QByteArray("uScene") + QByteArray::number(i)).constData(), i);
+    }
+    program->setUniformValue("uShCodebook", SH_CODEBOOK_UNIT);
+    program->release();
 
-    m_fsrShader = new QOpenGLShaderProgram;
-    m_fsrShader->addShaderFromSourceCode(QOpenGLShader::Vertex, fsrvshader);
-    m_fsrShader->addShaderFromSourceCode(QOpenGLShader::Fragment, fsrfshader);
-    m_fsrShader->link();
+    m_splatPrograms.insert(key, program);
+    return program;
 }
 
 #if 0
@@ -566,33 +3308,3 @@ void SplattingWidget::renderFSRQuad()
 
     m_fsrvao.release();
 }
-
-void SplattingWidget::sortSplats(const QMatrix4x4& viewMatrix)
-{
-    if (m_splats.empty()) return;
-
-    // View Matrix의 3행(Row 2)이 카메라의 Z축(Look Vector) 방향입니다.
-    // (Qt QMatrix4x4는 row(행), column(열) 접근 가능)
-    // 3D 공간의 점 P와 카메라 Z축 벡터의 내적(Dot Product)을 구하면 깊이가 나옵니다.
-
-    // 최적화를 위해 View Matrix의 Z축 벡터 요소를 미리 뺍니다.
-    // 주의: OpenGL에서는 카메라가 -Z를 바라보지만, 거리 계산엔 Z축 계수를 씁니다.
-    float viewZ_x = viewMatrix(0, 2);
-    float viewZ_y = viewMatrix(1, 2);
-    float viewZ_z = viewMatrix(2, 2);
-    float viewZ_w = viewMatrix(3, 2); // Translation 관련
-
-    // std::sort 사용 (Lambda 함수)
-    // "누가 더 뒤에 있니?" (Depth가 큰 순서대로 내림차순 정렬)
-    std::sort(m_splats.begin(), m_splats.end(),
-              [=](const RenderSplat& a, const RenderSplat& b) {
-                  // 깊이(Depth) = ViewMatrix * Position 의 Z값
-                  // 행렬 곱셈 공식을 풀어서 씀 (성능 위해)
-                  float depthA = (viewZ_x * a.x) + (viewZ_y * a.y) + (viewZ_z * a.z) + viewZ_w;
-                  float depthB = (viewZ_x * b.x) + (viewZ_y * b.y) + (viewZ_z * b.z) + viewZ_w;
-
-                  // 멀리 있는 것(Depth가 큰 것)이 먼저 그려져야 함 -> 내림차순
-                  return depthA > depthB;
-              }
-              );
-}
@@ -10,9 +10,62 @@
 #include <QMouseEvent>
 #include <QWheelEvent>
 #include <QElapsedTimer>
+#include <QTimer>
+#include <QVector2D>
+#include <QRect>
 #include <vector>
+#include <memory>
+#include <functional>
 #include "Camera.h"
 #include "GaussianData.h"
+#include "SplatScene.h"
+#include "RenderGraph.h"
+#include "CameraPath.h"
+#include "ImageMetrics.h"
+#include "ChunkStreamer.h"
+#include "HttpPlyStream.h"
+#include "FrameLatency.h"
+#include "ShaderCache.h"
+#include "OverlayRenderer.h"
+#include "HiZPyramid.h"
+
+// 스플랫 패스 합성 방식
+enum class RenderMode {
+    Sorted,       // CPU 정렬 + Back-to-Front 알파 블렌딩 (기본)
+    FrontToBack,  // 역순(앞 -> 뒤) + Under 연산자, 불투명해진 픽셀은 스텐실로 이후 프래그먼트를 조기 제외
+    WeightedOIT,  // Weighted Blended OIT: 정렬 없이 누적 후 Resolve
+    OverdrawHeatmap // 디버그: 픽셀당 프래그먼트 수를 가산 누적해 히트맵으로 표시
+};
+
+// 다중 뷰 배치 (720p 내부 타겟을 타일로 나눠 뷰마다 한 칸, 합성은 정렬 모드)
+enum class ViewLayout {
+    Single,
+    Stereo,    // 좌우 두 눈 (평행 축: 같은 시선 방향, 눈 위치만 다름)
+    QuadOrbit  // 2x2, 타겟 주위로 yaw를 orbit spread씩 돌린 네 시점
+};
+
+// 스플랫 패스 한 번의 프래그먼트 수 (GPU 쿼리 결과, 몇 프레임 늦게 도착)
+struct FragmentStats {
+    bool valid = false;
+    bool hasShaded = false; // GL_ARB_pipeline_statistics_query가 있을 때만 shaded를 셀 수 있음
+    quint64 shaded = 0;     // 프래그먼트 셰이더 실행 수 (사각형이 덮은 픽셀 전부)
+    quint64 passed = 0;     // discard되지 않고 블렌딩까지 간 샘플 수 (GL_SAMPLES_PASSED)
+
+    quint64 discarded() const { return shaded > passed ? shaded - passed : 0; }
+    double discardedRatio() const { return shaded > 0 ? double(discarded()) / shaded : 0.0; }
+};
+
+// 정렬 패스 한 번의 클러스터 컬링 결과 (스플랫 수는 그리기 집합 기준)
+struct OcclusionStats {
+    int clusters = 0;          // 검사한 클러스터 (그릴 스플랫이 있는 것만)
+    int occluderClusters = 0;  // 가리개로 깊이를 그린 가까운 클러스터
+    int occluderSplats = 0;    // 그중 코어가 있어 실제로 그린 스플랫
+    int frustumClusters = 0;   // 시야 밖
+    qint64 frustumSplats = 0;
+    int occludedClusters = 0;  // Hi-Z 뒤에 완전히 숨은 것
+    qint64 occludedSplats = 0;
+    double ms = 0.0;           // 투영 + 가리개 패스 + 피라미드(리드백 대기 포함) + 검사
+};
 
 class SplattingWidget : public QOpenGLWidget, protected QOpenGLExtraFunctions
 {
@@ -22,8 +75,34 @@ public:
     explicit SplattingWidget(QWidget *parent = nullptr);
     ~SplattingWidget();
 
-    // 외부에서 데이터를 넘겨주는 함수
-    void loadData(const std::vector<RenderSplat>& splats);
+    // 외부에서 데이터를 넘겨주는 함수 (기존 씬을 모두 지우고 하나로 교체)
+    // sh: .s2vq의 SH 코드북 (있으면 시점별 색을 셰이더에서 복원)
+    void loadData(const std::vector<RenderSplat>& splats, const ShPalette *sh = nullptr);
+
+    // 멀티 씬 구성
+    // 씬마다 별도의 GPU 버퍼를 가지며, 정렬은 씬별로 병렬 수행 후 하나의 순서로 합칩니다.
+    static const int MAX_SCENES = 8; // 셰이더의 씬 샘플러 수
+    // spatialReorder: 로드 순서 대신 Morton 순서로 재배치 (스트리밍 슬롯처럼 인덱스가 고정돼야 하면 false)
+    int addScene(const QString &name, const std::vector<RenderSplat>& splats, bool spatialReorder = true,
+                 const ShPalette *sh = nullptr); // 실패 시 -1
+    void removeAllScenes();
+    int sceneCount() const { return static_cast<int>(m_scenes.size()); }
+    const SplatScene *scene(int index) const { return m_scenes[index].get(); }
+    void setSceneTransform(int index, const SceneTransform &transform);
+    void setSceneVisible(int index, bool visible);
+
+    // 청크 파일(.s2sc)을 스트리밍으로 열기 (기존 씬은 모두 지움)
+    // 메모리 예산 안에서 시야 근처 청크만 올리고, 정렬/그리기는 GPU에 상주한 청크만 대상으로 합니다.
+    bool openStreamedScene(const QString &chunkFilePath);
+    void setStreamingBudgets(qint64 cpuBytes, qint64 gpuBytes); // 다음 openStreamedScene부터 적용
+    bool isStreaming() const { return m_streamer.isOpen(); }
+
+    // HTTP 서버의 표준 PLY를 Range 요청으로 받으면서 그리기 (기존 씬은 모두 지움)
+    // 헤더가 오면 빈 씬을 만들고, 구간이 도착할 때마다 그 범위만 GPU에 올려 그리기 집합에 더합니다.
+    // 다 받으면 일반 로드처럼 공간 순서로 재배치합니다. 실패하면 받은 만큼만 남김
+    bool openRemoteScene(const QUrl &url);
+    bool isLoadingRemote() const { return m_remote.isActive(); }
+    HttpPlyStream &remoteStream() { return m_remote; } // 구간 크기/동시 요청 수 설정
 
     // UI에서 조절할 설정값 세터(Setter)
     void setGlobalScale(float scale);
@@ -34,6 +113,117 @@ public:
     void setUpscaleFilter(bool isLinear);
     void setUseFSR(bool use);
 
+    // 시간적 업스케일 (TAAU)
+    // 스플랫 패스는 720p 그대로 그리되 매 프레임 서브픽셀 지터(Halton 2,3)를 주고,
+    // 출력 해상도의 히스토리에 이전 뷰-투영으로 재투영 + 이웃 색 범위 클램프로 누적합니다.
+    // 카메라가 멈추면 TEMPORAL_SAMPLES 프레임 뒤 수렴하고 스플랫 패스도 다시 쉽니다.
+    void setTemporalUpscale(bool enabled);
+    bool temporalUpscale() const { return m_useTemporal; }
+
+    // 현재 시점을 출력 해상도로 직접 그린 기준 이미지와 비교해 RCAS 경로와 시간적 업스케일의 품질/시간을 측정
+    // sideBySidePath가 있으면 [RCAS | Temporal | Diff] 이미지를 저장
+    QString compareTemporalWithRcas(int frames = 32, const QString &sideBySidePath = QString());
+
+    // 다중 뷰: 뷰들의 시선 방향이 허용 각도 안에 있으면 평균 방향으로 한 번 정렬해 모든 뷰가 공유하고
+    // (뷰 하나 추가 = 드로우 하나), 벗어나면 뷰마다 정렬합니다. 시간적 업스케일과는 함께 쓸 수 없음
+    void setViewLayout(ViewLayout layout);
+    ViewLayout viewLayout() const { return m_viewLayout; }
+    void setStereoSeparation(float fractionOfDistance); // 눈 사이 거리 = 궤도 거리 x 비율
+    void setOrbitSpread(float degrees);                 // QuadOrbit 시점 간 yaw 간격
+    void setSharedSortTolerance(float degrees);         // 공유 정렬을 허용하는 최대 시선 각도 차
+
+    // 합성 방식 전환 (OIT 모드에서는 CPU 정렬/재업로드를 하지 않음)
+    void setRenderMode(RenderMode mode);
+    RenderMode renderMode() const { return m_renderMode; }
+
+    // 프래그먼트 수 측정 (오버레이 표시). 히트맵 모드에서는 항상 켜짐
+    void setFragmentStats(bool enabled);
+    const FragmentStats &fragmentStats() const { return m_fragmentStats; }
+    // 히트맵 색 범위의 상한 (이 이상 겹치면 흰색)
+    void setHeatmapRange(int maxFragments);
+
+    // 현재 시점을 정렬 모드와 OIT 모드로 각각 그려 차이를 측정
+    // sideBySidePath가 있으면 [Sorted | OIT | Diff] 이미지를 저장
+    ImageDiff compareOitWithSorted(const QString &sideBySidePath = QString());
+
+    // 현재 시점을 Back-to-Front와 Front-to-Back(조기 종료)으로 frames번씩 그려
+    // 셰이더 실행/블렌딩 프래그먼트 수, 시간, 화질 차이를 비교한 요약 문자열을 반환
+    // sideBySidePath가 있으면 [Back-to-Front | Front-to-Back | Diff] 이미지를 저장
+    QString compareFrontToBack(int frames = 16, const QString &sideBySidePath = QString());
+
+    // 깊이 프리패스 (Sorted/Front-to-Back 단일 뷰): 불투명도가 threshold 이상인 스플랫의 불투명 코어만
+    // 색 쓰기 없이 먼저 그려 깊이를 채우고, 블렌딩 패스는 그 깊이로 테스트해 가려진 프래그먼트를 셰이더 전에 버립니다.
+    // 코어 = alpha >= threshold인 영역이고 스플랫 뒤쪽 깊이로 쓰므로 가림은 보수적입니다.
+    void setDepthPrepass(bool enabled);
+    bool depthPrepass() const { return m_depthPrepass; }
+    void setDepthPrepassThreshold(float coreAlpha); // 0 < coreAlpha < 1
+    float depthPrepassThreshold() const { return m_coreAlpha; }
+
+    // 정렬 모드에서 깊이 프리패스 없이/있이 frames번씩 그려 셰이더 실행/블렌딩 프래그먼트 수,
+    // 시간(프리패스 포함), 화질 차이를 비교한 요약 문자열을 반환. 현재 시점과 yaw/pitch를 돌린 시점 몇 개에서 잼
+    // sideBySidePath가 있으면 현재 시점의 [Without | With | Diff] 이미지를 저장
+    QString compareDepthPrepass(int frames = 16, const QString &sideBySidePath = QString());
+
+    // 클러스터 가림 컬링 (Sorted/Front-to-Back 단일 뷰, Morton 재배치된 씬만)
+    // 정렬 전에 가까운 클러스터의 불투명 코어를 깊이만 그려 Hi-Z 피라미드를 만들고, 나머지 클러스터의 AABB
+    // (스플랫 크기만큼 넓힘)가 그 뒤에 완전히 숨으면 클러스터째 정렬과 그리기에서 뺍니다. 시야 밖 클러스터도 뺍니다.
+    // 코어 임계값은 깊이 프리패스와 같은 값(depthPrepassThreshold)을 씁니다.
+    void setOcclusionCulling(bool enabled);
+    bool occlusionCulling() const { return m_occlusionCulling; }
+    const OcclusionStats &occlusionStats() const { return m_occlusionStats; } // 마지막 정렬 패스
+
+    // 현재 시점과 yaw/pitch를 돌린 시점들에서 컬링 없이/있이 그린 이미지를 비교해 보이는 클러스터를 뺐는지 검사
+    // 어느 시점에서든 바뀐 픽셀이 0.1%를 넘으면 실패로 보고. sideBySidePath가 있으면 현재 시점의 비교 이미지를 저장
+    QString checkOcclusionCulling(int frames = 4, const QString &sideBySidePath = QString());
+
+    // 파일 순서 vs Morton 순서의 정렬/그리기 시간 비교
+    // 카메라를 씬 주위로 돌리며 frames 프레임씩 재고 요약 문자열을 반환 (끝나면 Morton 순서 씬이 남음)
+    QString benchmarkSpatialOrder(const std::vector<RenderSplat>& fileOrder, int frames = 120);
+
+    // 점진적 정제
+    // 카메라를 조작하는 동안은 씬마다 중요도(불투명도 x 면적) 상위 접두부만 정렬/그리고, 그 크기는
+    // 측정한 정렬 + 스플랫 패스 시간이 목표 프레임 시간에 맞도록 조절합니다.
+    // 입력이 PROGRESSIVE_IDLE_MS 동안 없으면 REFINE_STEPS 프레임에 걸쳐 전체 집합까지 늘립니다.
+    void setProgressiveRefinement(bool enabled);
+    bool progressiveRefinement() const { return m_progressive; }
+    void setInteractiveFrameTarget(float ms);
+
+    // 입력 -> 표시 지연 측정
+    // 카메라를 움직인 입력 이벤트마다 도착 시각을 찍고 정렬/그리기/스왑까지의 구간 지연을 히스토그램으로 모아
+    // 오버레이에 표시합니다. 스왑 간격(vsync)은 컨텍스트를 만들 때 정해지므로 실행 옵션(--swap-interval)입니다.
+    void setLatencyMeasurement(bool enabled);
+    const LatencyTracker &latencyTracker() const { return m_latency; }
+    void resetLatencyStats();
+
+    // 늦은 프레임 시작: 다음 vblank까지 (예상 렌더 시간 + margin)만 남기고 프레임 시작을 미뤄
+    // 입력을 마감 직전에 읽습니다. 고정 주사율에서 지연이 줄지만, 예측이 빗나가면 한 주기를 놓칩니다.
+    void setLateFrameStart(bool enabled);
+    void setLateFrameMargin(float ms);
+
+    // 피킹/영역 선택 (BVH, 단일 뷰에서만, 스트리밍 씬 제외)
+    // 더블클릭: 찍은 점으로 궤도 중심 이동, Shift+드래그: 사각형 선택, Ctrl+드래그: 올가미 선택
+    SplatPick pickAt(const QPointF &widgetPos); // 결과와 걸린 시간을 오버레이용으로 남김
+    // 화면에 grid x grid로 고르게 찍은 광선의 피킹 시간 (평균/p50/p99/최대)과 BVH 크기/빌드 시간 요약
+    QString measurePickLatency(int grid = 32);
+    void selectRegion(const QPolygonF &widgetPolygon, bool isRect); // 결과는 selection() (SplatRef 목록)
+    const std::vector<quint32> &selection() const { return m_selection; }
+    void clearSelection();
+
+    // 카메라 경로 기록/재생 (반복 가능한 성능 측정용)
+    void startCameraRecording();
+    CameraPath stopCameraRecording();
+    bool isRecordingCameraPath() const { return m_pathRecorder.isRecording(); }
+
+    // stepMs 간격으로 경로를 재생하고, 끝나면 프레임 시간 요약을 출력
+    void playCameraPath(const CameraPath &path, int stepMs = 16);
+    bool isPlayingCameraPath() const { return m_pathPlayer.isPlaying(); }
+
+    // 프레임당 힙 할당 검사 (S2S_ALLOC_COUNTER 빌드에서만)
+    // 카메라를 조금씩 돌리며 frames 프레임을 그리고, 워밍업 이후 GUI 스레드에서 할당한 프레임이 있으면 실패.
+    // exitWhenDone이면 끝날 때 종료 코드 0 (통과) / 3 (실패)로 앱을 끝냄. 카운터가 없으면 false
+    bool startAllocationCheck(int frames, bool exitWhenDone);
+    quint64 lastFrameAllocations() const { return m_frameAllocs; }
+
 protected:
     void initializeGL() override;
     void paintGL() override;
@@ -42,6 +232,8 @@ protected:
     // 마우스 이벤트 오버라이딩
     void mousePressEvent(QMouseEvent *event) override;
     void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
     void wheelEvent(QWheelEvent *event) override;
 
 private:
@@ -53,39 +245,191 @@ private:
     void initGeometry();
 #endif
 
-    // 정렬 함수
-    void sortSplats(const QMatrix4x4& viewMatrix);
+    // 씬 GPU 버퍼 (Texture Buffer Object로 셰이더에서 인덱스로 읽음)
+    struct SceneGpu {
+        GLuint buffer = 0;
+        GLuint texture = 0;
+    };
+    void uploadScene(int index);
+    void uploadSceneRange(int index, size_t offset, size_t count); // 일부만 glBufferSubData
+    void releaseSceneGpu(SceneGpu &gpu);
+    void bindSceneTextures();
+
+    // 모든 씬의 SH 코드북을 이어 붙인 TBO (항목당 texel 12개 = 48 float, 45개 사용)
+    // 씬 슬롯 i의 항목 j는 m_shBase[i] + j번째 항목. 텍스처 유닛은 SH_CODEBOOK_UNIT.
+    static const int SH_CODEBOOK_UNIT = MAX_SCENES;
+    void uploadShCodebooks();
+    void releaseShCodebooks();
+    GLuint m_shBuffer = 0;
+    GLuint m_shTexture = 0;
+    int m_shBase[MAX_SCENES] = {};
 
     void initFSRQuad();   // 초기화 함수 (initializeGL에서 호출)
     void renderFSRQuad(); // 그리기 함수 (paintGL에서 호출)
 
+    // 패스별 그리기 (paintGL에서 더티일 때만 호출)
+    // 그리기 목록 갱신. sorted=false면 순서 없는 목록(OIT용), frontToBack이면 앞 -> 뒤. 실제로 작업했으면 true
+    bool runSortPass(const QMatrix4x4& view, bool sorted, bool frontToBack = false);
+    void mergeSortedScenes(const QMatrix4x4& view, std::vector<quint32> &outList); // 필요한 씬만 정렬 후 병합
+    void uploadDrawList();
+    void renderSplatPass(const QMatrix4x4& view);
+    void renderPostPass();
+
+    // 스플랫 패스 구현 (모드별)
+    // aspect > 0이면 그 비율의 투영 (다중 뷰 타일), 아니면 내부 해상도 비율 + 지터
+    void setSplatUniforms(QOpenGLShaderProgram *program, const QMatrix4x4& view, float aspect = 0.0f);
+
+    // 스플랫 셰이더 변형: 현재 상태의 기능(SH 씬이 있는지, 컷오프 > 0) + 패스별 기능으로 고른 프로그램
+    // 처음 쓰는 조합이면 캐시에서 만들고 씬 샘플러를 설정. 실패하면 nullptr
+    enum SplatProgramKind { SplatProgram_Blend, SplatProgram_Oit, SplatProgram_Overdraw };
+    QOpenGLShaderProgram *splatProgram(SplatProgramKind kind, quint32 passFeatures = 0);
+    quint32 splatFeatures() const;
+    QMatrix4x4 projectionMatrix(bool jittered) const;
+
+    // 다시 그리기 요청 (늦은 프레임 시작이면 vblank 직전까지 미룸)
+    void requestFrame();
+    double refreshPeriodMs() const;
+
+    // 점진적 정제: 입력마다 예산 모드로 전환하고 유휴 타이머를 다시 시작
+    void beginInteraction();
+    void onInteractionIdle();
+    void advanceRefinement();
+    qint64 interactiveBudget() const;
+    void applyDrawBudget(qint64 budget); // 씬마다 크기에 비례해 나눔, -1 = 전체
+    void collectSplatTime();             // 지난 스플랫 패스의 GPU 시간 (준비됐을 때만)
+
+    // 피킹/선택 대상 씬 (보이는 씬 중 스트리밍 씬 제외)과 그 슬롯
+    bool pickableScenes(std::vector<const SplatScene *> &scenes, std::vector<int> &sceneSlots) const;
+    QPointF widgetToNdc(const QPointF &widgetPos) const;
+    // target이 없으면 m_fbo (720p). 시간적 업스케일 중에는 깊이 타겟(attachment 1)도 씀
+    void renderSortedSplats(const QMatrix4x4& view, QOpenGLFramebufferObject *target = nullptr);
+    void renderOitSplats(const QMatrix4x4& view);
+    void initOIT(); // OIT용 누적/Revealage 타겟 생성
+    void drawOverlay(); // m_overlay에 이번 프레임 텍스트/선택 영역/히스토그램을 채움
+    // 다중 뷰 (m_viewLayout != Single)
+    struct ViewSlot {
+        QMatrix4x4 view;
+        QRect tile; // m_fbo 안의 뷰포트 (GL 좌표, 아래가 원점)
+    };
+    void updateViewSlots(const QMatrix4x4 &view); // m_viewSlots를 현재 카메라 기준으로 (paintGL에서 프레임마다 한 번)
+    bool runMultiViewSortPass();
+    void renderMultiViewSplats();
+    void renderOverdrawHeatmap(const QMatrix4x4& view);
+    void initOverdraw(); // 히트맵용 카운트 타겟 생성
+    void renderFrontToBackSplats(const QMatrix4x4& view);
+    void markSaturatedPixels();  // m_fbo 알파가 SATURATION_ALPHA 이상인 픽셀의 스텐실을 1로
+    void initFrontToBack();      // m_fbo의 스텐실을 공유하는 마킹용 FBO 생성
+    // 깊이 프리패스: 코어 깊이를 쓰고, 블렌딩 패스용 깊이 테스트(GL_LEQUAL, 쓰기 끔)를 켠 채로 돌아옴
+    void renderDepthPrepass(const QMatrix4x4& view);
+    // 깊이만 그리는 불투명 코어 드로우 (프리패스/가리개 공용). 깊이 테스트 on, GL_LESS, 깊이 쓰기 상태로 끝남
+    void drawDepthCores(const QMatrix4x4& view, QOpenGLBuffer &refs, int count);
+    // 클러스터 컬링 (runSortPass에서 정렬 전에)
+    void cullClusters(const QMatrix4x4& view);
+    void clearClusterCulling();
+    void buildPrepassList(); // 그리기 목록에서 가리는 스플랫만 앞 -> 뒤로 골라 m_prepassVbo에 올림
+
+    // 그리기 목록의 [first, first + count) 구간 인스턴스 드로우 (count < 0이면 끝까지)
+    // 스플랫 패스에서 부를 때만 프래그먼트 쿼리로 감쌈
+    void drawSplatInstances(int first = 0, int count = -1);
+    void collectFragmentQueries();          // 끝난 쿼리만 읽음 (기다리지 않음)
+    FragmentStats sumFragmentQueries();     // 이번 패스의 쿼리 합 (끝날 때까지 기다림)
+
+    // compare*의 공통 측정: 쪽마다 prepare 후 frames번 그려 평균 시간(첫 프레임 제외), 첫 프레임의 프래그먼트 수,
+    // 마지막 이미지를 재고, 첫 쪽을 기준으로 절감률과 화질 차이를 적은 요약을 반환 (컨텍스트는 호출한 쪽이 current로)
+    // sideBySidePath가 있으면 마지막 두 쪽을 [A | B | Diff]로 저장
+    struct CompareSide {
+        QString label;
+        std::function<void()> prepare;              // 측정 전에 한 번 (시간에 포함하지 않음)
+        std::function<void(int frame)> render;      // 한 프레임
+        std::function<void(int frame)> afterFrame;  // 시간 측정 뒤 (선택)
+        std::function<QImage()> capture;            // 결과 이미지 (없으면 m_fbo)
+        QString note;                               // 보고 줄 끝에 괄호로 붙임
+    };
+    // diffs가 있으면 기준 대비 이미지 차이를 쪽 순서대로 (둘째 쪽부터) 채움
+    QString compareRenders(const QString &title, int frames, const std::vector<CompareSide> &sides,
+                           const QString &sideBySidePath, std::vector<ImageDiff> *diffs = nullptr);
+
+    // 시점 스윕: 현재 시점과 축에서 벗어난 시점 몇 개(SWEEP_POSES)를 차례로 카메라에 걸고 measure를 불러 보고를 모음
+    // measure는 (뷰 행렬, "yaw .., pitch .." 표기, 현재 시점인가)를 받음. 컨텍스트를 current로 두고 끝나면 카메라를 되돌림
+    using PoseMeasure = std::function<QString(const QMatrix4x4 &view, const QString &pose, bool current)>;
+    QStringList sweepPoses(const PoseMeasure &measure);
+
+    // 후처리 구현
+    void renderRcas(GLuint texture, int width, int height); // 현재 바인딩된 프레임버퍼에 RCAS
+    void ensureHistory(int width, int height);
+    void resolveTemporal(const QMatrix4x4& view); // m_fbo(지터된 새 샘플) + 히스토리 -> 새 히스토리
+    void resetTemporal();
+
+    // 스트리밍: 카메라 기준으로 청크 상주 집합 갱신 + 바뀐 슬롯 업로드
+    void updateStreaming();
+    void stopStreaming();
+
+    void stopRemoteLoad();
+    void onRemoteHeader(qint64 vertexCount);
+    void onRemoteChunk(qint64 firstSplat, const std::vector<RenderSplat> &splats);
+    void onRemoteFinished(bool ok, const QString &error);
+    void applyRemoteActive(); // 새로 받은 범위를 그리기 집합에 덧붙임 (m_remoteActiveTimer로 묶어서)
+
+    // 입력 변경을 그래프에 알리고, 다시 그릴 패스가 생겼으면 화면 갱신 요청
+    void invalidate(quint32 inputs);
+
 private:
     // 핵심: 오프스크린 렌더링용 FBO
     QOpenGLFramebufferObject *m_fbo = nullptr;
+    GLuint m_fboAuxTexture = 0; // attachment 1 (textures()는 호출마다 목록을 새로 만들므로 생성 때 기억)
+
+    // Weighted Blended OIT 타겟 (0: Accumulation RGBA16F, 1: log(Revealage) R16F)
+    QOpenGLFramebufferObject *m_oitFbo = nullptr;
+    GLuint m_oitAccumTexture = 0;
+    GLuint m_oitRevealTexture = 0;
+
+    // 오버드로 카운트 타겟 (RG32F, R: 래스터화된 프래그먼트, G: discard되지 않은 프래그먼트)
+    QOpenGLFramebufferObject *m_overdrawFbo = nullptr;
+
+    // Front-to-Back 포화 마킹용 FBO (색 없음, m_fbo의 Depth/Stencil 렌더버퍼를 공유)
+    // m_fbo 텍스처를 읽으면서 같은 스텐실에 쓰기 위해 따로 둡니다 (피드백 루프 방지).
+    GLuint m_saturationFbo = 0;
     
     // 내부 렌더링 해상도 (Switch 2 Portable Mode Target: 720p)
     const int INTERNAL_WIDTH = 1280;
     const int INTERNAL_HEIGHT = 720;
 
     // OpenGL 리소스
-    QOpenGLShaderProgram *m_program = nullptr;
+    // 프로그램은 모두 m_shaderCache 소유 (스플랫 패스는 splatProgram()으로 변형을 고름)
+    ShaderCache m_shaderCache;
+    QHash<quint32, QOpenGLShaderProgram *> m_splatPrograms; // (kind << 8) | features
     QOpenGLShaderProgram *m_fsrShader = nullptr;
+    QOpenGLShaderProgram *m_oitResolveShader = nullptr; // 누적 결과 -> m_fbo
+    QOpenGLShaderProgram *m_temporalShader = nullptr;   // 시간적 업스케일 누적
+    QOpenGLShaderProgram *m_heatmapShader = nullptr;    // 카운트 -> 색 (m_fbo)
+    QOpenGLShaderProgram *m_saturationShader = nullptr; // 포화 픽셀 스텐실 마킹
     QOpenGLVertexArrayObject m_vao;
     QOpenGLVertexArrayObject m_fsrvao;
-    QOpenGLBuffer m_instanceVbo; // 데이터(위치/색상) 담는 버퍼
+    QOpenGLBuffer m_orderVbo;    // 그리기 순서 (인스턴스마다 SplatRef 하나)
+    QOpenGLBuffer m_prepassVbo;  // 깊이 프리패스 순서 (불투명도 >= m_coreAlpha인 SplatRef만)
     QOpenGLBuffer m_quadVbo;     // 사각형 모양 담는 버퍼
     QOpenGLBuffer m_fsrquadVBO;
 
     Camera m_camera;
 
-    // 렌더링할 점의 개수
+    // 렌더링할 점의 개수 (그리기 목록 길이)
     int m_splatCount = 0;
 
-    // 원본 데이터를 저장해둘 벡터 (정렬 대상)
-    std::vector<RenderSplat> m_splats;
+    // 불러온 씬들 (인덱스 = 셰이더의 씬 슬롯)
+    std::vector<std::unique_ptr<SplatScene>> m_scenes;
+    std::vector<SceneGpu> m_sceneGpu;
+
+    // 병합된 그리기 목록 (정렬 모드: 뒤 -> 앞, OIT 모드: 씬 순서 그대로)
+    std::vector<quint32> m_drawList;
+    bool m_sceneSetChanged = true;  // 씬 추가/삭제/표시 변경 -> 목록 재구성 필요
+
+    // 더티 트래킹 렌더 그래프 (Sort -> Splat -> Post)
+    RenderGraph m_renderGraph;
+    int m_sortPass = -1;  // CPU 정렬 + 재업로드
+    int m_splatPass = -1; // 스플랫을 m_fbo(720p)에 그리기
+    int m_postPass = -1;  // FSR(RCAS) 또는 Blit으로 화면에 출력
 
     // 최적화 및 설정 변수들
-    bool m_needsSort = false;    // 정렬이 필요한가?
     float m_globalScale = 1.0f;  // 전체 크기 조절
     float m_alphaCutoff = 0.05f; // 투명도 컷오프
     float m_sharpness = 0.5f;    // 샤프니스 조절 변수 (기본값 강하게)
@@ -95,9 +439,162 @@ private:
     int m_frameCount = 0;
     float m_currentFps = 0.0f;
 
+    // 지연 측정 / 프레임 페이싱
+    LatencyTracker m_latency;
+    bool m_lateFrameStart = false;
+    float m_lateFrameMarginMs = 3.0f; // GPU 실행 + 합성 몫 (CPU 렌더 시간 예측에 더함)
+    QTimer m_frameStartTimer;
+
+    // 점진적 정제
+    static const int PROGRESSIVE_IDLE_MS = 150;
+    static const int REFINE_STEPS = 3;
+    static const int MIN_INTERACTIVE_SPLATS = 50000;
+    bool m_progressive = false;
+    float m_interactiveTargetMs = 12.0f;
+    bool m_interacting = false;
+    int m_refineStep = 0;        // 유휴 후 전체 집합까지 남은 단계
+    qint64 m_drawBudget = -1;    // 씬 전체에 걸친 그리기 한도 (-1 = 전체)
+    double m_nsPerSplat = 0.0;   // 스플랫 하나의 정렬 + 그리기 비용 추정 (지수 이동 평균)
+    double m_lastSortMs = 0.0;   // 이번 프레임 정렬 패스의 CPU 시간
+    GLuint m_splatTimeQuery = 0; // GL_TIME_ELAPSED
+    bool m_splatTimePending = false;
+    double m_timedSortMs = 0.0;  // 측정 중인 스플랫 패스와 같은 프레임의 정렬 시간
+    int m_timedSplats = 0;
+    QTimer m_idleTimer;
+
+    // 피킹/선택
+    enum class SelectDrag { None, Box, Lasso };
+    SelectDrag m_selectDrag = SelectDrag::None;
+    QPolygonF m_selectPath;           // 드래그 중인 영역 (위젯 좌표)
+    std::vector<quint32> m_selection; // 선택된 스플랫 (SplatRef)
+    SplatPick m_lastPick;
+    double m_lastPickMs = -1.0;
+    double m_lastSelectMs = -1.0;
+
+    // 카메라 경로 기록/재생
+    CameraPathRecorder m_pathRecorder;
+    CameraPathPlayer m_pathPlayer;
+    QElapsedTimer m_playbackFrameTimer;
+
     // 필터링 모드 변수 (기본값 true: 부드럽게)
     bool m_useLinearFilter = true;
     bool m_useFSR = true;
+
+    // 시간적 업스케일 상태
+    static const int TEMPORAL_SAMPLES = 16;  // 지터 주기 = 정지 후 수렴까지의 프레임 수
+    bool m_useTemporal = false;
+    QOpenGLFramebufferObject *m_history[2] = { nullptr, nullptr }; // 출력 해상도 RGBA16F 핑퐁
+    int m_historyIndex = 0;         // 최신 히스토리
+    bool m_historyValid = false;
+    int m_temporalFrame = 0;        // 마지막 카메라/씬 변경 이후 누적한 샘플 수
+    int m_jitterIndex = 0;
+    QVector2D m_jitter;             // 이번 스플랫 패스의 지터 (내부 해상도 픽셀 단위, -0.5 ~ 0.5)
+    QMatrix4x4 m_prevViewProj;      // 히스토리를 만든 프레임의 (지터 없는) 뷰-투영
+
+    // 청크 스트리밍 (m_streamSceneIndex 씬의 GPU 버퍼를 슬롯 배열로 사용)
+    ChunkStreamer m_streamer;
+    QTimer m_streamTimer;
+    int m_streamSceneIndex = -1;
+    qint64 m_streamCpuBudget = 1024ll * 1024 * 1024;
+    qint64 m_streamGpuBudget = 512ll * 1024 * 1024;
+    StreamingStats m_streamStats;
+
+    // HTTP Range 스트리밍 (m_remoteSceneIndex 씬을 받은 구간만 활성 집합으로 그림)
+    HttpPlyStream m_remote;
+    int m_remoteSceneIndex = -1;
+    std::vector<quint32> m_remoteArrived; // 지난 반영 이후 도착한 인덱스 (반영하면 비움)
+    qint64 m_remoteReceived = 0;          // 지금까지 도착한 스플랫 수
+    QTimer m_remoteActiveTimer;           // 구간마다 활성 집합을 건드리지 않도록 모아서 덧붙임
+    static const int REMOTE_ACTIVE_INTERVAL_MS = 100;
+
+    // 프래그먼트 수 측정
+    // 쿼리는 결과가 준비될 때까지 다시 시작하지 않으므로 GPU를 기다리지 않습니다.
+    bool m_fragmentStatsEnabled = false;
+    bool m_hasPipelineStats = false;   // GL_ARB_pipeline_statistics_query
+    // 패스 하나가 드로우 여러 번일 수 있으므로(Front-to-Back 구간) 드로우마다 쿼리 한 쌍
+    std::vector<GLuint> m_passedQueries;  // GL_SAMPLES_PASSED
+    std::vector<GLuint> m_shadedQueries;  // GL_FRAGMENT_SHADER_INVOCATIONS_ARB
+    int m_queriesUsed = 0;                // 이번 패스에서 쓴 쌍 수
+    bool m_queryPending = false;
+    bool m_countThisPass = false;      // 지금 그리는 것이 화면용 스플랫 패스인지
+    FragmentStats m_fragmentStats;
+
+    // 히트맵 모드: 카운트 타겟을 읽어 정확한 픽셀 통계를 냄
+    int m_heatmapMax = 32;
+    std::vector<float> m_overdrawReadback;
+    struct OverdrawPartial {
+        double rasterized = 0.0;
+        double kept = 0.0;
+        size_t covered = 0;
+        float peak = 0.0f;
+    };
+    std::vector<OverdrawPartial> m_overdrawPartials; // 작업자별 부분합 (작업자 수가 바뀔 때만 크기 변경)
+    double m_overdrawMean = 0.0;      // 화면 전체 평균 프래그먼트 수
+    double m_overdrawCoveredMean = 0.0; // 덮인 픽셀만의 평균
+    float m_overdrawPeak = 0.0f;
+    FragmentStats m_overdrawCounts;   // 카운트 타겟 합 (쿼리 없이도 정확)
+
+    // Front-to-Back: 누적 알파가 이 값을 넘은 픽셀은 이후 스플랫이 8비트 출력에 영향을 못 줌 (1 - 1/255)
+    static constexpr float SATURATION_ALPHA = 0.996f;
+    int m_saturationMarks = 0; // 마지막 패스에서 마킹한 횟수 (오버레이 표시용)
+
+    // 깊이 프리패스
+    bool m_depthPrepass = false;
+    float m_coreAlpha = 0.9f;
+    bool m_drawListFrontToBack = false; // 마지막 정렬 패스의 목록 방향
+    bool m_prepassDirty = true;         // 그리기 목록/임계값이 바뀌어 m_prepassVbo를 다시 만들어야 함
+    std::vector<quint32> m_prepassList;
+    int m_prepassCount = 0;
+
+    // 클러스터 가림 컬링
+    struct ClusterCandidate {
+        float distance;     // AABB의 가장 가까운 뷰 깊이 (가리개 선택 순서)
+        float x0, y0, x1, y1; // ndc 사각형
+        float nearestDepth; // 창 깊이 (0 ~ 1)
+        bool testable;      // 근평면에 걸치면 사각형을 믿을 수 없으므로 항상 그림
+        int scene;
+        quint32 cluster;
+        quint32 splats;
+    };
+    bool m_occlusionCulling = false;
+    OcclusionStats m_occlusionStats;
+    HiZPyramid m_hiz;
+    QOpenGLBuffer m_occluderVbo;                  // 가리개 코어 (SplatRef, 가까운 클러스터부터)
+    std::vector<quint32> m_occluderList;
+    std::vector<ClusterCandidate> m_cullCandidates;
+    std::vector<std::vector<quint8>> m_cullMasks; // 씬 슬롯별 (용량 재사용)
+
+    // 다중 뷰
+    ViewLayout m_viewLayout = ViewLayout::Single;
+    float m_stereoSeparation = 0.03f;
+    float m_orbitSpread = 90.0f;
+    float m_sharedSortTolerance = 3.0f;
+    bool m_sharedSort = true;        // 마지막 정렬 패스가 공유 정렬이었는지 (아니면 뷰별 목록을 이어 붙임)
+    float m_sharedSortAngle = 0.0f;  // 평균 시선 방향과 가장 먼 뷰의 각도 (도)
+    int m_viewSortCount = 0;
+    std::vector<ViewSlot> m_viewSlots;   // updateViewSlots() 결과 (정렬/그리기 패스가 같이 씀)
+    std::vector<quint32> m_viewSortList; // 뷰별 정렬 때 한 뷰의 목록
+
+    // 정렬 병합용 임시 목록 (프레임마다 할당하지 않도록 용량 유지)
+    std::vector<const SplatScene *> m_mergeVisible;
+    std::vector<SplatScene *> m_mergeNeedSort;
+    std::vector<int> m_mergeSlots;
+
+    // 오버레이 + 프레임당 할당 수
+    OverlayRenderer m_overlay;
+    quint64 m_frameAllocs = 0;    // 마지막 paintGL의 GUI 스레드 할당 수
+    quint64 m_frameAllocsAll = 0; // 같은 구간의 모든 스레드 합 (작업 스레드 포함)
+    int m_allocCheckRemaining = 0;
+    int m_allocCheckWarmup = 0;
+    int m_allocCheckFrames = 0;
+    int m_allocCheckFailedFrames = 0;
+    quint64 m_allocCheckMax = 0;
+    bool m_allocCheckExit = false;
+    void recordAllocationCheckFrame();
+    void advanceAllocationCheck(); // frameSwapped마다 카메라를 돌리고 다음 프레임 요청
+
+    RenderMode m_renderMode = RenderMode::Sorted;
+    ImageDiff m_lastOitDiff; // 마지막 OIT vs Sorted 비교 결과 (오버레이 표시용)
 };
 
 #endif // SPLATTINGWIDGET_H
@@ -0,0 +1,423 @@
+#include "TaskScheduler.h"
+#include <QtGlobal>
+#include <QStringList>
+#include <QDebug>
+#include <algorithm>
+#include <chrono>
+
+#if defined(Q_OS_WIN)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(Q_OS_LINUX)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+thread_local int t_worker = -1;
+
+// 잠들기 전에 양보하며 다시 찾아보는 횟수 (짧은 작업이 이어질 때 깨우는 비용을 줄임)
+const int SPIN_ROUNDS = 64;
+
+int hardwareThreads()
+{
+    const unsigned n = std::thread::hardware_concurrency();
+    return n > 0 ? int(n) : 1;
+}
+
+} // namespace
+
+// --- TaskQueue ---
+
+void TaskScheduler::TaskQueue::pushBack(const Task &task)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (size == ring.size()) {
+        // 두 배로 늘리면서 head부터 순서대로 펼침
+        std::vector<Task> grown(std::max<size_t>(64, ring.size() * 2));
+        for (size_t i = 0; i < size; ++i) grown[i] = ring[(head + i) % ring.size()];
+        ring.swap(grown);
+        head = 0;
+    }
+    ring[(head + size) % ring.size()] = task;
+    ++size;
+}
+
+bool TaskScheduler::TaskQueue::popBack(Task &task)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (size == 0) return false;
+    --size;
+    task = ring[(head + size) % ring.size()];
+    return true;
+}
+
+bool TaskScheduler::TaskQueue::popFront(Task &task)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (size == 0) return false;
+    task = ring[head];
+    head = (head + 1) % ring.size();
+    --size;
+    return true;
+}
+
+// --- TaskScheduler ---
+
+TaskScheduler &TaskScheduler::instance()
+{
+    static TaskScheduler scheduler;
+    return scheduler;
+}
+
+TaskScheduler::TaskScheduler()
+{
+    startWorkers();
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    stopWorkers();
+}
+
+int TaskScheduler::currentWorker()
+{
+    return t_worker;
+}
+
+qint64 TaskScheduler::nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void TaskScheduler::configure(const Options &options)
+{
+    if (m_queued.load() > 0) {
+        qWarning() << "Task scheduler: configure() called with" << m_queued.load() << "queued tasks - ignored";
+        return;
+    }
+    stopWorkers();
+    m_options = options;
+    startWorkers();
+}
+
+void TaskScheduler::startWorkers()
+{
+    const int threads = m_options.threadCount > 0 ? m_options.threadCount : hardwareThreads();
+    const int workers = std::max(0, threads - 1);
+
+    m_quit = false;
+    m_workers.clear();
+    for (int i = 0; i < workers; ++i) m_workers.push_back(std::make_unique<Slot>());
+    // 모든 슬롯을 만든 뒤에 시작 (다른 스레드가 m_workers를 훔치기 대상으로 훑으므로)
+    for (int i = 0; i < workers; ++i) {
+        m_workers[i]->thread = std::thread([this, i]() { workerMain(i); });
+        if (m_options.pinThreads) pinThread(m_workers[i]->thread, (m_options.firstCore + i) % hardwareThreads());
+    }
+    qDebug() << "Task scheduler:" << workers << "workers + caller" << (m_options.pinThreads ? "(pinned)" : "");
+}
+
+void TaskScheduler::stopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_quit = true;
+    }
+    m_wake.notify_all();
+    for (std::unique_ptr<Slot> &slot : m_workers) {
+        if (slot->thread.joinable()) slot->thread.join();
+    }
+    m_workers.clear();
+}
+
+void TaskScheduler::pinThread(std::thread &thread, int core)
+{
+#if defined(Q_OS_WIN)
+    if (core < int(sizeof(DWORD_PTR) * 8)
+        && SetThreadAffinityMask(static_cast<HANDLE>(thread.native_handle()), DWORD_PTR(1) << core) == 0) {
+        qWarning() << "Task scheduler: cannot pin worker to core" << core;
+    }
+#elif defined(Q_OS_LINUX)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    if (pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) != 0) {
+        qWarning() << "Task scheduler: cannot pin worker to core" << core;
+    }
+#else
+    Q_UNUSED(thread);
+    Q_UNUSED(core);
+    static bool warned = false;
+    if (!warned) qWarning() << "Task scheduler: thread pinning is not supported on this platform";
+    warned = true;
+#endif
+}
+
+void TaskScheduler::workerMain(int index)
+{
+    t_worker = index;
+    int idle = 0;
+    while (!m_quit.load()) {
+        if (runOne()) {
+            idle = 0;
+            continue;
+        }
+        if (++idle < SPIN_ROUNDS) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // submit()은 m_queued를 올린 뒤 m_sleeping을 보므로, 여기서 m_sleeping을 먼저 올리면 깨우는 신호를 놓치지 않음
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        ++m_sleeping;
+        m_wake.wait(lock, [this]() { return m_queued.load() > 0 || m_quit.load(); });
+        --m_sleeping;
+        idle = 0;
+    }
+}
+
+void TaskScheduler::submit(const Task &task)
+{
+    const int worker = t_worker;
+    Slot &slot = (worker >= 0 && worker < workerCount()) ? *m_workers[worker] : m_external;
+    slot.queue.pushBack(task);
+    ++m_queued;
+
+    if (m_sleeping.load() > 0) {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_wake.notify_one();
+    }
+}
+
+bool TaskScheduler::runOne()
+{
+    const int worker = t_worker;
+    const int workers = workerCount();
+    Slot &self = (worker >= 0 && worker < workers) ? *m_workers[worker] : m_external;
+    Task task;
+
+    // 1. 자기 덱 뒤 (가장 최근에 만든 작업)
+    if (&self != &m_external && self.queue.popBack(task)) {
+        --m_queued;
+        execute(task, self, worker, false);
+        return true;
+    }
+
+    // 2. 공용 큐 앞
+    if (m_external.queue.popFront(task)) {
+        --m_queued;
+        execute(task, self, worker, false);
+        return true;
+    }
+
+    // 3. 다른 풀 스레드 덱 앞에서 훔치기 (바로 다음 번호부터 돌아가며)
+    for (int k = 1; k <= workers; ++k) {
+        const int victim = (std::max(worker, 0) + k) % workers;
+        if (victim == worker) continue;
+        if (m_workers[victim]->queue.popFront(task)) {
+            --m_queued;
+            execute(task, self, worker, true);
+            return true;
+        }
+    }
+    return false;
+}
+
+void TaskScheduler::execute(const Task &task, Slot &slot, int worker, bool stolen)
+{
+    const qint64 start = nowNs();
+    task.invoke(task.context, task.begin, task.end);
+    const qint64 end = nowNs();
+
+    slot.tasks.fetch_add(1, std::memory_order_relaxed);
+    if (stolen) slot.steals.fetch_add(1, std::memory_order_relaxed);
+    slot.busyNs.fetch_add(end - start, std::memory_order_relaxed);
+    if (m_hasObserver.load(std::memory_order_relaxed)) {
+        m_observer(TaskTiming{ task.name ? task.name : task.group->m_name, worker, start, end });
+    }
+
+    // 마지막에 내려야 wait()가 끝난 뒤 task.group을 건드리지 않음
+    task.group->m_pending.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void TaskScheduler::setTaskObserver(TaskObserver observer)
+{
+    m_hasObserver = false;
+    m_observer = std::move(observer);
+    m_hasObserver = bool(m_observer);
+}
+
+std::vector<TaskScheduler::WorkerStats> TaskScheduler::stats() const
+{
+    std::vector<WorkerStats> result;
+    auto read = [&result](const Slot &slot) {
+        WorkerStats stats;
+        stats.tasks = slot.tasks.load();
+        stats.steals = slot.steals.load();
+        stats.busyNs = slot.busyNs.load();
+        result.push_back(stats);
+    };
+    for (const std::unique_ptr<Slot> &slot : m_workers) read(*slot);
+    read(m_external);
+    return result;
+}
+
+void TaskScheduler::resetStats()
+{
+    auto reset = [](Slot &slot) {
+        slot.tasks = 0;
+        slot.steals = 0;
+        slot.busyNs = 0;
+    };
+    for (std::unique_ptr<Slot> &slot : m_workers) reset(*slot);
+    reset(m_external);
+}
+
+QString TaskScheduler::statsString() const
+{
+    const std::vector<WorkerStats> all = stats();
+    QStringList parts;
+    for (size_t i = 0; i < all.size(); ++i) {
+        const QString label = (i + 1 == all.size()) ? QString("caller") : QString("w%1").arg(i);
+        parts << QString("%1 %2 tasks/%3 steals/%4 ms")
+                     .arg(label)
+                     .arg(all[i].tasks)
+                     .arg(all[i].steals)
+                     .arg(all[i].busyNs / 1.0e6, 0, 'f', 1);
+    }
+    return parts.join(", ");
+}
+
+// --- TaskGroup ---
+
+void TaskGroup::submit(void (*invoke)(const void *, size_t, size_t), const void *context, size_t begin,
+                       size_t end, const char *name)
+{
+    TaskScheduler::Task task;
+    task.invoke = invoke;
+    task.context = context;
+    task.begin = begin;
+    task.end = end;
+    task.group = this;
+    task.name = name;
+    m_pending.fetch_add(1, std::memory_order_relaxed);
+    TaskScheduler::instance().submit(task);
+}
+
+void TaskGroup::run(std::function<void()> fn, const char *name)
+{
+    const std::function<void()> *stored;
+    {
+        std::lock_guard<std::mutex> lock(m_functionsMutex);
+        m_functions.push_back(std::move(fn));
+        stored = &m_functions.back();
+    }
+    submit([](const void *context, size_t, size_t) { (*static_cast<const std::function<void()> *>(context))(); },
+           stored, 0, 0, name);
+}
+
+void TaskGroup::runRange(const std::function<void(size_t, size_t)> &fn, size_t begin, size_t end,
+                         const char *name)
+{
+    submit([](const void *context, size_t b, size_t e) {
+               (*static_cast<const std::function<void(size_t, size_t)> *>(context))(b, e);
+           },
+           &fn, begin, end, name);
+}
+
+void TaskGroup::wait()
+{
+    TaskScheduler &scheduler = TaskScheduler::instance();
+    while (m_pending.load(std::memory_order_acquire) > 0) {
+        // 남은 작업이 다른 스레드에서 실행 중이면 그동안 다른 작업을 돕고, 그것도 없으면 양보
+        if (!scheduler.runOne()) std::this_thread::yield();
+    }
+
+    std::lock_guard<std::mutex> lock(m_functionsMutex);
+    m_functions.clear();
+}
+
+// --- TaskGraph ---
+
+int TaskGraph::add(const char *name, std::function<void()> fn)
+{
+    std::unique_ptr<Node> node = std::make_unique<Node>();
+    node->name = name;
+    node->fn = std::move(fn);
+    node->graph = this;
+    m_nodes.push_back(std::move(node));
+    return int(m_nodes.size()) - 1;
+}
+
+void TaskGraph::precede(int before, int after)
+{
+    m_nodes[before]->successors.push_back(after);
+    ++m_nodes[after]->predecessors;
+}
+
+void TaskGraph::invokeNode(const void *context, size_t, size_t)
+{
+    Node *node = const_cast<Node *>(static_cast<const Node *>(context));
+    const qint64 start = TaskScheduler::nowNs();
+    node->fn();
+    node->ms = (TaskScheduler::nowNs() - start) / 1.0e6;
+
+    // 마지막 선행 노드를 끝낸 스레드가 후속 노드를 스케줄
+    TaskGraph *graph = node->graph;
+    for (int next : node->successors) {
+        Node *successor = graph->m_nodes[next].get();
+        if (successor->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            graph->m_group->submit(&TaskGraph::invokeNode, successor, 0, 0, successor->name);
+        }
+    }
+}
+
+bool TaskGraph::run()
+{
+    // 순환 확인 (Kahn): 선행 노드가 없는 것부터 지워 나가서 모두 지워지는지
+    std::vector<int> indegree(m_nodes.size());
+    std::vector<int> ready;
+    for (size_t i = 0; i < m_nodes.size(); ++i) {
+        indegree[i] = m_nodes[i]->predecessors;
+        if (indegree[i] == 0) ready.push_back(int(i));
+    }
+    size_t visited = 0;
+    while (!ready.empty()) {
+        const int n = ready.back();
+        ready.pop_back();
+        ++visited;
+        for (int next : m_nodes[n]->successors) {
+            if (--indegree[next] == 0) ready.push_back(next);
+        }
+    }
+    if (visited != m_nodes.size()) {
+        qWarning() << "Task graph" << m_name << "has a cycle - not run";
+        return false;
+    }
+
+    TaskGroup group(m_name);
+    m_group = &group;
+    for (std::unique_ptr<Node> &node : m_nodes) {
+        node->remaining = node->predecessors;
+        node->ms = 0.0;
+    }
+    for (std::unique_ptr<Node> &node : m_nodes) {
+        if (node->predecessors == 0) group.submit(&TaskGraph::invokeNode, node.get(), 0, 0, node->name);
+    }
+    group.wait();
+    m_group = nullptr;
+    return true;
+}
+
+QString TaskGraph::timingString() const
+{
+    QStringList parts;
+    for (const std::unique_ptr<Node> &node : m_nodes) {
+        parts << QString("%1 %2 ms").arg(node->name).arg(node->ms, 0, 'f', 2);
+    }
+    return parts.join(", ");
+}
@@ -0,0 +1,197 @@
+#ifndef TASKSCHEDULER_H
+#define TASKSCHEDULER_H
+
+#include <QString>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class TaskGroup;
+
+// 작업 하나의 실행 기록 (setTaskObserver로 받음)
+struct TaskTiming {
+    const char *name; // 작업 이름 (정적 문자열)
+    int worker;       // 실행한 풀 스레드 (-1 = 풀 밖의 스레드가 기다리면서 실행)
+    qint64 startNs;   // TaskScheduler::nowNs() 기준
+    qint64 endNs;
+};
+
+// 작업 훔치기(Work-Stealing) 스케줄러
+//
+// 풀 스레드마다 작업 덱이 있어서, 풀 스레드가 만든 작업은 자기 덱 뒤에 넣고 뒤에서 꺼냅니다 (캐시가 따뜻한 최근 작업 먼저).
+// 할 일이 없는 스레드는 다른 덱의 앞(가장 오래된, 보통 가장 큰 작업)에서 훔쳐 옵니다.
+// 풀 밖의 스레드(GUI 스레드 등)가 만든 작업은 공용 큐로 들어갑니다.
+//
+// TaskGroup::wait()는 기다리는 동안 대기 중인 작업을 직접 실행하므로
+// 작업 안에서 다시 병렬 작업을 만들고 기다려도 (씬별 정렬 안의 병렬 정렬 등) 교착되지 않습니다.
+// 실행 중인 스레드 수 = 풀 스레드 + 기다리는 호출 스레드.
+class TaskScheduler
+{
+public:
+    struct Options {
+        int threadCount = 0;     // 동시에 일하는 스레드 수 (호출 스레드 포함, 풀 = threadCount - 1). 0 = 하드웨어 스레드 수
+        bool pinThreads = false; // 풀 스레드 i를 논리 코어 (firstCore + i) % 코어 수에 고정 (Linux/Windows)
+        int firstCore = 1;       // 0번 코어는 GUI 스레드 몫으로 비워 둠
+    };
+
+    struct WorkerStats {
+        qint64 tasks = 0;  // 실행한 작업
+        qint64 steals = 0; // 그중 다른 스레드 덱에서 훔친 것
+        qint64 busyNs = 0; // 작업 실행에 쓴 시간
+    };
+
+    using TaskObserver = std::function<void(const TaskTiming &)>;
+
+    static TaskScheduler &instance();
+
+    // 풀을 다시 만듦. 실행 중인 작업이 없을 때만 호출 (설정 화면, 벤치마크 사이)
+    void configure(const Options &options);
+    const Options &options() const { return m_options; }
+
+    int workerCount() const { return int(m_workers.size()); } // 풀 스레드
+    int concurrency() const { return workerCount() + 1; }     // 호출 스레드 포함
+    static int currentWorker();                                // 풀 스레드 번호, 풀 밖이면 -1
+    static qint64 nowNs();
+
+    // 모든 작업이 끝날 때마다 (실행한 스레드에서) 호출. nullptr로 해제. 실행 중인 작업이 없을 때만 바꿀 것
+    void setTaskObserver(TaskObserver observer);
+
+    // 풀 스레드별 통계 + 마지막 항목 = 풀 밖 스레드들 합계
+    std::vector<WorkerStats> stats() const;
+    void resetStats();
+    QString statsString() const;
+
+private:
+    friend class TaskGroup;
+    friend class TaskGraph;
+
+    // 할당 없이 덱에 넣을 수 있도록 함수 포인터 + 문맥으로 표현
+    struct Task {
+        void (*invoke)(const void *context, size_t begin, size_t end) = nullptr;
+        const void *context = nullptr;
+        size_t begin = 0;
+        size_t end = 0;
+        TaskGroup *group = nullptr;
+        const char *name = nullptr;
+    };
+
+    // 늘어나기만 하는 링 버퍼 덱 (한 번 커지면 이후로는 할당 없음)
+    struct TaskQueue {
+        std::mutex mutex;
+        std::vector<Task> ring;
+        size_t head = 0;
+        size_t size = 0;
+
+        void pushBack(const Task &task);
+        bool popBack(Task &task);
+        bool popFront(Task &task);
+    };
+
+    struct Slot {
+        TaskQueue queue;
+        std::thread thread;
+        std::atomic<qint64> tasks{ 0 };
+        std::atomic<qint64> steals{ 0 };
+        std::atomic<qint64> busyNs{ 0 };
+    };
+
+    TaskScheduler();
+    ~TaskScheduler();
+
+    void startWorkers();
+    void stopWorkers();
+    void pinThread(std::thread &thread, int core);
+    void workerMain(int index);
+
+    void submit(const Task &task);
+    bool runOne(); // 작업 하나를 찾아 실행했으면 true
+    void execute(const Task &task, Slot &slot, int worker, bool stolen);
+
+    Options m_options;
+    std::vector<std::unique_ptr<Slot>> m_workers;
+    Slot m_external; // 풀 밖 스레드가 넣는 공용 큐 + 그 스레드들의 통계
+
+    std::atomic<bool> m_quit{ false };
+    std::atomic<int> m_queued{ 0 };   // 모든 큐에 들어 있는 작업 수
+    std::atomic<int> m_sleeping{ 0 }; // 잠든 풀 스레드 수
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+
+    std::atomic<bool> m_hasObserver{ false };
+    TaskObserver m_observer;
+};
+
+// 함께 기다릴 작업 묶음
+class TaskGroup
+{
+public:
+    explicit TaskGroup(const char *name = "task") : m_name(name) {}
+    ~TaskGroup() { wait(); }
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup &operator=(const TaskGroup &) = delete;
+
+    // fn을 복사해 보관하고 실행
+    void run(std::function<void()> fn, const char *name = nullptr);
+
+    // fn(begin, end)를 작업 하나로 실행. fn은 복사하지 않으므로 wait()까지 살아 있어야 함 (할당 없음)
+    void runRange(const std::function<void(size_t, size_t)> &fn, size_t begin, size_t end,
+                  const char *name = nullptr);
+
+    // 모든 작업이 끝날 때까지 (대기 중인 작업을 실행하면서) 기다림
+    void wait();
+
+private:
+    friend class TaskScheduler;
+    friend class TaskGraph;
+
+    void submit(void (*invoke)(const void *, size_t, size_t), const void *context, size_t begin, size_t end,
+                const char *name);
+
+    const char *m_name;
+    std::atomic<int> m_pending{ 0 };
+    std::mutex m_functionsMutex;
+    std::list<std::function<void()>> m_functions; // run()으로 받은 것 (주소 고정, 비어 있으면 할당 없음)
+};
+
+// 의존 관계가 있는 작업 그래프
+// add()로 노드를 만들고 precede(a, b)로 "a가 끝나야 b 시작"을 걸어 run()하면,
+// 선행 노드가 모두 끝난 노드부터 스케줄러에서 병렬로 실행됩니다. 같은 그래프를 여러 번 run()할 수 있습니다.
+class TaskGraph
+{
+public:
+    explicit TaskGraph(const char *name = "graph") : m_name(name) {}
+
+    int add(const char *name, std::function<void()> fn);
+    void precede(int before, int after);
+
+    // 모든 노드가 끝날 때까지 기다림 (호출 스레드도 실행). 순환이 있으면 실행하지 않고 false
+    bool run();
+
+    int nodeCount() const { return int(m_nodes.size()); }
+    double nodeMs(int node) const { return m_nodes[node]->ms; } // 마지막 run()에서 걸린 시간
+    QString timingString() const;
+
+private:
+    struct Node {
+        const char *name;
+        std::function<void()> fn;
+        std::vector<int> successors;
+        int predecessors = 0;
+        std::atomic<int> remaining{ 0 };
+        double ms = 0.0;
+        TaskGraph *graph = nullptr;
+    };
+
+    static void invokeNode(const void *context, size_t, size_t);
+
+    const char *m_name;
+    std::vector<std::unique_ptr<Node>> m_nodes;
+    TaskGroup *m_group = nullptr; // run() 중에만
+};
+
+#endif // TASKSCHEDULER_H
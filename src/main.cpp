@@ -1,21 +1,58 @@
 #include "MainWindow.h"
+#include "SplattingWidget.h"
+#include "TaskScheduler.h"
 #include <QApplication>
+#include <QCommandLineParser>
 #include <QSurfaceFormat>
 
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
 
+    // 스왑 간격 (1 = vsync, 0 = 끔, -1 = 적응형 vsync)
+    // 위젯과 창 합성 컨텍스트가 만들어질 때 정해지므로 실행 옵션으로 받습니다.
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption swapIntervalOption("swap-interval", "Swap interval (1 = vsync, 0 = off, -1 = adaptive)",
+                                          "n", "1");
+    parser.addOption(swapIntervalOption);
+    // 작업 스케줄러 (로드/정렬/코드북 등 모든 병렬 작업이 공유)
+    QCommandLineOption threadsOption("threads", "Worker threads including the caller (0 = hardware threads)", "n", "0");
+    QCommandLineOption pinThreadsOption("pin-threads", "Pin worker threads to cores 1..n");
+    parser.addOption(threadsOption);
+    parser.addOption(pinThreadsOption);
+    // 프레임당 힙 할당 검사: n 프레임을 그린 뒤 종료 (0 = 통과, 3 = 할당한 프레임 있음)
+    QCommandLineOption allocCheckOption("alloc-check",
+                                        "Render n frames and exit non-zero if any steady-state frame allocates "
+                                        "(needs S2S_ALLOC_COUNTER)",
+                                        "n");
+    parser.addOption(allocCheckOption);
+    parser.addPositionalArgument("scene", "Splat file to open at startup", "[scene]");
+    parser.process(a);
+
+    TaskScheduler::Options schedulerOptions;
+    schedulerOptions.threadCount = parser.value(threadsOption).toInt();
+    schedulerOptions.pinThreads = parser.isSet(pinThreadsOption);
+    TaskScheduler::instance().configure(schedulerOptions);
+
     // OpenGL 포맷 설정 (버전 3.3 Core Profile 이상 권장)
     QSurfaceFormat format;
     format.setDepthBufferSize(24);
     format.setStencilBufferSize(8);
     format.setVersion(3, 3);
     format.setProfile(QSurfaceFormat::CoreProfile);
+    format.setSwapInterval(parser.value(swapIntervalOption).toInt());
     QSurfaceFormat::setDefaultFormat(format);
 
     MainWindow w;
     w.show();
 
+    const QStringList args = parser.positionalArguments();
+    if (!args.isEmpty() && !w.loadSceneFile(args[0])) return 1;
+    if (parser.isSet(allocCheckOption)
+        && !w.splatWidget()->startAllocationCheck(parser.value(allocCheckOption).toInt(), true)) {
+        return 1;
+    }
+
     return a.exec();
 }